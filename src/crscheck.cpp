@@ -30,7 +30,9 @@
 */
 
 #include <time.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <math.h>
 
 #include "crscheck.hpp"
@@ -42,6 +44,16 @@ static const F64 PI_OVER_4 = PI / 4;
 static const F64 deg2rad = PI / 180.0;
 static const F64 rad2deg = 180.0 / PI;
 
+// the IEEE 754 quiet NaN marks coordinates that have no geographic position
+
+static F64 make_quiet_nan()
+{
+  volatile F64 zero = 0.0;
+  return zero / zero;
+}
+
+static const F64 quiet_nan = make_quiet_nan();
+
 static const F64 feet2meter = 0.3048;
 static const F64 surveyfeet2meter = 0.3048006096012;
 
@@ -391,9 +403,8 @@ public:
 static const StatePlaneLCC state_plane_lcc_nad27_list[] =
 {
   // zone, false east [m], false north [m], ProjOrig(Lat), CentMerid(Long), 1st std para, 2nd std para 
+  StatePlaneLCC(PCS_NAD27_Tennessee, "TN",609601.2192,30480.06096,34.66666667,-86,35.25,36.41666667),
   StatePlaneLCC(PCS_NAD27_Alaska_zone_10, "AK_10",914401.8288,0,51,-176,51.83333333,53.83333333),
-  StatePlaneLCC(PCS_NAD27_Arkansas_North, "AR_N",609601.2192,0,34.33333333,-92,34.93333333,36.23333333),
-  StatePlaneLCC(PCS_NAD27_Arkansas_South, "AR_S",609601.2192,0,32.66666667,-92,33.3,34.76666667),
   StatePlaneLCC(PCS_NAD27_California_I, "CA_I",609601.2192,0,39.33333333,-122,40,41.66666667),
   StatePlaneLCC(PCS_NAD27_California_II, "CA_II",609601.2192,0,37.66666667,-122,38.33333333,39.83333333),
   StatePlaneLCC(PCS_NAD27_California_III, "CA_III",609601.2192,0,36.5,-120.5,37.06666667,38.43333333),
@@ -401,6 +412,8 @@ static const StatePlaneLCC state_plane_lcc_nad27_list[] =
   StatePlaneLCC(PCS_NAD27_California_V, "CA_V",609601.2192,0,33.5,-118,34.03333333,35.46666667),
   StatePlaneLCC(PCS_NAD27_California_VI, "CA_VI",609601.2192,0,32.16666667,-116.25,32.78333333,33.88333333),
   StatePlaneLCC(PCS_NAD27_California_VII, "CA_VII",1276106.451,1268253.007,34.13333333,-118.3333333,33.86666667,34.41666667),
+  StatePlaneLCC(PCS_NAD27_Arkansas_North, "AR_N",609601.2192,0,34.33333333,-92,34.93333333,36.23333333),
+  StatePlaneLCC(PCS_NAD27_Arkansas_South, "AR_S",609601.2192,0,32.66666667,-92,33.3,34.76666667),
   StatePlaneLCC(PCS_NAD27_Colorado_North, "CO_N",609601.2192,0,39.33333333,-105.5,39.71666667,40.78333333),
   StatePlaneLCC(PCS_NAD27_Colorado_Central, "CO_C",609601.2192,0,37.83333333,-105.5,38.45,39.75),
   StatePlaneLCC(PCS_NAD27_Colorado_South, "CO_S",609601.2192,0,36.66666667,-105.5,37.23333333,38.43333333),
@@ -440,13 +453,10 @@ static const StatePlaneLCC state_plane_lcc_nad27_list[] =
   StatePlaneLCC(PCS_NAD27_Oregon_South, "OR_S",609601.2192,0,41.66666667,-120.5,42.33333333,44),
   StatePlaneLCC(PCS_NAD27_Pennsylvania_N, "PA_N",609601.2192,0,40.16666667,-77.75,40.88333333,41.95),
   StatePlaneLCC(PCS_NAD27_Pennsylvania_S, "PA_S",609601.2192,0,39.33333333,-77.75,39.93333333,40.96666667),
-  StatePlaneLCC(PCS_NAD27_Puerto_Rico, "PR",152400.3048,0,17.83333333,-66.43333333,18.03333333,18.43333333),
-  StatePlaneLCC(PCS_NAD27_St_Croix, "St.Croix",152400.3048,30480.06096,17.83333333,-66.43333333,18.03333333,18.43333333),
   StatePlaneLCC(PCS_NAD27_South_Carolina_N, "SC_N",609601.2192,0,33,-81,33.76666667,34.96666667),
   StatePlaneLCC(PCS_NAD27_South_Carolina_S, "SC_S",609601.2192,0,31.83333333,-81,32.33333333,33.66666667),
   StatePlaneLCC(PCS_NAD27_South_Dakota_N, "SD_N",609601.2192,0,43.83333333,-100,44.41666667,45.68333333),
   StatePlaneLCC(PCS_NAD27_South_Dakota_S, "SD_S",609601.2192,0,42.33333333,-100.3333333,42.83333333,44.4),
-  StatePlaneLCC(PCS_NAD27_Tennessee, "TN",609601.2192,30480.06096,34.66666667,-86,35.25,36.41666667),
   StatePlaneLCC(PCS_NAD27_Texas_North, "TX_N",609601.2192,0,34,-101.5,34.65,36.18333333),
   StatePlaneLCC(PCS_NAD27_Texas_North_Central, "TX_NC",609601.2192,0,31.66666667,-97.5,32.13333333,33.96666667),
   StatePlaneLCC(PCS_NAD27_Texas_Central, "TX_C",609601.2192,0,29.66666667,-100.3333333,30.11666667,31.88333333),
@@ -464,21 +474,24 @@ static const StatePlaneLCC state_plane_lcc_nad27_list[] =
   StatePlaneLCC(PCS_NAD27_Wisconsin_North, "WI_N",609601.2192,0,45.16666667,-90,45.56666667,46.76666667),
   StatePlaneLCC(PCS_NAD27_Wisconsin_Central, "WI_C",609601.2192,0,43.83333333,-90,44.25,45.5),
   StatePlaneLCC(PCS_NAD27_Wisconsin_South, "WI_S",609601.2192,0,42,-90,42.73333333,44.06666667),
+  StatePlaneLCC(PCS_NAD27_Puerto_Rico, "PR",152400.3048,0,17.83333333,-66.43333333,18.03333333,18.43333333),
+  StatePlaneLCC(PCS_NAD27_St_Croix, "St.Croix",152400.3048,30480.06096,17.83333333,-66.43333333,18.03333333,18.43333333),
   StatePlaneLCC(0,0,-1,-1,-1,-1,-1,-1)
 };
 
 static const StatePlaneLCC state_plane_lcc_nad83_list[] =
 {
   // geotiff key, zone, false east [m], false north [m], ProjOrig(Lat), CentMerid(Long), 1st std para, 2nd std para 
+  StatePlaneLCC(PCS_NAD83_Kentucky_North, "KY_N",500000,0,37.500000,-84.250000,37.966667,38.966667),
   StatePlaneLCC(PCS_NAD83_Alaska_zone_10, "AK_10",1000000,0,51.000000,-176.000000,51.833333,53.833333),
-  StatePlaneLCC(PCS_NAD83_Arkansas_North, "AR_N",400000,0,34.333333,-92.000000,34.933333,36.233333),
-  StatePlaneLCC(PCS_NAD83_Arkansas_South, "AR_S",400000,400000,32.666667,-92.000000,33.300000,34.766667),
   StatePlaneLCC(PCS_NAD83_California_1, "CA_I",2000000,500000,39.333333,-122.000000,40.000000,41.666667),
   StatePlaneLCC(PCS_NAD83_California_2, "CA_II",2000000,500000,37.666667,-122.000000,38.333333,39.833333),
   StatePlaneLCC(PCS_NAD83_California_3, "CA_III",2000000,500000,36.500000,-120.500000,37.066667,38.433333),
   StatePlaneLCC(PCS_NAD83_California_4, "CA_IV",2000000,500000,35.333333,-119.000000,36.000000,37.250000),
   StatePlaneLCC(PCS_NAD83_California_5, "CA_V",2000000,500000,33.500000,-118.000000,34.033333,35.466667),
   StatePlaneLCC(PCS_NAD83_California_6, "CA_VI",2000000,500000,32.166667,-116.250000,32.783333,33.883333),
+  StatePlaneLCC(PCS_NAD83_Arkansas_North, "AR_N",400000,0,34.333333,-92.000000,34.933333,36.233333),
+  StatePlaneLCC(PCS_NAD83_Arkansas_South, "AR_S",400000,400000,32.666667,-92.000000,33.300000,34.766667),
   StatePlaneLCC(PCS_NAD83_Colorado_North, "CO_N",914401.8289,304800.6096,39.333333,-105.500000,39.716667,40.783333),
   StatePlaneLCC(PCS_NAD83_Colorado_Central, "CO_C",914401.8289,304800.6096,37.833333,-105.500000,38.450000,39.750000),
   StatePlaneLCC(PCS_NAD83_Colorado_South, "CO_S",914401.8289,304800.6096,36.666667,-105.500000,37.233333,38.433333),
@@ -488,7 +501,6 @@ static const StatePlaneLCC state_plane_lcc_nad83_list[] =
   StatePlaneLCC(PCS_NAD83_Iowa_South, "IA_S",500000,0,40.000000,-93.500000,40.616667,41.783333),
   StatePlaneLCC(PCS_NAD83_Kansas_North, "KS_N",400000,0,38.333333,-98.000000,38.716667,39.783333),
   StatePlaneLCC(PCS_NAD83_Kansas_South, "KS_S",400000,400000,36.666667,-98.500000,37.266667,38.566667),
-  StatePlaneLCC(PCS_NAD83_Kentucky_North, "KY_N",500000,0,37.500000,-84.250000,37.966667,38.966667),
   StatePlaneLCC(PCS_NAD83_Kentucky_South, "KY_S",500000,500000,36.333333,-85.750000,36.733333,37.933333),
   StatePlaneLCC(PCS_NAD83_Louisiana_North, "LA_N",1000000,0,30.500000,-92.500000,31.166667,32.666667),
   StatePlaneLCC(PCS_NAD83_Louisiana_South, "LA_S",1000000,0,28.500000,-91.333333,29.300000,30.700000),
@@ -515,7 +527,6 @@ static const StatePlaneLCC state_plane_lcc_nad83_list[] =
   StatePlaneLCC(PCS_NAD83_Oregon_South, "OR_S",1500000,0,41.666667,-120.500000,42.333333,44.000000),
   StatePlaneLCC(PCS_NAD83_Pennsylvania_N, "PA_N",600000,0,40.166667,-77.750000,40.883333,41.950000),
   StatePlaneLCC(PCS_NAD83_Pennsylvania_S, "PA_S",600000,0,39.333333,-77.750000,39.933333,40.966667),
-  StatePlaneLCC(PCS_NAD83_Puerto_Rico, "PR",200000,200000,17.833333,-66.433333,18.033333,18.433333),
   StatePlaneLCC(PCS_NAD83_South_Carolina, "SC",609600,0,31.833333,-81.000000,32.500000,34.833333),
   StatePlaneLCC(PCS_NAD83_South_Dakota_N, "SD_N",600000,0,43.833333,-100.000000,44.416667,45.683333),
   StatePlaneLCC(PCS_NAD83_South_Dakota_S, "SD_S",600000,0,42.333333,-100.333333,42.833333,44.400000),
@@ -537,6 +548,7 @@ static const StatePlaneLCC state_plane_lcc_nad83_list[] =
   StatePlaneLCC(PCS_NAD83_Wisconsin_North, "WI_N",600000,0,45.166667,-90.000000,45.566667,46.766667),
   StatePlaneLCC(PCS_NAD83_Wisconsin_Central, "WI_C",600000,0,43.833333,-90.000000,44.250000,45.500000),
   StatePlaneLCC(PCS_NAD83_Wisconsin_South, "WI_S",600000,0,42.000000,-90.000000,42.733333,44.066667),
+  StatePlaneLCC(PCS_NAD83_Puerto_Rico, "PR",200000,200000,17.833333,-66.433333,18.033333,18.433333),
   StatePlaneLCC(0,0,-1,-1,-1,-1,-1,-1)
 };
 
@@ -581,13 +593,13 @@ static const StatePlaneTM state_plane_tm_nad27_list[] =
   StatePlaneTM(PCS_NAD27_Delaware, "DE",152400.3048,0,38,-75.41666667,0.999995),
   StatePlaneTM(PCS_NAD27_Florida_East, "FL_E",152400.3048,0,24.33333333,-81,0.999941177),
   StatePlaneTM(PCS_NAD27_Florida_West, "FL_W",152400.3048,0,24.33333333,-82,0.999941177),
-  StatePlaneTM(PCS_NAD27_Georgia_East, "GA_E",152400.3048,0,30,-82.16666667,0.9999),
-  StatePlaneTM(PCS_NAD27_Georgia_West, "GA_W",152400.3048,0,30,-84.16666667,0.9999),
   StatePlaneTM(PCS_NAD27_Hawaii_zone_1, "HI_1",152400.3048,0,18.83333333,-155.5,0.999966667),
   StatePlaneTM(PCS_NAD27_Hawaii_zone_2, "HI_2",152400.3048,0,20.33333333,-156.6666667,0.999966667),
   StatePlaneTM(PCS_NAD27_Hawaii_zone_3, "HI_3",152400.3048,0,21.16666667,-158,0.99999),
   StatePlaneTM(PCS_NAD27_Hawaii_zone_4, "HI_4",152400.3048,0,21.83333333,-159.5,0.99999),
   StatePlaneTM(PCS_NAD27_Hawaii_zone_5, "HI_5",152400.3048,0,21.66666667,-160.1666667,1),
+  StatePlaneTM(PCS_NAD27_Georgia_East, "GA_E",152400.3048,0,30,-82.16666667,0.9999),
+  StatePlaneTM(PCS_NAD27_Georgia_West, "GA_W",152400.3048,0,30,-84.16666667,0.9999),
   StatePlaneTM(PCS_NAD27_Idaho_East, "ID_E",152400.3048,0,41.66666667,-112.1666667,0.999947368),
   StatePlaneTM(PCS_NAD27_Idaho_Central, "ID_C",152400.3048,0,41.66666667,-114,0.999947368),
   StatePlaneTM(PCS_NAD27_Idaho_West, "ID_W",152400.3048,0,41.66666667,-115.75,0.999933333),
@@ -641,13 +653,13 @@ static const StatePlaneTM state_plane_tm_nad83_list[] =
   StatePlaneTM(PCS_NAD83_Delaware, "DE",200000,0,38,-75.41666667,0.999995),
   StatePlaneTM(PCS_NAD83_Florida_East, "FL_E",200000,0,24.33333333,-81,0.999941177),
   StatePlaneTM(PCS_NAD83_Florida_West, "FL_W",200000,0,24.33333333,-82,0.999941177),
-  StatePlaneTM(PCS_NAD83_Georgia_East, "GA_E",200000,0,30,-82.16666667,0.9999),
-  StatePlaneTM(PCS_NAD83_Georgia_West, "GA_W",700000,0,30,-84.16666667,0.9999),
   StatePlaneTM(PCS_NAD83_Hawaii_zone_1, "HI_1",500000,0,18.83333333,-155.5,0.999966667),
   StatePlaneTM(PCS_NAD83_Hawaii_zone_2, "HI_2",500000,0,20.33333333,-156.6666667,0.999966667),
   StatePlaneTM(PCS_NAD83_Hawaii_zone_3, "HI_3",500000,0,21.16666667,-158,0.99999),
   StatePlaneTM(PCS_NAD83_Hawaii_zone_4, "HI_4",500000,0,21.83333333,-159.5,0.99999),
   StatePlaneTM(PCS_NAD83_Hawaii_zone_5, "HI_5",500000,0,21.66666667,-160.1666667,1),
+  StatePlaneTM(PCS_NAD83_Georgia_East, "GA_E",200000,0,30,-82.16666667,0.9999),
+  StatePlaneTM(PCS_NAD83_Georgia_West, "GA_W",700000,0,30,-84.16666667,0.9999),
   StatePlaneTM(PCS_NAD83_Idaho_East, "ID_E",200000,0,41.66666667,-112.1666667,0.999947368),
   StatePlaneTM(PCS_NAD83_Idaho_Central, "ID_C",500000,0,41.66666667,-114,0.999947368),
   StatePlaneTM(PCS_NAD83_Idaho_West, "ID_W",800000,0,41.66666667,-115.75,0.999933333),
@@ -682,2157 +694,1509 @@ static const StatePlaneTM state_plane_tm_nad83_list[] =
   StatePlaneTM(0,0,-1,-1,-1,-1,-1)
 };
 
-static I32 lidardouble2string(CHAR* string, F64 value)
-{
-  I32 len;
-  len = sprintf(string, "%.15f", value) - 1;
-  while (string[len] == '0') len--;
-  if (string[len] != '.') len++;
-  string[len] = '\0';
-  return len;
-};
+// the state plane lists are sorted by their geotiff key
 
-static I32 lidardouble2string(CHAR* string, F64 value, F64 scale)
+static const StatePlaneLCC* find_state_plane_lcc(const StatePlaneLCC* list, const I32 number, const U16 epsg)
 {
-  I32 decimal_digits = 0;
-  while (scale < 1.0)
-  {
-    scale *= 10;
-    decimal_digits++;
+  I32 low = 0;
+  I32 high = number - 1;
+  while (low <= high)
+  {
+    I32 mid = (low + high) / 2;
+    if ((U16)list[mid].geokey < epsg) low = mid + 1;
+    else if ((U16)list[mid].geokey > epsg) high = mid - 1;
+    else return &list[mid];
   }
-  if (decimal_digits == 0)
-    sprintf(string, "%d", (I32)value);
-  else if (decimal_digits == 1)
-    sprintf(string, "%.1f", value);
-  else if (decimal_digits == 2)
-    sprintf(string, "%.2f", value);
-  else if (decimal_digits == 3)
-    sprintf(string, "%.3f", value);
-  else if (decimal_digits == 4)
-    sprintf(string, "%.4f", value);
-  else if (decimal_digits == 5)
-    sprintf(string, "%.5f", value);
-  else if (decimal_digits == 6)
-    sprintf(string, "%.6f", value);
-  else if (decimal_digits == 7)
-    sprintf(string, "%.7f", value);
-  else if (decimal_digits == 8)
-    sprintf(string, "%.8f", value);
-  else
-    return lidardouble2string(string, value);
-  return strlen(string)-1;
-};
-
-void CRScheck::set_coordinates_in_survey_feet(const BOOL from_geokeys)
-{
-  if (from_geokeys)
-    coordinate_units[0] = 3;
-  else
-    coordinate_units[1] = 3;
+  return 0;
 }
 
-void CRScheck::set_coordinates_in_feet(const BOOL from_geokeys)
+static const StatePlaneTM* find_state_plane_tm(const StatePlaneTM* list, const I32 number, const U16 epsg)
 {
-  if (from_geokeys)
-    coordinate_units[0] = 2;
-  else
-    coordinate_units[1] = 2;
+  I32 low = 0;
+  I32 high = number - 1;
+  while (low <= high)
+  {
+    I32 mid = (low + high) / 2;
+    if ((U16)list[mid].geokey < epsg) low = mid + 1;
+    else if ((U16)list[mid].geokey > epsg) high = mid - 1;
+    else return &list[mid];
+  }
+  return 0;
 }
 
-void CRScheck::set_coordinates_in_meter(const BOOL from_geokeys)
-{
-  if (from_geokeys)
-    coordinate_units[0] = 1;
-  else
-    coordinate_units[1] = 1;
-}
+#define CRS_CACHE_SIZE 64
 
-void CRScheck::set_elevation_in_survey_feet(const BOOL from_geokeys)
-{
-  if (from_geokeys)
-    coordinate_units[0] = 3;
-  else
-    coordinate_units[1] = 3;
-}
+// the outcome of checking one distinct set of CRS VLRs. the tool checks
+// one file at a time so the cache is not protected against concurrent use
 
-void CRScheck::set_elevation_in_feet(const BOOL from_geokeys)
+class CRScacheEntry
 {
-  if (from_geokeys)
-    coordinate_units[0] = 2;
-  else
-    coordinate_units[1] = 2;
-}
+public:
+  U64 hash;
+  U32 size;
+  U8* key;
+  CHAR* description;
+  U32 fail_num;
+  CHAR** fails;
+  U32 warning_num;
+  CHAR** warnings;
+  CRSprojectionParameters* projection;
+  CRSprojectionEllipsoid* ellipsoid;
+  U32 coordinate_units;
+};
 
-void CRScheck::set_elevation_in_meter(const BOOL from_geokeys)
+class CRScache
 {
-  if (from_geokeys)
-    coordinate_units[0] = 1;
-  else
-    coordinate_units[1] = 1;
-}
+public:
+  BOOL replay(LASheader* lasheader, CHAR* description, const CRSprojectionParameters** projection, const CRSprojectionEllipsoid** ellipsoid, U32* coordinate_units);
+  void add(const LASheader* lasheader, const CHAR* description, const U32 fail_start, const U32 warning_start, const CRSprojectionParameters* projection, const CRSprojectionEllipsoid* ellipsoid, const U32 coordinate_units);
+  CRScache();
+  ~CRScache();
+private:
+  BOOL make_key(const LASheader* lasheader);
+  void append(const void* data, const U32 size);
+  void clear(CRScacheEntry* entry);
+  U32 size;
+  U32 alloc;
+  U8* key;
+  U64 hash;
+  U32 number;
+  U32 next;
+  CRScacheEntry entries[CRS_CACHE_SIZE];
+};
 
-BOOL CRScheck::set_ellipsoid(const I32 ellipsoid_id, const BOOL from_geokeys, char* description)
+void CRScache::append(const void* data, const U32 size)
 {
-  if ((ellipsoid_id <= 0) || (ellipsoid_id >= 25))
+  if ((this->size + size) > alloc)
   {
-    return FALSE;
+    alloc = 2*(this->size + size);
+    key = (U8*)realloc(key, alloc);
   }
+  memcpy(key + this->size, data, size);
+  this->size += size;
+}
 
-  CRSprojectionEllipsoid* ellipsoid;
+BOOL CRScache::make_key(const LASheader* lasheader)
+{
+  U32 i;
+  size = 0;
 
-  if (from_geokeys)
+  // the geokey directory plus the payloads of the double, ASCII, and WKT VLRs
+
+  if (lasheader->geokeys)
   {
-    if (ellipsoids[0] == 0)
-    {
-      ellipsoids[0] = new CRSprojectionEllipsoid();
-    }
-    ellipsoid = ellipsoids[0];
+    append(lasheader->geokeys, sizeof(LASvlr_geo_keys));
+    append(lasheader->geokey_entries, sizeof(LASgeokey_entry)*lasheader->geokeys->number_of_keys);
   }
-  else
+  for (i = 0; i < lasheader->number_of_variable_length_records; i++)
   {
-    if (ellipsoids[1] == 0)
+    const LASvlr* vlr = &lasheader->vlrs[i];
+    if ((strncmp(vlr->user_id, "LASF_Projection", 16) == 0) && ((vlr->record_id == 34736) || (vlr->record_id == 34737) || (vlr->record_id == 2112)) && vlr->data)
     {
-      ellipsoids[1] = new CRSprojectionEllipsoid();
+      append(&vlr->record_id, sizeof(U16));
+      append(&vlr->record_length_after_header, sizeof(U16));
+      append(vlr->data, vlr->record_length_after_header);
     }
-    ellipsoid = ellipsoids[1];
+  }
+  if (lasheader->ogc_wkt)
+  {
+    append(lasheader->ogc_wkt, (U32)strlen(lasheader->ogc_wkt) + 1);
   }
 
-  ellipsoid->id = ellipsoid_id;
-  ellipsoid->name = ellipsoid_list[ellipsoid_id].name;
-  ellipsoid->equatorial_radius = ellipsoid_list[ellipsoid_id].equatorialRadius;
-  ellipsoid->eccentricity_squared = ellipsoid_list[ellipsoid_id].eccentricitySquared;
-  ellipsoid->eccentricity_prime_squared = (ellipsoid->eccentricity_squared)/(1-ellipsoid->eccentricity_squared);
-  ellipsoid->polar_radius = ellipsoid->equatorial_radius*sqrt(1-ellipsoid->eccentricity_squared);    
-  ellipsoid->eccentricity = sqrt(ellipsoid->eccentricity_squared);
-  ellipsoid->eccentricity_e1 = (1-sqrt(1-ellipsoid->eccentricity_squared))/(1+sqrt(1-ellipsoid->eccentricity_squared));
-
-  if (description)
+  if (size == 0)
   {
-    sprintf(description, "%2d - %s (%g %g)", ellipsoid->id, ellipsoid->name, ellipsoid->equatorial_radius, ellipsoid->eccentricity_squared);
+    return FALSE;
   }
 
+  // 64 bit FNV-1a
+
+  hash = 0xCBF29CE484222325ULL;
+  for (i = 0; i < size; i++)
+  {
+    hash = (hash ^ key[i]) * 0x100000001B3ULL;
+  }
   return TRUE;
 }
 
-void CRScheck::set_projection(CRSprojectionParameters* projection, const BOOL from_geokeys)
+BOOL CRScache::replay(LASheader* lasheader, CHAR* description, const CRSprojectionParameters** projection, const CRSprojectionEllipsoid** ellipsoid, U32* coordinate_units)
 {
-  if (from_geokeys)
-  {
-    if (projections[0]) delete projections[0];
-    projections[0] = projection;
-  }
-  else
+  if (!make_key(lasheader))
   {
-    if (projections[1]) delete projections[1];
-    projections[1] = projection;
+    return FALSE;
   }
-}
 
-BOOL CRScheck::set_latlong_projection(const BOOL from_geokeys, CHAR* description)
-{
-  CRSprojectionParameters* latlong = new CRSprojectionParameters();
-  latlong->type = CRS_PROJECTION_LAT_LONG;
-  sprintf(latlong->name, "latitude/longitude");
-  set_projection(latlong, from_geokeys);
-  if (description)
+  U32 i, j;
+  for (i = 0; i < number; i++)
   {
-    sprintf(description, "%s", latlong->name);
+    const CRScacheEntry* entry = &entries[i];
+    if ((entry->hash == hash) && (entry->size == size) && (memcmp(entry->key, key, size) == 0))
+    {
+      if (description && entry->description)
+      {
+        strcpy(description, entry->description);
+      }
+      for (j = 0; j < entry->fail_num; j+=2)
+      {
+        lasheader->add_fail(entry->fails[j], entry->fails[j+1]);
+      }
+      for (j = 0; j < entry->warning_num; j+=2)
+      {
+        lasheader->add_warning(entry->warnings[j], entry->warnings[j+1]);
+      }
+      *projection = entry->projection;
+      *ellipsoid = entry->ellipsoid;
+      *coordinate_units = entry->coordinate_units;
+      return TRUE;
+    }
   }
-  return TRUE;
+  return FALSE;
 }
 
-BOOL CRScheck::set_longlat_projection(const BOOL from_geokeys, CHAR* description)
+static CHAR** copy_notes(CHAR** notes, const U32 start, const U32 end)
 {
-  CRSprojectionParameters* longlat = new CRSprojectionParameters();
-  longlat->type = CRS_PROJECTION_LONG_LAT;
-  sprintf(longlat->name, "longitude/latitude");
-  set_projection(longlat, from_geokeys);
-  if (description)
+  if (end <= start) return 0;
+  CHAR** copy = (CHAR**)malloc(sizeof(CHAR*)*(end - start));
+  for (U32 i = start; i < end; i++)
   {
-    sprintf(description, "%s", longlat->name);
+    copy[i - start] = strdup(notes[i]);
   }
-  return TRUE;
+  return copy;
 }
 
-BOOL CRScheck::set_utm_projection(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
+static CRSprojectionParameters* copy_projection(const CRSprojectionParameters* projection)
 {
-  I32 zone_number;
-  CHAR* zone_letter;
-  zone_number = strtoul(zone, &zone_letter, 10);
-  if ((*zone_letter < 'C') || (*zone_letter > 'X'))
-  {
-    return FALSE;
-  }
-  if ((zone_number < 0) || (zone_number > 60))
+  if (projection == 0)
   {
-    return FALSE;
+    return 0;
   }
-  CRSprojectionParametersUTM* utm = new CRSprojectionParametersUTM();
-  utm->type = CRS_PROJECTION_UTM;
-  utm->utm_zone_number = zone_number;
-  utm->utm_zone_letter = *zone_letter;
-  if((*zone_letter - 'N') >= 0)
+  else if (projection->type == CRS_PROJECTION_UTM)
   {
-    utm->utm_northern_hemisphere = TRUE; // point is in northern hemisphere
+    return new CRSprojectionParametersUTM(*((const CRSprojectionParametersUTM*)projection));
   }
-  else
+  else if (projection->type == CRS_PROJECTION_TM)
   {
-    utm->utm_northern_hemisphere = FALSE; //point is in southern hemisphere
+    return new CRSprojectionParametersTM(*((const CRSprojectionParametersTM*)projection));
   }
-  sprintf(utm->name, "UTM zone %s (%s)", zone, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
-  utm->utm_long_origin = (zone_number - 1) * 6 - 180 + 3; // + 3 puts origin in middle of zone
-  set_projection(utm, from_geokeys);
-  if (description)
+  else if (projection->type == CRS_PROJECTION_LCC)
   {
-    sprintf(description, "UTM %d %s", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
+    return new CRSprojectionParametersLCC(*((const CRSprojectionParametersLCC*)projection));
   }
-  return TRUE;
+  return new CRSprojectionParameters(*projection);
 }
 
-BOOL CRScheck::set_utm_projection(const I32 zone_number, const BOOL northern, const BOOL from_geokeys, CHAR* description)
+void CRScache::clear(CRScacheEntry* entry)
 {
-  if ((zone_number < 0) || (zone_number > 60))
+  U32 j;
+  if (entry->key) free(entry->key);
+  if (entry->description) free(entry->description);
+  for (j = 0; j < entry->fail_num; j++) free(entry->fails[j]);
+  if (entry->fails) free(entry->fails);
+  for (j = 0; j < entry->warning_num; j++) free(entry->warnings[j]);
+  if (entry->warnings) free(entry->warnings);
+  if (entry->projection) delete entry->projection;
+  if (entry->ellipsoid) delete entry->ellipsoid;
+  memset(entry, 0, sizeof(CRScacheEntry));
+}
+
+void CRScache::add(const LASheader* lasheader, const CHAR* description, const U32 fail_start, const U32 warning_start, const CRSprojectionParameters* projection, const CRSprojectionEllipsoid* ellipsoid, const U32 coordinate_units)
+{
+  if (size == 0)
   {
-    return FALSE;
+    return;
   }
-  CRSprojectionParametersUTM* utm = new CRSprojectionParametersUTM();
-  utm->type = CRS_PROJECTION_UTM;
-  utm->utm_zone_number = zone_number;
-  utm->utm_zone_letter = ' ';
-  utm->utm_northern_hemisphere = northern;
-  sprintf(utm->name, "UTM zone %d (%s)", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
-  utm->utm_long_origin = (zone_number - 1) * 6 - 180 + 3;  // + 3 puts origin in middle of zone
-  set_projection(utm, from_geokeys);
-  if (description)
+
+  // when full the oldest entries are replaced first
+
+  CRScacheEntry* entry;
+  if (number < CRS_CACHE_SIZE)
   {
-    sprintf(description, "UTM %d %s", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
+    entry = &entries[number++];
   }
-  return TRUE;
+  else
+  {
+    entry = &entries[next];
+    next = (next + 1) % CRS_CACHE_SIZE;
+    clear(entry);
+  }
+
+  entry->hash = hash;
+  entry->size = size;
+  entry->key = (U8*)malloc(size);
+  memcpy(entry->key, key, size);
+  entry->description = (description ? strdup(description) : 0);
+  entry->fail_num = (lasheader->fail_num > fail_start ? lasheader->fail_num - fail_start : 0);
+  entry->fails = copy_notes(lasheader->fails, fail_start, lasheader->fail_num);
+  entry->warning_num = (lasheader->warning_num > warning_start ? lasheader->warning_num - warning_start : 0);
+  entry->warnings = copy_notes(lasheader->warnings, warning_start, lasheader->warning_num);
+  entry->projection = copy_projection(projection);
+  entry->ellipsoid = (ellipsoid ? new CRSprojectionEllipsoid(*ellipsoid) : 0);
+  entry->coordinate_units = coordinate_units;
 }
 
-// Configure a Lambert Conic Conformal Projection
-//
-// The function Set_Lambert_Parameters receives the ellipsoid parameters and
-// Lambert Conformal Conic projection parameters as inputs, and sets the
-// corresponding state variables.
-//
-// falseEasting & falseNorthing are just an offset in meters added 
-// to the final coordinate calculated.
-//
-// latOriginDegree & longMeridianDegree are the "center" latitiude and
-// longitude in decimal degrees of the area being projected. All coordinates
-// will be calculated in meters relative to this point on the earth.
-//
-// firstStdParallelDegree & secondStdParallelDegree are the two lines of
-// longitude in decimal degrees (that is they run east-west) that define
-// where the "cone" intersects the earth. They bracket the area being projected.
-void CRScheck::set_lambert_conformal_conic_projection(const F64 falseEasting, const F64 falseNorthing, const F64 latOriginDegree, const F64 longMeridianDegree, const F64 firstStdParallelDegree, const F64 secondStdParallelDegree, const BOOL from_geokeys, CHAR* description)
+CRScache::CRScache()
 {
-  CRSprojectionParametersLCC* lcc = new CRSprojectionParametersLCC();
-  lcc->type = CRS_PROJECTION_LCC;
-  sprintf(lcc->name, "Lambert Conformal Conic");
-  lcc->lcc_false_easting_meter = falseEasting;
-  lcc->lcc_false_northing_meter = falseNorthing;
-  lcc->lcc_lat_origin_degree = latOriginDegree;
-  lcc->lcc_long_meridian_degree = longMeridianDegree;
-  lcc->lcc_first_std_parallel_degree = firstStdParallelDegree;
-  lcc->lcc_second_std_parallel_degree = secondStdParallelDegree;
-  lcc->lcc_lat_origin_radian = deg2rad*lcc->lcc_lat_origin_degree;
-  lcc->lcc_long_meridian_radian = deg2rad*lcc->lcc_long_meridian_degree;
-  lcc->lcc_first_std_parallel_radian = deg2rad*lcc->lcc_first_std_parallel_degree;
-  lcc->lcc_second_std_parallel_radian = deg2rad*lcc->lcc_second_std_parallel_degree;
-  set_projection(lcc, from_geokeys);
-  if (description)
-  {
-    sprintf(description, "false east/north: %g/%g [m], origin lat/ meridian long: %g/%g, parallel 1st/2nd: %g/%g", lcc->lcc_false_easting_meter, lcc->lcc_false_northing_meter, lcc->lcc_lat_origin_degree, lcc->lcc_long_meridian_degree, lcc->lcc_first_std_parallel_degree, lcc->lcc_second_std_parallel_degree);
-  }
+  size = 0;
+  alloc = 0;
+  key = 0;
+  hash = 0;
+  number = 0;
+  next = 0;
+  memset(entries, 0, sizeof(CRScacheEntry)*CRS_CACHE_SIZE);
 }
 
-/*
-  * The function set_transverse_mercator_projection receives the Tranverse
-  * Mercator projection parameters as input and sets the corresponding state
-  * variables. 
-  * falseEasting   : Easting/X in meters at the center of the projection
-  * falseNorthing  : Northing/Y in meters at the center of the projection
-  * latOriginDegree     : Latitude in decimal degree at the origin of the projection
-  * longMeridianDegree  : Longitude n decimal degree at the center of the projection
-  * scaleFactor         : Projection scale factor
-*/
-void CRScheck::set_transverse_mercator_projection(const F64 falseEasting, const F64 falseNorthing, const F64 latOriginDegree, const F64 longMeridianDegree, const F64 scaleFactor, const BOOL from_geokeys, CHAR* description)
+CRScache::~CRScache()
 {
-  CRSprojectionParametersTM* tm = new CRSprojectionParametersTM();
-  tm->type = CRS_PROJECTION_TM;
-  sprintf(tm->name, "Transverse Mercator");
-  tm->tm_false_easting_meter = falseEasting;
-  tm->tm_false_northing_meter = falseNorthing;
-  tm->tm_lat_origin_degree = latOriginDegree;
-  tm->tm_long_meridian_degree = longMeridianDegree;
-  tm->tm_scale_factor = scaleFactor;
-  tm->tm_lat_origin_radian = deg2rad*tm->tm_lat_origin_degree;
-  tm->tm_long_meridian_radian = deg2rad*tm->tm_long_meridian_degree;
-  set_projection(tm, from_geokeys);
-  if (description)
+  U32 i;
+  for (i = 0; i < number; i++)
   {
-    sprintf(description, "false east/north: %g/%g [m], origin lat/meridian long: %g/%g, scale: %g", tm->tm_false_easting_meter, tm->tm_false_northing_meter, tm->tm_lat_origin_degree, tm->tm_long_meridian_degree, tm->tm_scale_factor);
+    clear(&entries[i]);
   }
+  if (key) free(key);
 }
 
-BOOL CRScheck::set_state_plane_nad27_lcc(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
+static CRScache crscache;
+
+#define CRS_WKT_MAX_NODES 2048
+#define CRS_WKT_MAX_DEPTH 32
+
+#define CRS_WKT_KEYWORD    0
+#define CRS_WKT_STRING     1
+#define CRS_WKT_NUMBER     2
+#define CRS_WKT_IDENTIFIER 3
+
+#define CRS_WKT_PROJECTED  "PROJCS|PROJCRS|PROJECTEDCRS"
+#define CRS_WKT_GEOGRAPHIC "GEOGCS|GEOGCRS|GEOGRAPHICCRS|GEODCRS|GEODETICCRS|BASEGEOGCRS|BASEGEODCRS"
+#define CRS_WKT_VERTICAL   "VERT_CS|VERTCRS|VERTICALCRS"
+
+// one element of an OGC WKT string. a keyword has children that are linked
+// with next, all other elements are leaves. the text is not copied but
+// points into the WKT string (quoted strings without their quotes)
+
+class CRSwktNode
+{
+public:
+  const CHAR* text;
+  U32 length;
+  I32 type;
+  I32 child;
+  I32 next;
+};
+
+// parses WKT1 and WKT2 into a fixed array of nodes in one pass and without
+// allocating any memory. names are compared ignoring case and everything
+// that is not a letter or a digit so that "Transverse_Mercator" matches
+// "Transverse Mercator" and "VERT_CS" matches "VERTCS"
+
+class CRSwkt
+{
+public:
+  BOOL parse(const CHAR* wkt);
+  BOOL is(const I32 node, const CHAR* names) const;
+  I32 find(const I32 node, const CHAR* keywords) const;
+  I32 find_next(const I32 node, const CHAR* keywords) const;
+  I32 get_value(const I32 node, const U32 index) const;
+  F64 get_number(const I32 node, const U32 index, const F64 fallback) const;
+  U32 get_epsg_code(const I32 node) const;
+  const CHAR* get_text(const I32 node, I32* length) const { *length = (I32)nodes[node].length; return nodes[node].text; };
+  I32 root;
+  const CHAR* error;
+  U32 error_offset;
+private:
+  I32 number;
+  CRSwktNode nodes[CRS_WKT_MAX_NODES];
+};
+
+BOOL CRSwkt::parse(const CHAR* wkt)
 {
-  I32 i = 0;
-  while (state_plane_lcc_nad27_list[i].zone)
+  I32 stack_node[CRS_WKT_MAX_DEPTH];
+  I32 stack_last[CRS_WKT_MAX_DEPTH];
+  I32 depth = 0;
+  BOOL expect_element = TRUE;
+  const CHAR* c = wkt;
+
+  root = -1;
+  number = 0;
+  error = 0;
+
+  while (TRUE)
   {
-    if (strcmp(zone, state_plane_lcc_nad27_list[i].zone) == 0)
+    while ((*c == ' ') || (*c == '\t') || (*c == '\n') || (*c == '\r')) c++;
+    if (*c == '\0')
+    {
+      break;
+    }
+
+    if (expect_element)
     {
-      set_ellipsoid(CRS_ELLIPSOID_NAD27, from_geokeys);
-      set_lambert_conformal_conic_projection(state_plane_lcc_nad27_list[i].falseEasting, state_plane_lcc_nad27_list[i].falseNorthing, state_plane_lcc_nad27_list[i].latOriginDegree, state_plane_lcc_nad27_list[i].longMeridianDegree, state_plane_lcc_nad27_list[i].firstStdParallelDegree, state_plane_lcc_nad27_list[i].secondStdParallelDegree, from_geokeys);
-      if (description)
+      // a keyword without any elements
+
+      if (((*c == ']') || (*c == ')')) && depth && (stack_last[depth-1] == -1))
       {
-        sprintf(description, "stateplane27 %s", state_plane_lcc_nad27_list[i].zone);
+        depth--;
+        c++;
+        expect_element = FALSE;
+        continue;
       }
-      return TRUE;
+
+      if (number == CRS_WKT_MAX_NODES)
+      {
+        error = "too many elements";
+        break;
+      }
+
+      CRSwktNode* node = &nodes[number];
+      node->child = -1;
+      node->next = -1;
+
+      if (*c == '"')
+      {
+        // a doubled quote is an escaped quote
+
+        c++;
+        node->text = c;
+        while (*c)
+        {
+          if (*c == '"')
+          {
+            if (c[1] != '"') break;
+            c++;
+          }
+          c++;
+        }
+        if (*c != '"')
+        {
+          error = "unterminated quoted text";
+          break;
+        }
+        node->length = (U32)(c - node->text);
+        node->type = CRS_WKT_STRING;
+        c++;
+      }
+      else if (((*c >= '0') && (*c <= '9')) || (*c == '-') || (*c == '+') || (*c == '.'))
+      {
+        CHAR* end;
+        strtod(c, &end);
+        if (end == c)
+        {
+          error = "malformed number";
+          break;
+        }
+        node->text = c;
+        node->length = (U32)(end - c);
+        node->type = CRS_WKT_NUMBER;
+        c = end;
+      }
+      else if (((*c >= 'A') && (*c <= 'Z')) || ((*c >= 'a') && (*c <= 'z')) || (*c == '_'))
+      {
+        node->text = c;
+        while (((*c >= 'A') && (*c <= 'Z')) || ((*c >= 'a') && (*c <= 'z')) || ((*c >= '0') && (*c <= '9')) || (*c == '_')) c++;
+        node->length = (U32)(c - node->text);
+        while ((*c == ' ') || (*c == '\t') || (*c == '\n') || (*c == '\r')) c++;
+        if ((*c == '[') || (*c == '('))
+        {
+          node->type = CRS_WKT_KEYWORD;
+          c++;
+        }
+        else
+        {
+          node->type = CRS_WKT_IDENTIFIER;
+        }
+      }
+      else
+      {
+        error = "unexpected character";
+        break;
+      }
+
+      // link the element to its keyword
+
+      if (depth == 0)
+      {
+        if ((root != -1) || (node->type != CRS_WKT_KEYWORD))
+        {
+          error = "text after the end of the CRS";
+          break;
+        }
+        root = number;
+      }
+      else
+      {
+        if (stack_last[depth-1] == -1)
+        {
+          nodes[stack_node[depth-1]].child = number;
+        }
+        else
+        {
+          nodes[stack_last[depth-1]].next = number;
+        }
+        stack_last[depth-1] = number;
+      }
+
+      if (node->type == CRS_WKT_KEYWORD)
+      {
+        if (depth == CRS_WKT_MAX_DEPTH)
+        {
+          error = "elements nested too deeply";
+          break;
+        }
+        stack_node[depth] = number;
+        stack_last[depth] = -1;
+        depth++;
+      }
+      else
+      {
+        expect_element = FALSE;
+      }
+      number++;
+    }
+    else if ((*c == ',') && depth)
+    {
+      c++;
+      expect_element = TRUE;
+    }
+    else if (((*c == ']') || (*c == ')')) && depth)
+    {
+      depth--;
+      c++;
+    }
+    else
+    {
+      error = "expected a comma or a closing bracket";
+      break;
     }
-    i++;
   }
-  return FALSE;
+
+  if ((error == 0) && (depth || expect_element))
+  {
+    error = "unexpected end of text";
+  }
+  if ((error == 0) && (root == -1))
+  {
+    error = "no CRS";
+  }
+  error_offset = (U32)(c - wkt);
+  return (error == 0);
 }
 
-BOOL CRScheck::set_state_plane_nad83_lcc(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
+BOOL CRSwkt::is(const I32 node, const CHAR* names) const
 {
-  I32 i = 0;
-  while (state_plane_lcc_nad83_list[i].zone)
+  const CHAR* end = nodes[node].text + nodes[node].length;
+  const CHAR* name = names;
+
+  // try one alternative of the '|' separated names after the other
+
+  while (TRUE)
   {
-    if (strcmp(zone, state_plane_lcc_nad83_list[i].zone) == 0)
+    const CHAR* t = nodes[node].text;
+    const CHAR* n = name;
+    while (TRUE)
+    {
+      while ((t < end) && !isalnum((U8)*t)) t++;
+      while (*n && (*n != '|') && !isalnum((U8)*n)) n++;
+      if ((t == end) || (*n == '\0') || (*n == '|')) break;
+      if (tolower((U8)*t) != tolower((U8)*n)) break;
+      t++;
+      n++;
+    }
+    if ((t == end) && ((*n == '\0') || (*n == '|')))
     {
-      set_ellipsoid(CRS_ELLIPSOID_NAD83, from_geokeys);
-      set_lambert_conformal_conic_projection(state_plane_lcc_nad83_list[i].falseEasting, state_plane_lcc_nad83_list[i].falseNorthing, state_plane_lcc_nad83_list[i].latOriginDegree, state_plane_lcc_nad83_list[i].longMeridianDegree, state_plane_lcc_nad83_list[i].firstStdParallelDegree, state_plane_lcc_nad83_list[i].secondStdParallelDegree, from_geokeys);
-      if (description)
-      {
-        sprintf(description, "stateplane83 %s", state_plane_lcc_nad83_list[i].zone);
-      }
       return TRUE;
     }
-    i++;
+    while (*n && (*n != '|')) n++;
+    if (*n == '\0')
+    {
+      return FALSE;
+    }
+    name = n + 1;
   }
-  return FALSE;
 }
 
-BOOL CRScheck::set_state_plane_nad27_tm(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
+I32 CRSwkt::find(const I32 node, const CHAR* keywords) const
 {
-  I32 i = 0;
-  while (state_plane_tm_nad27_list[i].zone)
+  I32 n;
+  for (n = nodes[node].child; n != -1; n = nodes[n].next)
   {
-    if (strcmp(zone, state_plane_tm_nad27_list[i].zone) == 0)
+    if ((nodes[n].type == CRS_WKT_KEYWORD) && is(n, keywords))
     {
-      set_ellipsoid(CRS_ELLIPSOID_NAD27, from_geokeys);
-      set_transverse_mercator_projection(state_plane_tm_nad27_list[i].falseEasting, state_plane_tm_nad27_list[i].falseNorthing, state_plane_tm_nad27_list[i].latOriginDegree, state_plane_tm_nad27_list[i].longMeridianDegree, state_plane_tm_nad27_list[i].scaleFactor, from_geokeys);
-      if (description)
-      {
-        sprintf(description, "stateplane27 %s", state_plane_tm_nad27_list[i].zone);
-      }
-      return TRUE;
+      return n;
     }
-    i++;
   }
-  return FALSE;
+  return -1;
 }
 
-BOOL CRScheck::set_state_plane_nad83_tm(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
+I32 CRSwkt::find_next(const I32 node, const CHAR* keywords) const
 {
-  I32 i = 0;
-  while (state_plane_tm_nad83_list[i].zone)
+  I32 n;
+  for (n = nodes[node].next; n != -1; n = nodes[n].next)
   {
-    if (strcmp(zone, state_plane_tm_nad83_list[i].zone) == 0)
+    if ((nodes[n].type == CRS_WKT_KEYWORD) && is(n, keywords))
     {
-      set_ellipsoid(CRS_ELLIPSOID_NAD83, from_geokeys);
-      set_transverse_mercator_projection(state_plane_tm_nad83_list[i].falseEasting, state_plane_tm_nad83_list[i].falseNorthing, state_plane_tm_nad83_list[i].latOriginDegree, state_plane_tm_nad83_list[i].longMeridianDegree, state_plane_tm_nad83_list[i].scaleFactor, from_geokeys);
-      if (description)
-      {
-        sprintf(description, "stateplane83 %s", state_plane_tm_nad83_list[i].zone);
-      }
-      return TRUE;
+      return n;
     }
-    i++;
   }
-  return FALSE;
+  return -1;
 }
 
-BOOL CRScheck::set_vertical_from_VerticalCSTypeGeoKey(U16 value)
+I32 CRSwkt::get_value(const I32 node, const U32 index) const
 {
-  if ((5000 <= value) && (value <= 5099))      // [5000, 5099] = EPSG Ellipsoid Vertical CS Codes
+  I32 n;
+  U32 i = 0;
+  for (n = nodes[node].child; n != -1; n = nodes[n].next)
   {
-    vertical_epsg[1] = value;
+    if (nodes[n].type != CRS_WKT_KEYWORD)
+    {
+      if (i == index) return n;
+      i++;
+    }
   }
-  else if ((5101 <= value) && (value <= 5199)) // [5100, 5199] = EPSG Orthometric Vertical CS Codes
+  return -1;
+}
+
+F64 CRSwkt::get_number(const I32 node, const U32 index, const F64 fallback) const
+{
+  I32 n = get_value(node, index);
+  if ((n == -1) || (nodes[n].type != CRS_WKT_NUMBER))
   {
-    vertical_epsg[1] = value;
+    return fallback;
   }
-  else if ((5200 <= value) && (value <= 5999)) // [5200, 5999] = Reserved EPSG
+  return atof(nodes[n].text);
+}
+
+// WKT1 has AUTHORITY["EPSG","26915"] and WKT2 has ID["EPSG",26915]
+
+U32 CRSwkt::get_epsg_code(const I32 node) const
+{
+  I32 authority = find(node, "AUTHORITY|ID");
+  if (authority == -1)
   {
-    vertical_epsg[1] = value;
+    return 0;
   }
-  else
+  I32 name = get_value(authority, 0);
+  I32 code = get_value(authority, 1);
+  if ((name == -1) || (code == -1) || !is(name, "EPSG"))
   {
-//    fprintf(stderr, "set_VerticalCSTypeGeoKey: look-up for %d not implemented\012", value);
-    return FALSE;
+    return 0;
   }
-  return TRUE;
+  return (U32)strtoul(nodes[code].text, 0, 10);
 }
 
-BOOL CRScheck::set_coordinates_from_ProjLinearUnitsGeoKey(U16 value)
+// the projection parameters in the order used for comparing projections
+
+#define CRS_PARAMETER_FALSE_EASTING       0
+#define CRS_PARAMETER_FALSE_NORTHING      1
+#define CRS_PARAMETER_LAT_ORIGIN          2
+#define CRS_PARAMETER_LONG_MERIDIAN       3
+#define CRS_PARAMETER_SCALE_FACTOR        4
+#define CRS_PARAMETER_FIRST_STD_PARALLEL  5
+#define CRS_PARAMETER_SECOND_STD_PARALLEL 6
+#define CRS_PARAMETER_NUMBER              7
+
+// the WKT1 names followed by the WKT2 (EPSG) names of each parameter
+
+static const CHAR* const crs_wkt_parameter_names[CRS_PARAMETER_NUMBER] =
 {
-  switch (value)
+  "false_easting|Easting at false origin",
+  "false_northing|Northing at false origin",
+  "latitude_of_origin|latitude_of_center|Latitude of natural origin|Latitude of false origin",
+  "central_meridian|longitude_of_center|longitude_of_origin|Longitude of natural origin|Longitude of false origin",
+  "scale_factor|Scale factor at natural origin",
+  "standard_parallel_1|Latitude of 1st standard parallel",
+  "standard_parallel_2|Latitude of 2nd standard parallel"
+};
+
+static const CHAR* const crs_parameter_descriptions[CRS_PARAMETER_NUMBER] =
+{
+  "false easting [m]",
+  "false northing [m]",
+  "latitude of origin",
+  "central meridian",
+  "scale factor",
+  "first standard parallel",
+  "second standard parallel"
+};
+
+static const F64 crs_parameter_tolerances[CRS_PARAMETER_NUMBER] =
+{
+  0.01, 0.01, 0.00001, 0.00001, 0.000001, 0.00001, 0.00001
+};
+
+static U32 get_unit_code(const F64 meter_per_unit)
+{
+  if (fabs(meter_per_unit - 1.0) < 1e-9) return 1;
+  if (fabs(meter_per_unit - feet2meter) < 1e-9) return 2;
+  if (fabs(meter_per_unit - surveyfeet2meter) < 1e-9) return 3;
+  return 0;
+}
+
+// expresses UTM as a transverse mercator so that equal projections compare equal
+
+static I32 get_projection_parameters(const CRSprojectionParameters* projection, F64* parameters)
+{
+  I32 i;
+  for (i = 0; i < CRS_PARAMETER_NUMBER; i++)
   {
-  case 9001: // Linear_Meter
-    set_coordinates_in_meter(TRUE);
-    break;
-  case 9002: // Linear_Foot
-    set_coordinates_in_feet(TRUE);
-    break;
-  case 9003: // Linear_Foot_US_Survey
-    set_coordinates_in_survey_feet(TRUE);
-    break;
-  default:
-//    fprintf(stderr, "set_VerticalUnitsGeoKey: look-up for %d not implemented\n", value);
-    return FALSE;
+    parameters[i] = 0.0;
   }
-  return TRUE;
+  parameters[CRS_PARAMETER_SCALE_FACTOR] = 1.0;
+
+  if (projection->type == CRS_PROJECTION_UTM)
+  {
+    const CRSprojectionParametersUTM* utm = (const CRSprojectionParametersUTM*)projection;
+    parameters[CRS_PARAMETER_FALSE_EASTING] = 500000.0;
+    parameters[CRS_PARAMETER_FALSE_NORTHING] = (utm->utm_northern_hemisphere ? 0.0 : 10000000.0);
+    parameters[CRS_PARAMETER_LONG_MERIDIAN] = utm->utm_long_origin;
+    parameters[CRS_PARAMETER_SCALE_FACTOR] = 0.9996;
+    return CRS_PROJECTION_TM;
+  }
+  else if (projection->type == CRS_PROJECTION_TM)
+  {
+    const CRSprojectionParametersTM* tm = (const CRSprojectionParametersTM*)projection;
+    parameters[CRS_PARAMETER_FALSE_EASTING] = tm->tm_false_easting_meter;
+    parameters[CRS_PARAMETER_FALSE_NORTHING] = tm->tm_false_northing_meter;
+    parameters[CRS_PARAMETER_LAT_ORIGIN] = tm->tm_lat_origin_degree;
+    parameters[CRS_PARAMETER_LONG_MERIDIAN] = tm->tm_long_meridian_degree;
+    parameters[CRS_PARAMETER_SCALE_FACTOR] = tm->tm_scale_factor;
+    return CRS_PROJECTION_TM;
+  }
+  else if (projection->type == CRS_PROJECTION_LCC)
+  {
+    // the order of the two standard parallels does not matter
+
+    const CRSprojectionParametersLCC* lcc = (const CRSprojectionParametersLCC*)projection;
+    parameters[CRS_PARAMETER_FALSE_EASTING] = lcc->lcc_false_easting_meter;
+    parameters[CRS_PARAMETER_FALSE_NORTHING] = lcc->lcc_false_northing_meter;
+    parameters[CRS_PARAMETER_LAT_ORIGIN] = lcc->lcc_lat_origin_degree;
+    parameters[CRS_PARAMETER_LONG_MERIDIAN] = lcc->lcc_long_meridian_degree;
+    if (lcc->lcc_first_std_parallel_degree < lcc->lcc_second_std_parallel_degree)
+    {
+      parameters[CRS_PARAMETER_FIRST_STD_PARALLEL] = lcc->lcc_first_std_parallel_degree;
+      parameters[CRS_PARAMETER_SECOND_STD_PARALLEL] = lcc->lcc_second_std_parallel_degree;
+    }
+    else
+    {
+      parameters[CRS_PARAMETER_FIRST_STD_PARALLEL] = lcc->lcc_second_std_parallel_degree;
+      parameters[CRS_PARAMETER_SECOND_STD_PARALLEL] = lcc->lcc_first_std_parallel_degree;
+    }
+    return CRS_PROJECTION_LCC;
+  }
+  return CRS_PROJECTION_LONG_LAT;
 }
 
-BOOL CRScheck::set_elevation_from_VerticalUnitsGeoKey(U16 value)
+static I32 lidardouble2string(CHAR* string, F64 value)
 {
-  switch (value)
+  I32 len;
+  len = sprintf(string, "%.15f", value) - 1;
+  while (string[len] == '0') len--;
+  if (string[len] != '.') len++;
+  string[len] = '\0';
+  return len;
+};
+
+static I32 lidardouble2string(CHAR* string, F64 value, F64 scale)
+{
+  I32 decimal_digits = 0;
+  while (scale < 1.0)
   {
-  case 9001: // Linear_Meter
-    set_elevation_in_meter(TRUE);
-    break;
-  case 9002: // Linear_Foot
-    set_elevation_in_feet(TRUE);
-    break;
-  case 9003: // Linear_Foot_US_Survey
-    set_elevation_in_survey_feet(TRUE);
-    break;
-  default:
-//    fprintf(stderr, "set_VerticalUnitsGeoKey: look-up for %d not implemented\n", value);
-    return FALSE;
+    scale *= 10;
+    decimal_digits++;
   }
-  return TRUE;
+  if (decimal_digits == 0)
+    sprintf(string, "%d", (I32)value);
+  else if (decimal_digits == 1)
+    sprintf(string, "%.1f", value);
+  else if (decimal_digits == 2)
+    sprintf(string, "%.2f", value);
+  else if (decimal_digits == 3)
+    sprintf(string, "%.3f", value);
+  else if (decimal_digits == 4)
+    sprintf(string, "%.4f", value);
+  else if (decimal_digits == 5)
+    sprintf(string, "%.5f", value);
+  else if (decimal_digits == 6)
+    sprintf(string, "%.6f", value);
+  else if (decimal_digits == 7)
+    sprintf(string, "%.7f", value);
+  else if (decimal_digits == 8)
+    sprintf(string, "%.8f", value);
+  else
+    return lidardouble2string(string, value);
+  return strlen(string)-1;
+};
+
+void CRScheck::set_coordinates_in_survey_feet(const BOOL from_geokeys)
+{
+  if (from_geokeys)
+    coordinate_units[0] = 3;
+  else
+    coordinate_units[1] = 3;
 }
 
-static const short EPSG_ETRS89_Poland_CS92 = 2180;
-static const short EPSG_NZGD2000 = 2193;
-static const short EPSG_NAD83_HARN_UTM2_South_American_Samoa = 2195;
-static const short EPSG_NAD83_HARN_Virginia_North_ftUS = 2924;
-static const short EPSG_NAD83_HARN_Virginia_South_ftUS = 2925;
-static const short EPSG_ETRS89_ETRS_LCC = 3034;
-static const short EPSG_ETRS89_ETRS_TM34 = 3046;
-static const short EPSG_ETRS89_ETRS_TM35 = 3047;
-static const short EPSG_ETRS89_ETRS_TM36 = 3048;
-static const short EPSG_ETRS89_ETRS_TM35FIN = 3067;
-static const short EPSG_Fiji_1956_UTM60_South = 3141;
-static const short EPSG_Fiji_1956_UTM1_South = 3142;
-static const short EPSG_Fiji_Map_Grid_1986 = 3460;
-static const short EPSG_NAD83_NSRS2007_Maryland_ftUS = 3582;
-static const short EPSG_Slovene_National_Grid_1996 = 3794;
-static const short EPSG_MGI_1901_Slovene_National_Grid = 3912;
-static const short EPSG_RGF93_CC42 = 3942;
-static const short EPSG_RGF93_CC43 = 3943;
-static const short EPSG_RGF93_CC44 = 3944;
-static const short EPSG_RGF93_CC45 = 3945;
-static const short EPSG_RGF93_CC46 = 3946;
-static const short EPSG_RGF93_CC47 = 3947;
-static const short EPSG_RGF93_CC48 = 3948;
-static const short EPSG_RGF93_CC49 = 3949;
-static const short EPSG_RGF93_CC50 = 3950;
-static const short EPSG_ETRS89_DKTM1 = 4093;
-static const short EPSG_ETRS89_DKTM2 = 4094;
-static const short EPSG_ETRS89_DKTM3 = 4095;
-static const short EPSG_ETRS89_DKTM4 = 4096;
-static const short EPSG_ETRS89_UTM32_north_zE_N = 4647;
-static const short EPSG_ETRS89_NTM_zone_5 = 5105;
-static const short EPSG_ETRS89_NTM_zone_6 = 5106;
-static const short EPSG_ETRS89_NTM_zone_7 = 5107;
-static const short EPSG_ETRS89_NTM_zone_8 = 5108;
-static const short EPSG_ETRS89_NTM_zone_9 = 5109;
-static const short EPSG_ETRS89_NTM_zone_10 = 5110;
-static const short EPSG_ETRS89_NTM_zone_11 = 5111;
-static const short EPSG_ETRS89_NTM_zone_12 = 5112;
-static const short EPSG_ETRS89_NTM_zone_13 = 5113;
-static const short EPSG_ETRS89_NTM_zone_14 = 5114;
-static const short EPSG_ETRS89_NTM_zone_15 = 5115;
-static const short EPSG_ETRS89_NTM_zone_16 = 5116;
-static const short EPSG_ETRS89_NTM_zone_17 = 5117;
-static const short EPSG_ETRS89_NTM_zone_18 = 5118;
-static const short EPSG_ETRS89_NTM_zone_19 = 5119;
-static const short EPSG_ETRS89_NTM_zone_20 = 5120;
-static const short EPSG_ETRS89_NTM_zone_21 = 5121;
-static const short EPSG_ETRS89_NTM_zone_22 = 5122;
-static const short EPSG_ETRS89_NTM_zone_23 = 5123;
-static const short EPSG_ETRS89_NTM_zone_24 = 5124;
-static const short EPSG_ETRS89_NTM_zone_25 = 5125;
-static const short EPSG_ETRS89_NTM_zone_26 = 5126;
-static const short EPSG_ETRS89_NTM_zone_27 = 5127;
-static const short EPSG_ETRS89_NTM_zone_28 = 5128;
-static const short EPSG_ETRS89_NTM_zone_29 = 5129;
-static const short EPSG_ETRS89_NTM_zone_30 = 5130;
-static const short EPSG_ETRS89_UTM33_north_zE_N = 5650;
-static const short EPSG_OSGB_1936 = 27700;
-static const short EPSG_Belgian_Lambert_1972 = 31370;
+void CRScheck::set_coordinates_in_feet(const BOOL from_geokeys)
+{
+  if (from_geokeys)
+    coordinate_units[0] = 2;
+  else
+    coordinate_units[1] = 2;
+}
 
-BOOL CRScheck::set_projection_from_ProjectedCSTypeGeoKey(const U16 value, CHAR* description)
+void CRScheck::set_coordinates_in_meter(const BOOL from_geokeys)
 {
-  I32 ellipsoid_id = -1;
-  BOOL utm_northern = FALSE;
-  I32 utm_zone = -1;
-  CHAR* sp = 0;
-  BOOL sp_nad27 = FALSE;
+  if (from_geokeys)
+    coordinate_units[0] = 1;
+  else
+    coordinate_units[1] = 1;
+}
 
-  switch (value)
-  {
-  case 3154: // NAD83(CSRS) / UTM zone 7N
-  case 3155: // NAD83(CSRS) / UTM zone 8N
-  case 3156: // NAD83(CSRS) / UTM zone 9N
-  case 3157: // NAD83(CSRS) / UTM zone 10N
-    utm_northern = TRUE; utm_zone = value - 3154 + 7;
-    ellipsoid_id = CRS_ELLIPSOID_NAD83;
-    break;
-  case 3158: // NAD83(CSRS) / UTM zone 14N
-  case 3159: // NAD83(CSRS) / UTM zone 15N
-  case 3160: // NAD83(CSRS) / UTM zone 16N
-    utm_northern = TRUE; utm_zone = value - 3158 + 14;
-    ellipsoid_id = CRS_ELLIPSOID_NAD83;
-    break;
-  case 20137: // PCS_Adindan_UTM_zone_37N
-  case 20138: // PCS_Adindan_UTM_zone_38N
-    utm_northern = TRUE; utm_zone = value-20100;
-    break;
-  case 20437: // PCS_Ain_el_Abd_UTM_zone_37N
-  case 20438: // PCS_Ain_el_Abd_UTM_zone_38N
-  case 20439: // PCS_Ain_el_Abd_UTM_zone_39N
-    utm_northern = TRUE; utm_zone = value-20400;
-    break;                
-  case 20538: // PCS_Afgooye_UTM_zone_38N
-  case 20539: // PCS_Afgooye_UTM_zone_39N
-    utm_northern = TRUE; utm_zone = value-20500;
-    break;
-  case 20822: // PCS_Aratu_UTM_zone_22S
-  case 20823: // PCS_Aratu_UTM_zone_23S
-  case 20824: // PCS_Aratu_UTM_zone_24S
-    utm_northern = FALSE; utm_zone = value-20800;
-    break;
-  case 21148: // PCS_Batavia_UTM_zone_48S
-  case 21149: // PCS_Batavia_UTM_zone_49S
-  case 21150: // PCS_Batavia_UTM_zone_50S
-    utm_northern = FALSE; utm_zone = value-21100;
-    break;
-  case 21817: // PCS_Bogota_UTM_zone_17N
-  case 21818: // PCS_Bogota_UTM_zone_18N
-    utm_northern = TRUE; utm_zone = value-21800;
-    break;
-  case 22032: // PCS_Camacupa_UTM_32S
-  case 22033: // PCS_Camacupa_UTM_33S
-    utm_northern = FALSE; utm_zone = value-22000;
-    break; 
-  case 22332: // PCS_Carthage_UTM_zone_32N
-    utm_northern = TRUE; utm_zone = 32;
-    break; 
-  case 22523: // PCS_Corrego_Alegre_UTM_23S
-  case 22524: // PCS_Corrego_Alegre_UTM_24S
-    utm_northern = FALSE; utm_zone = value-22500;
-    break;
-  case 22832: // PCS_Douala_UTM_zone_32N
-    utm_northern = TRUE; utm_zone = 32;
-    break;
-  case 23028: // PCS_ED50_UTM_zone_28N
-  case 23029: // PCS_ED50_UTM_zone_29N
-  case 23030: 
-  case 23031: 
-  case 23032: 
-  case 23033: 
-  case 23034: 
-  case 23035: 
-  case 23036: 
-  case 23037: 
-  case 23038: // PCS_ED50_UTM_zone_38N
-    utm_northern = TRUE; utm_zone = value-23000;
-    ellipsoid_id = CRS_ELLIPSOID_Inter;
-    break;
-  case 23239: // PCS_Fahud_UTM_zone_39N
-  case 23240: // PCS_Fahud_UTM_zone_40N
-    utm_northern = TRUE; utm_zone = value-23200;
-    break;
-  case 23433: // PCS_Garoua_UTM_zone_33N
-    utm_northern = TRUE; utm_zone = 33;
-    break;
-  case 23846: // PCS_ID74_UTM_zone_46N
-  case 23847: // PCS_ID74_UTM_zone_47N
-  case 23848:
-  case 23849:
-  case 23850:
-  case 23851:
-  case 23852:
-  case 23853: // PCS_ID74_UTM_zone_53N
-    utm_northern = TRUE; utm_zone = value-23800;
-    ellipsoid_id = CRS_ELLIPSOID_ID74;
-    break;
-  case 23886: // PCS_ID74_UTM_zone_46S
-  case 23887: // PCS_ID74_UTM_zone_47S
-  case 23888:
-  case 23889:
-  case 23890:
-  case 23891:
-  case 23892:
-  case 23893:
-  case 23894: // PCS_ID74_UTM_zone_54S
-    utm_northern = FALSE; utm_zone = value-23840;
-    ellipsoid_id = CRS_ELLIPSOID_ID74;
-    break;
-  case 23947: // PCS_Indian_1954_UTM_47N
-  case 23948: // PCS_Indian_1954_UTM_48N
-    utm_northern = TRUE; utm_zone = value-23900;
-    break;
-  case 24047: // PCS_Indian_1975_UTM_47N
-  case 24048: // PCS_Indian_1975_UTM_48N
-    utm_northern = TRUE; utm_zone = value-24000;
-    break;
-  case 24547: // PCS_Kertau_UTM_zone_47N
-  case 24548: // PCS_Kertau_UTM_zone_48N
-    utm_northern = TRUE; utm_zone = value-24500;
-    break;
-  case 24720: // PCS_La_Canoa_UTM_zone_20N
-  case 24721: // PCS_La_Canoa_UTM_zone_21N
-    utm_northern = TRUE; utm_zone = value-24700;
-    break;
-  case 24818: // PCS_PSAD56_UTM_zone_18N
-  case 24819: // PCS_PSAD56_UTM_zone_19N
-  case 24820: // PCS_PSAD56_UTM_zone_20N
-  case 24821: // PCS_PSAD56_UTM_zone_21N
-    utm_northern = TRUE; utm_zone = value-24800;
-    break;
-  case 24877: // PCS_PSAD56_UTM_zone_17S
-  case 24878: // PCS_PSAD56_UTM_zone_18S
-  case 24879: // PCS_PSAD56_UTM_zone_19S
-  case 24880: // PCS_PSAD56_UTM_zone_20S
-    utm_northern = FALSE; utm_zone = value-24860;
-    break;
-  case 25231: // PCS_Lome_UTM_zone_31N
-    utm_northern = TRUE; utm_zone = 31;
-    break;
-  case 25828: // PCS_ETRS89_UTM_zone_28N
-  case 25829: // PCS_ETRS89_UTM_zone_29N
-  case 25830: // PCS_ETRS89_UTM_zone_30N
-  case 25831: // PCS_ETRS89_UTM_zone_31N
-  case 25832: // PCS_ETRS89_UTM_zone_32N
-  case 25833: // PCS_ETRS89_UTM_zone_33N
-  case 25834: // PCS_ETRS89_UTM_zone_34N
-  case 25835: // PCS_ETRS89_UTM_zone_35N
-  case 25836: // PCS_ETRS89_UTM_zone_36N
-  case 25837: // PCS_ETRS89_UTM_zone_37N
-  case 25838: // PCS_ETRS89_UTM_zone_38N
-    utm_northern = TRUE; utm_zone = value-25800;
-    ellipsoid_id = CRS_ELLIPSOID_NAD83;
-    break;
-  case 25932: // PCS_Malongo_1987_UTM_32S
-    utm_northern = FALSE; utm_zone = 32;
-    break;
-  case 26237: // PCS_Massawa_UTM_zone_37N
-    utm_northern = TRUE; utm_zone = 37;
-    break;
-  case 26331: // PCS_Minna_UTM_zone_31N
-  case 26332: // PCS_Minna_UTM_zone_32N
-    utm_northern = TRUE; utm_zone = value-26300;
-    break;
-  case 26432: // PCS_Mhast_UTM_zone_32S
-    utm_northern = FALSE; utm_zone = 32;
-    break;
-  case 26632: // PCS_M_poraloko_UTM_32N
-    utm_northern = TRUE; utm_zone = 32;
-    break;
-  case 26692: // PCS_Minna_UTM_zone_32S
-    utm_northern = FALSE; utm_zone = 32;
-    break;
-  case 26703: // PCS_NAD27_UTM_zone_3N
-  case 26704: // PCS_NAD27_UTM_zone_4N
-  case 26705: // PCS_NAD27_UTM_zone_5N
-  case 26706: // PCS_NAD27_UTM_zone_6N
-  case 26707: // PCS_NAD27_UTM_zone_7N
-  case 26708: // PCS_NAD27_UTM_zone_7N
-  case 26709: // PCS_NAD27_UTM_zone_9N
-  case 26710: // PCS_NAD27_UTM_zone_10N
-  case 26711: // PCS_NAD27_UTM_zone_11N
-  case 26712: // PCS_NAD27_UTM_zone_12N
-  case 26713: // PCS_NAD27_UTM_zone_13N
-  case 26714: // PCS_NAD27_UTM_zone_14N
-  case 26715: // PCS_NAD27_UTM_zone_15N
-  case 26716: // PCS_NAD27_UTM_zone_16N
-  case 26717: // PCS_NAD27_UTM_zone_17N
-  case 26718: // PCS_NAD27_UTM_zone_18N
-  case 26719: // PCS_NAD27_UTM_zone_19N
-  case 26720: // PCS_NAD27_UTM_zone_20N
-  case 26721: // PCS_NAD27_UTM_zone_21N
-  case 26722: // PCS_NAD27_UTM_zone_22N
-    utm_northern = TRUE; utm_zone = value-26700;
-    ellipsoid_id = CRS_ELLIPSOID_NAD27;
-    break;
-  case 26729: // PCS_NAD27_Alabama_East
-    sp_nad27 = TRUE; sp = "AL_E";
-    break;
-  case 26730: // PCS_NAD27_Alabama_West
-    sp_nad27 = TRUE; sp = "AL_W";
-    break;
-  case 26731: // PCS_NAD27_Alaska_zone_1
-    sp_nad27 = TRUE; sp = "AK_1";
-    break;
-  case 26732: // PCS_NAD27_Alaska_zone_2
-    sp_nad27 = TRUE; sp = "AK_2";
-    break;
-  case 26733: // PCS_NAD27_Alaska_zone_3
-    sp_nad27 = TRUE; sp = "AK_3";
-    break;
-  case 26734: // PCS_NAD27_Alaska_zone_4
-    sp_nad27 = TRUE; sp = "AK_4";
-    break;
-  case 26735: // PCS_NAD27_Alaska_zone_5
-    sp_nad27 = TRUE; sp = "AK_5";
-    break;
-  case 26736: // PCS_NAD27_Alaska_zone_6
-    sp_nad27 = TRUE; sp = "AK_6";
-    break;
-  case 26737: // PCS_NAD27_Alaska_zone_7
-    sp_nad27 = TRUE; sp = "AK_7";
-    break;
-  case 26738: // PCS_NAD27_Alaska_zone_8
-    sp_nad27 = TRUE; sp = "AK_8";
-    break;
-  case 26739: // PCS_NAD27_Alaska_zone_9
-    sp_nad27 = TRUE; sp = "AK_9";
-    break;
-  case 26740: // PCS_NAD27_Alaska_zone_10
-    sp_nad27 = TRUE; sp = "AK_10";
-    break;
-  case 26741: // PCS_NAD27_California_I
-    sp_nad27 = TRUE; sp = "CA_I";
-    break;
-  case 26742: // PCS_NAD27_California_II
-    sp_nad27 = TRUE; sp = "CA_II";
-    break;
-  case 26743: // PCS_NAD27_California_III
-    sp_nad27 = TRUE; sp = "CA_III";
-    break;
-  case 26744: // PCS_NAD27_California_IV
-    sp_nad27 = TRUE; sp = "CA_IV";
-    break;
-  case 26745: // PCS_NAD27_California_V
-    sp_nad27 = TRUE; sp = "CA_V";
-    break;
-  case 26746: // PCS_NAD27_California_VI
-    sp_nad27 = TRUE; sp = "CA_VI";
-    break;
-  case 26747: // PCS_NAD27_California_VII
-    sp_nad27 = TRUE; sp = "CA_VII";
-    break;
-  case 26748: // PCS_NAD27_Arizona_East
-    sp_nad27 = TRUE; sp = "AZ_E";
-    break;
-  case 26749: // PCS_NAD27_Arizona_Central
-    sp_nad27 = TRUE; sp = "AZ_C";
-    break;
-  case 26750: // PCS_NAD27_Arizona_West
-    sp_nad27 = TRUE; sp = "AZ_W";
-    break;
-  case 26751: // PCS_NAD27_Arkansas_North
-    sp_nad27 = TRUE; sp = "AR_N";
-    break;
-  case 26752: // PCS_NAD27_Arkansas_South
-    sp_nad27 = TRUE; sp = "AR_S";
-    break;
-  case 26753: // PCS_NAD27_Colorado_North
-    sp_nad27 = TRUE; sp = "CO_N";
-    break;
-  case 26754: // PCS_NAD27_Colorado_Central
-    sp_nad27 = TRUE; sp = "CO_C";
-    break;
-  case 26755: // PCS_NAD27_Colorado_South
-    sp_nad27 = TRUE; sp = "CO_S";
-    break;
-  case 26756: // PCS_NAD27_Connecticut
-    sp_nad27 = TRUE; sp = "CT";
-    break;
-  case 26757: // PCS_NAD27_Delaware
-    sp_nad27 = TRUE; sp = "DE";
-    break;
-  case 26758: // PCS_NAD27_Florida_East
-    sp_nad27 = TRUE; sp = "FL_E";
-    break;
-  case 26759: // PCS_NAD27_Florida_West
-    sp_nad27 = TRUE; sp = "FL_W";
-    break;
-  case 26760: // PCS_NAD27_Florida_North
-    sp_nad27 = TRUE; sp = "FL_N";
-    break;
-  case 26761: // PCS_NAD27_Hawaii_zone_1
-    sp_nad27 = TRUE; sp = "HI_1";
-    break;
-  case 26762: // PCS_NAD27_Hawaii_zone_2
-    sp_nad27 = TRUE; sp = "HI_2";
-    break;
-  case 26763: // PCS_NAD27_Hawaii_zone_3
-    sp_nad27 = TRUE; sp = "HI_3";
-    break;
-  case 26764: // PCS_NAD27_Hawaii_zone_4
-    sp_nad27 = TRUE; sp = "HI_4";
-    break;
-  case 26765: // PCS_NAD27_Hawaii_zone_5
-    sp_nad27 = TRUE; sp = "HI_5";
-    break;
-  case 26766: // PCS_NAD27_Georgia_East
-    sp_nad27 = TRUE; sp = "GA_E";
-    break;
-  case 26767: // PCS_NAD27_Georgia_West
-    sp_nad27 = TRUE; sp = "GA_W";
-    break;
-  case 26768: // PCS_NAD27_Idaho_East
-    sp_nad27 = TRUE; sp = "ID_E";
-    break;
-  case 26769: // PCS_NAD27_Idaho_Central
-    sp_nad27 = TRUE; sp = "ID_C";
-    break;
-  case 26770: // PCS_NAD27_Idaho_West
-    sp_nad27 = TRUE; sp = "ID_W";
-    break;
-  case 26771: // PCS_NAD27_Illinois_East
-    sp_nad27 = TRUE; sp = "IL_E";
-    break;
-  case 26772: // PCS_NAD27_Illinois_West
-    sp_nad27 = TRUE; sp = "IL_W";
-    break;
-  case 26773: // PCS_NAD27_Indiana_East
-    sp_nad27 = TRUE; sp = "IN_E";
-    break;
-  case 26774: // PCS_NAD27_Indiana_West
-    sp_nad27 = TRUE; sp = "IN_W";
-    break;
-  case 26775: // PCS_NAD27_Iowa_North
-    sp_nad27 = TRUE; sp = "IA_N";
-    break;
-  case 26776: // PCS_NAD27_Iowa_South
-    sp_nad27 = TRUE; sp = "IA_S";
-    break;
-  case 26777: // PCS_NAD27_Kansas_North
-    sp_nad27 = TRUE; sp = "KS_N";
-    break;
-  case 26778: // PCS_NAD27_Kansas_South
-    sp_nad27 = TRUE; sp = "KS_S";
-    break;
-  case 26779: // PCS_NAD27_Kentucky_North
-    sp_nad27 = TRUE; sp = "KY_N";
-    break;
-  case 26780: // PCS_NAD27_Kentucky_South
-    sp_nad27 = TRUE; sp = "KY_S";
-    break;
-  case 26781: // PCS_NAD27_Louisiana_North
-    sp_nad27 = TRUE; sp = "LA_N";
-    break;
-  case 26782: // PCS_NAD27_Louisiana_South
-    sp_nad27 = TRUE; sp = "LA_S";
-    break;
-  case 26783: // PCS_NAD27_Maine_East
-    sp_nad27 = TRUE; sp = "ME_E";
-    break;
-  case 26784: // PCS_NAD27_Maine_West
-    sp_nad27 = TRUE; sp = "ME_W";
-    break;
-  case 26785: // PCS_NAD27_Maryland
-    sp_nad27 = TRUE; sp = "MD";
-    break;
-  case 26786: // PCS_NAD27_Massachusetts
-    sp_nad27 = TRUE; sp = "M_M";
-    break;
-  case 26787: // PCS_NAD27_Massachusetts_Is
-    sp_nad27 = TRUE; sp = "M_I";
-    break;
-  case 26788: // PCS_NAD27_Michigan_North
-    sp_nad27 = TRUE; sp = "MI_N";
-    break;
-  case 26789: // PCS_NAD27_Michigan_Central
-    sp_nad27 = TRUE; sp = "MI_C";
-    break;
-  case 26790: // PCS_NAD27_Michigan_South
-    sp_nad27 = TRUE; sp = "MI_S";
-    break;
-  case 26791: // PCS_NAD27_Minnesota_North
-    sp_nad27 = TRUE; sp = "MN_N";
-    break;
-  case 26792: // PCS_NAD27_Minnesota_Cent
-    sp_nad27 = TRUE; sp = "MN_C";
-    break;
-  case 26793: // PCS_NAD27_Minnesota_South
-    sp_nad27 = TRUE; sp = "MN_S";
-    break;
-  case 26794: // PCS_NAD27_Mississippi_East
-    sp_nad27 = TRUE; sp = "MS_E";
-    break;
-  case 26795: // PCS_NAD27_Mississippi_West
-    sp_nad27 = TRUE; sp = "MS_W";
-    break;
-  case 26796: // PCS_NAD27_Missouri_East
-    sp_nad27 = TRUE; sp = "MO_E";
-    break;
-  case 26797: // PCS_NAD27_Missouri_Central
-    sp_nad27 = TRUE; sp = "MO_C";
-    break;
-  case 26798: // PCS_NAD27_Missouri_West
-    sp_nad27 = TRUE; sp = "MO_W";
-    break;
-  case 26903: // PCS_NAD83_UTM_zone_3N
-  case 26904: // PCS_NAD83_UTM_zone_4N
-  case 26905: // PCS_NAD83_UTM_zone_5N
-  case 26906: // PCS_NAD83_UTM_zone_6N
-  case 26907: // PCS_NAD83_UTM_zone_7N
-  case 26908: // PCS_NAD83_UTM_zone_7N
-  case 26909: // PCS_NAD83_UTM_zone_9N
-  case 26910: // PCS_NAD83_UTM_zone_10N
-  case 26911: // PCS_NAD83_UTM_zone_11N
-  case 26912: // PCS_NAD83_UTM_zone_12N
-  case 26913: // PCS_NAD83_UTM_zone_13N
-  case 26914: // PCS_NAD83_UTM_zone_14N
-  case 26915: // PCS_NAD83_UTM_zone_15N
-  case 26916: // PCS_NAD83_UTM_zone_16N
-  case 26917: // PCS_NAD83_UTM_zone_17N
-  case 26918: // PCS_NAD83_UTM_zone_18N
-  case 26919: // PCS_NAD83_UTM_zone_19N
-  case 26920: // PCS_NAD83_UTM_zone_20N
-  case 26921: // PCS_NAD83_UTM_zone_21N
-  case 26922: // PCS_NAD83_UTM_zone_22N
-  case 26923: // PCS_NAD83_UTM_zone_23N
-    utm_northern = TRUE; utm_zone = value-26900;
-    ellipsoid_id = CRS_ELLIPSOID_NAD83;
-    break;
-  case 26929: // PCS_NAD83_Alabama_East
-    sp_nad27 = FALSE; sp = "AL_E";
-    break;
-  case 26930: // PCS_NAD83_Alabama_West
-    sp_nad27 = FALSE; sp = "AL_W";
-    break;
-  case 26931: // PCS_NAD83_Alaska_zone_1
-    sp_nad27 = FALSE; sp = "AK_1";
-    break;
-  case 26932: // PCS_NAD83_Alaska_zone_2
-    sp_nad27 = FALSE; sp = "AK_2";
-    break;
-  case 26933: // PCS_NAD83_Alaska_zone_3
-    sp_nad27 = FALSE; sp = "AK_3";
-    break;
-  case 26934: // PCS_NAD83_Alaska_zone_4
-    sp_nad27 = FALSE; sp = "AK_4";
-    break;
-  case 26935: // PCS_NAD83_Alaska_zone_5
-    sp_nad27 = FALSE; sp = "AK_5";
-    break;
-  case 26936: // PCS_NAD83_Alaska_zone_6
-    sp_nad27 = FALSE; sp = "AK_6";
-    break;
-  case 26937: // PCS_NAD83_Alaska_zone_7
-    sp_nad27 = FALSE; sp = "AK_7";
-    break;
-  case 26938: // PCS_NAD83_Alaska_zone_8
-    sp_nad27 = FALSE; sp = "AK_8";
-    break;
-  case 26939: // PCS_NAD83_Alaska_zone_9
-    sp_nad27 = FALSE; sp = "AK_9";
-    break;
-  case 26940: // PCS_NAD83_Alaska_zone_10
-    sp_nad27 = FALSE; sp = "AK_10";
-    break;
-  case 26941: // PCS_NAD83_California_I
-    sp_nad27 = FALSE; sp = "CA_I";
-    break;
-  case 26942: // PCS_NAD83_California_II
-    sp_nad27 = FALSE; sp = "CA_II";
-    break;
-  case 26943: // PCS_NAD83_California_III
-    sp_nad27 = FALSE; sp = "CA_III";
-    break;
-  case 26944: // PCS_NAD83_California_IV
-    sp_nad27 = FALSE; sp = "CA_IV";
-    break;
-  case 26945: // PCS_NAD83_California_V
-    sp_nad27 = FALSE; sp = "CA_V";
-    break;
-  case 26946: // PCS_NAD83_California_VI
-    sp_nad27 = FALSE; sp = "CA_VI";
-    break;
-  case 26947: // PCS_NAD83_California_VII
-    sp_nad27 = FALSE; sp = "CA_VII";
-    break;
-  case 26948: // PCS_NAD83_Arizona_East
-    sp_nad27 = FALSE; sp = "AZ_E";
-    break;
-  case 26949: // PCS_NAD83_Arizona_Central
-    sp_nad27 = FALSE; sp = "AZ_C";
-    break;
-  case 26950: // PCS_NAD83_Arizona_West
-    sp_nad27 = FALSE; sp = "AZ_W";
-    break;
-  case 26951: // PCS_NAD83_Arkansas_North
-    sp_nad27 = FALSE; sp = "AR_N";
-    break;
-  case 26952: // PCS_NAD83_Arkansas_South
-    sp_nad27 = FALSE; sp = "AR_S";
-    break;
-  case 26953: // PCS_NAD83_Colorado_North
-    sp_nad27 = FALSE; sp = "CO_N";
-    break;
-  case 26954: // PCS_NAD83_Colorado_Central
-    sp_nad27 = FALSE; sp = "CO_C";
-    break;
-  case 26955: // PCS_NAD83_Colorado_South
-    sp_nad27 = FALSE; sp = "CO_S";
-    break;
-  case 26956: // PCS_NAD83_Connecticut
-    sp_nad27 = FALSE; sp = "CT";
-    break;
-  case 26957: // PCS_NAD83_Delaware
-    sp_nad27 = FALSE; sp = "DE";
-    break;
-  case 26958: // PCS_NAD83_Florida_East
-    sp_nad27 = FALSE; sp = "FL_E";
-    break;
-  case 26959: // PCS_NAD83_Florida_West
-    sp_nad27 = FALSE; sp = "FL_W";
-    break;
-  case 26960: // PCS_NAD83_Florida_North
-    sp_nad27 = FALSE; sp = "FL_N";
-    break;
-  case 26961: // PCS_NAD83_Hawaii_zone_1
-    sp_nad27 = FALSE; sp = "HI_1";
-    break;
-  case 26962: // PCS_NAD83_Hawaii_zone_2
-    sp_nad27 = FALSE; sp = "HI_2";
-    break;
-  case 26963: // PCS_NAD83_Hawaii_zone_3
-    sp_nad27 = FALSE; sp = "HI_3";
-    break;
-  case 26964: // PCS_NAD83_Hawaii_zone_4
-    sp_nad27 = FALSE; sp = "HI_4";
-    break;
-  case 26965: // PCS_NAD83_Hawaii_zone_5
-    sp_nad27 = FALSE; sp = "HI_5";
-    break;
-  case 26966: // PCS_NAD83_Georgia_East
-    sp_nad27 = FALSE; sp = "GA_E";
-    break;
-  case 26967: // PCS_NAD83_Georgia_West
-    sp_nad27 = FALSE; sp = "GA_W";
-    break;
-  case 26968: // PCS_NAD83_Idaho_East
-    sp_nad27 = FALSE; sp = "ID_E";
-    break;
-  case 26969: // PCS_NAD83_Idaho_Central
-    sp_nad27 = FALSE; sp = "ID_C";
-    break;
-  case 26970: // PCS_NAD83_Idaho_West
-    sp_nad27 = FALSE; sp = "ID_W";
-    break;
-  case 26971: // PCS_NAD83_Illinois_East
-    sp_nad27 = FALSE; sp = "IL_E";
-    break;
-  case 26972: // PCS_NAD83_Illinois_West
-    sp_nad27 = FALSE; sp = "IL_W";
-    break;
-  case 26973: // PCS_NAD83_Indiana_East
-    sp_nad27 = FALSE; sp = "IN_E";
-    break;
-  case 26974: // PCS_NAD83_Indiana_West
-    sp_nad27 = FALSE; sp = "IN_W";
-    break;
-  case 26975: // PCS_NAD83_Iowa_North
-    sp_nad27 = FALSE; sp = "IA_N";
-    break;
-  case 26976: // PCS_NAD83_Iowa_South
-    sp_nad27 = FALSE; sp = "IA_S";
-    break;
-  case 26977: // PCS_NAD83_Kansas_North
-    sp_nad27 = FALSE; sp = "KS_N";
-    break;
-  case 26978: // PCS_NAD83_Kansas_South
-    sp_nad27 = FALSE; sp = "KS_S";
-    break;
-  case 26979: // PCS_NAD83_Kentucky_North
-    sp_nad27 = FALSE; sp = "KY_N";
-    break;
-  case 26980: // PCS_NAD83_Kentucky_South
-    sp_nad27 = FALSE; sp = "KY_S";
-    break;
-  case 26981: // PCS_NAD83_Louisiana_North
-    sp_nad27 = FALSE; sp = "LA_N";
-    break;
-  case 26982: // PCS_NAD83_Louisiana_South
-    sp_nad27 = FALSE; sp = "LA_S";
-    break;
-  case 26983: // PCS_NAD83_Maine_East
-    sp_nad27 = FALSE; sp = "ME_E";
-    break;
-  case 26984: // PCS_NAD83_Maine_West
-    sp_nad27 = FALSE; sp = "ME_W";
-    break;
-  case 26985: // PCS_NAD83_Maryland
-    sp_nad27 = FALSE; sp = "MD";
-    break;
-  case 26986: // PCS_NAD83_Massachusetts
-    sp_nad27 = FALSE; sp = "M_M";
-    break;
-  case 26987: // PCS_NAD83_Massachusetts_Is
-    sp_nad27 = FALSE; sp = "M_I";
-    break;
-  case 26988: // PCS_NAD83_Michigan_North
-    sp_nad27 = FALSE; sp = "MI_N";
-    break;
-  case 26989: // PCS_NAD83_Michigan_Central
-    sp_nad27 = FALSE; sp = "MI_C";
-    break;
-  case 26990: // PCS_NAD83_Michigan_South
-    sp_nad27 = FALSE; sp = "MI_S";
-    break;
-  case 26991: // PCS_NAD83_Minnesota_North
-    sp_nad27 = FALSE; sp = "MN_N";
-    break;
-  case 26992: // PCS_NAD83_Minnesota_Cent
-    sp_nad27 = FALSE; sp = "MN_C";
-    break;
-  case 26993: // PCS_NAD83_Minnesota_South
-    sp_nad27 = FALSE; sp = "MN_S";
-    break;
-  case 26994: // PCS_NAD83_Mississippi_East
-    sp_nad27 = FALSE; sp = "MS_E";
-    break;
-  case 26995: // PCS_NAD83_Mississippi_West
-    sp_nad27 = FALSE; sp = "MS_W";
-    break;
-  case 26996: // PCS_NAD83_Missouri_East
-    sp_nad27 = FALSE; sp = "MO_E";
-    break;
-  case 26997: // PCS_NAD83_Missouri_Central
-    sp_nad27 = FALSE; sp = "MO_C";
-    break;
-  case 26998: // PCS_NAD83_Missouri_West
-    sp_nad27 = FALSE; sp = "MO_W";
-    break;
-  case 27700:
+void CRScheck::set_elevation_in_survey_feet(const BOOL from_geokeys)
+{
+  if (from_geokeys)
+    elevation_units[0] = 3;
+  else
+    elevation_units[1] = 3;
+}
 
-    break;
-  case 28348: // PCS_GDA94_MGA_zone_48
-  case 28349:
-  case 28350:
-  case 28351:
-  case 28352:
-  case 28353:
-  case 28354: // PCS_GDA94_MGA_zone_54
-  case 28355: // PCS_GDA94_MGA_zone_55
-  case 28356: // PCS_GDA94_MGA_zone_56
-  case 28357: // PCS_GDA94_MGA_zone_57
-  case 28358: // PCS_GDA94_MGA_zone_58
-    utm_northern = FALSE; utm_zone = value-28300;
-    ellipsoid_id = CRS_ELLIPSOID_GDA94;
-    break;
-  case 29118: // PCS_SAD69_UTM_zone_18N
-  case 29119: // PCS_SAD69_UTM_zone_19N
-  case 29120: // PCS_SAD69_UTM_zone_20N
-  case 29121: // PCS_SAD69_UTM_zone_21N
-  case 29122: // PCS_SAD69_UTM_zone_22N
-    utm_northern = TRUE; utm_zone = value-29100;
-    ellipsoid_id = CRS_ELLIPSOID_SAD69;
-    break;
-  case 29177: // PCS_SAD69_UTM_zone_17S
-  case 29178: // PCS_SAD69_UTM_zone_18S
-  case 29179: // PCS_SAD69_UTM_zone_19S
-  case 29180: // PCS_SAD69_UTM_zone_20S
-  case 29181: // PCS_SAD69_UTM_zone_21S
-  case 29182: // PCS_SAD69_UTM_zone_22S
-  case 29183: // PCS_SAD69_UTM_zone_23S
-  case 29184: // PCS_SAD69_UTM_zone_24S
-  case 29185: // PCS_SAD69_UTM_zone_25S
-    utm_northern = FALSE; utm_zone = value-29160;
-    ellipsoid_id = CRS_ELLIPSOID_SAD69;
-    break;
-  case 29220: // PCS_Sapper_Hill_UTM_20S
-  case 29221: // PCS_Sapper_Hill_UTM_21S
-    utm_northern = FALSE; utm_zone = value-29200;
-    break;
-  case 29333: // PCS_Schwarzeck_UTM_33S
-    utm_northern = FALSE; utm_zone = 33;
-    break;
-  case 29635: // PCS_Sudan_UTM_zone_35N
-  case 29636: // PCS_Sudan_UTM_zone_35N
-    utm_northern = TRUE; utm_zone = value-29600;
-    break;
-  case 29738: // PCS_Tananarive_UTM_38S
-  case 29739: // PCS_Tananarive_UTM_39S
-    utm_northern = FALSE; utm_zone = value-29700;
-    break;
-  case 29849: // PCS_Timbalai_1948_UTM_49N
-  case 29850: // PCS_Timbalai_1948_UTM_50N
-    utm_northern = TRUE; utm_zone = value-29800;
-    break;
-  case 30339: // PCS_TC_1948_UTM_zone_39N
-  case 30340: // PCS_TC_1948_UTM_zone_40N
-    utm_northern = TRUE; utm_zone = value-30300;
-    break;
-  case 30729: // PCS_Nord_Sahara_UTM_29N
-  case 30730: // PCS_Nord_Sahara_UTM_30N
-  case 30731: // PCS_Nord_Sahara_UTM_31N
-  case 30732: // PCS_Nord_Sahara_UTM_32N
-    utm_northern = TRUE; utm_zone = value-30700;
-    break;
-  case 31028: // PCS_Yoff_UTM_zone_28N
-    utm_northern = TRUE; utm_zone = 28;
-    break;
-  case 31121: // PCS_Zanderij_UTM_zone_21N
-    utm_northern = TRUE; utm_zone = 21;
-    break;
-  case 32001: // PCS_NAD27_Montana_North
-    sp_nad27 = TRUE; sp = "MT_N";
-    break;
-  case 32002: // PCS_NAD27_Montana_Central
-    sp_nad27 = TRUE; sp = "MT_C";
-    break;
-  case 32003: // PCS_NAD27_Montana_South
-    sp_nad27 = TRUE; sp = "MT_S";
-    break;
-  case 32005: // PCS_NAD27_Nebraska_North
-    sp_nad27 = TRUE; sp = "NE_N";
-    break;
-  case 32006: // PCS_NAD27_Nebraska_South
-    sp_nad27 = TRUE; sp = "NE_S";
-    break;
-  case 32007: // PCS_NAD27_Nevada_East
-    sp_nad27 = TRUE; sp = "NV_E";
-    break;
-  case 32008: // PCS_NAD27_Nevada_Central
-    sp_nad27 = TRUE; sp = "NV_C";
-    break;
-  case 32009: // PCS_NAD27_Nevada_West
-    sp_nad27 = TRUE; sp = "NV_W";
-    break;
-  case 32010: // PCS_NAD27_New_Hampshire
-    sp_nad27 = TRUE; sp = "NH";
-    break;
-  case 32011: // PCS_NAD27_New_Jersey
-    sp_nad27 = TRUE; sp = "NJ";
-    break;
-  case 32012: // PCS_NAD27_New_Mexico_East
-    sp_nad27 = TRUE; sp = "NM_E";
-    break;
-  case 32013: // PCS_NAD27_New_Mexico_Cent
-    sp_nad27 = TRUE; sp = "NM_C";
-    break;
-  case 32014: // PCS_NAD27_New_Mexico_West
-    sp_nad27 = TRUE; sp = "NM_W";
-    break;
-  case 32015: // PCS_NAD27_New_York_East
-    sp_nad27 = TRUE; sp = "NY_E";
-    break;
-  case 32016: // PCS_NAD27_New_York_Central
-    sp_nad27 = TRUE; sp = "NY_C";
-    break;
-  case 32017: // PCS_NAD27_New_York_West
-    sp_nad27 = TRUE; sp = "NY_W";
-    break;
-  case 32018: // PCS_NAD27_New_York_Long_Is
-    sp_nad27 = TRUE; sp = "NT_LI";
-    break;
-  case 32019: // PCS_NAD27_North_Carolina
-    sp_nad27 = TRUE; sp = "NC";
-    break;
-  case 32020: // PCS_NAD27_North_Dakota_N
-    sp_nad27 = TRUE; sp = "ND_N";
-    break;
-  case 32021: // PCS_NAD27_North_Dakota_S
-    sp_nad27 = TRUE; sp = "ND_S";
-    break;
-  case 32022: // PCS_NAD27_Ohio_North
-    sp_nad27 = TRUE; sp = "OH_N";
-    break;
-  case 32023: // PCS_NAD27_Ohio_South
-    sp_nad27 = TRUE; sp = "OH_S";
-    break;
-  case 32024: // PCS_NAD27_Oklahoma_North
-    sp_nad27 = TRUE; sp = "OK_N";
-    break;
-  case 32025: // PCS_NAD27_Oklahoma_South
-    sp_nad27 = TRUE; sp = "OK_S";
-    break;
-  case 32026: // PCS_NAD27_Oregon_North
-    sp_nad27 = TRUE; sp = "OR_N";
-    break;
-  case 32027: // PCS_NAD27_Oregon_South
-    sp_nad27 = TRUE; sp = "OR_S";
-    break;
-  case 32028: // PCS_NAD27_Pennsylvania_N
-    sp_nad27 = TRUE; sp = "PA_N";
-    break;
-  case 32029: // PCS_NAD27_Pennsylvania_S
-    sp_nad27 = TRUE; sp = "PA_S";
-    break;
-  case 32030: // PCS_NAD27_Rhode_Island
-    sp_nad27 = TRUE; sp = "RI";
-    break;
-  case 32031: // PCS_NAD27_South_Carolina_N
-    sp_nad27 = TRUE; sp = "SC_N";
-    break;
-  case 32033: // PCS_NAD27_South_Carolina_S
-    sp_nad27 = TRUE; sp = "SC_S";
-    break;
-  case 32034: // PCS_NAD27_South_Dakota_N
-    sp_nad27 = TRUE; sp = "SD_N";
-    break;
-  case 32035: // PCS_NAD27_South_Dakota_S
-    sp_nad27 = TRUE; sp = "SD_S";
-    break;
-  case 32036: // PCS_NAD27_Tennessee
-    sp_nad27 = TRUE; sp = "TN";
-    break;
-  case 32037: // PCS_NAD27_Texas_North
-    sp_nad27 = TRUE; sp = "TX_N";
-    break;
-  case 32038: // PCS_NAD27_Texas_North_Cen
-    sp_nad27 = TRUE; sp = "TX_NC";
-    break;
-  case 32039: // PCS_NAD27_Texas_Central
-    sp_nad27 = TRUE; sp = "TX_C";
-    break;
-  case 32040: // PCS_NAD27_Texas_South_Cen
-    sp_nad27 = TRUE; sp = "TX_SC";
-    break;
-  case 32041: // PCS_NAD27_Texas_South
-    sp_nad27 = TRUE; sp = "TX_S";
-    break;
-  case 32042: // PCS_NAD27_Utah_North
-    sp_nad27 = TRUE; sp = "UT_N";
-    break;
-  case 32043: // PCS_NAD27_Utah_Central
-    sp_nad27 = TRUE; sp = "UT_C";
-    break;
-  case 32044: // PCS_NAD27_Utah_South
-    sp_nad27 = TRUE; sp = "UT_S";
-    break;
-  case 32045: // PCS_NAD27_Vermont
-    sp_nad27 = TRUE; sp = "VT";
-    break;
-  case 32046: // PCS_NAD27_Virginia_North
-    sp_nad27 = TRUE; sp = "VA_N";
-    break;
-  case 32047: // PCS_NAD27_Virginia_South
-    sp_nad27 = TRUE; sp = "VA_S";
-    break;
-  case 32048: // PCS_NAD27_Washington_North
-    sp_nad27 = TRUE; sp = "WA_N";
-    break;
-  case 32049: // PCS_NAD27_Washington_South
-    sp_nad27 = TRUE; sp = "WA_S";
-    break;
-  case 32050: // PCS_NAD27_West_Virginia_N
-    sp_nad27 = TRUE; sp = "WV_N";
-    break;
-  case 32051: // PCS_NAD27_West_Virginia_S
-    sp_nad27 = TRUE; sp = "WV_S";
-    break;
-  case 32052: // PCS_NAD27_Wisconsin_North
-    sp_nad27 = TRUE; sp = "WI_N";
-    break;
-  case 32053: // PCS_NAD27_Wisconsin_Cen
-    sp_nad27 = TRUE; sp = "WI_C";
-    break;
-  case 32054: // PCS_NAD27_Wisconsin_South
-    sp_nad27 = TRUE; sp = "WI_S";
-    break;
-  case 32055: // PCS_NAD27_Wyoming_East
-    sp_nad27 = TRUE; sp = "WY_E";
-    break;
-  case 32056: // PCS_NAD27_Wyoming_E_Cen
-    sp_nad27 = TRUE; sp = "WY_EC";
-    break;
-  case 32057: // PCS_NAD27_Wyoming_W_Cen
-    sp_nad27 = TRUE; sp = "WY_WC";
-    break;
-  case 32058: // PCS_NAD27_Wyoming_West
-    sp_nad27 = TRUE; sp = "WY_W";
-    break;
-  case 32059: // PCS_NAD27_Puerto_Rico
-    sp_nad27 = TRUE; sp = "PR";
-    break;
-  case 32060: // PCS_NAD27_St_Croix
-    sp_nad27 = TRUE; sp = "St.Croix";
-    break;
-  case 32100: // PCS_NAD83_Montana
-    sp_nad27 = FALSE; sp = "MT";
-    break;
-  case 32104: // PCS_NAD83_Nebraska
-    sp_nad27 = FALSE; sp = "NE";
-    break;
-  case 32107: // PCS_NAD83_Nevada_East
-    sp_nad27 = FALSE; sp = "NV_E";
-    break;
-  case 32108: // PCS_NAD83_Nevada_Central
-    sp_nad27 = FALSE; sp = "NV_C";
-    break;
-  case 32109: // PCS_NAD83_Nevada_West
-    sp_nad27 = FALSE; sp = "NV_W";
-    break;
-  case 32110: // PCS_NAD83_New_Hampshire
-    sp_nad27 = FALSE; sp = "NH";
-    break;
-  case 32111: // PCS_NAD83_New_Jersey
-    sp_nad27 = FALSE; sp = "NJ";
-    break;
-  case 32112: // PCS_NAD83_New_Mexico_East
-    sp_nad27 = FALSE; sp = "NM_E";
-    break;
-  case 32113: // PCS_NAD83_New_Mexico_Cent
-    sp_nad27 = FALSE; sp = "NM_C";
-    break;
-  case 32114: // PCS_NAD83_New_Mexico_West
-    sp_nad27 = FALSE; sp = "NM_W";
-    break;
-  case 32115: // PCS_NAD83_New_York_East
-    sp_nad27 = FALSE; sp = "NY_E";
-    break;
-  case 32116: // PCS_NAD83_New_York_Central
-    sp_nad27 = FALSE; sp = "NY_C";
-    break;
-  case 32117: // PCS_NAD83_New_York_West
-    sp_nad27 = FALSE; sp = "NY_W";
-    break;
-  case 32118: // PCS_NAD83_New_York_Long_Is
-    sp_nad27 = FALSE; sp = "NT_LI";
-    break;
-  case 32119: // PCS_NAD83_North_Carolina
-    sp_nad27 = FALSE; sp = "NC";
-    break;
-  case 32120: // PCS_NAD83_North_Dakota_N
-    sp_nad27 = FALSE; sp = "ND_N";
-    break;
-  case 32121: // PCS_NAD83_North_Dakota_S
-    sp_nad27 = FALSE; sp = "ND_S";
-    break;
-  case 32122: // PCS_NAD83_Ohio_North
-    sp_nad27 = FALSE; sp = "OH_N";
-    break;
-  case 32123: // PCS_NAD83_Ohio_South
-    sp_nad27 = FALSE; sp = "OH_S";
-    break;
-  case 32124: // PCS_NAD83_Oklahoma_North
-    sp_nad27 = FALSE; sp = "OK_N";
-    break;
-  case 32125: // PCS_NAD83_Oklahoma_South
-    sp_nad27 = FALSE; sp = "OK_S";
-    break;
-  case 32126: // PCS_NAD83_Oregon_North
-    sp_nad27 = FALSE; sp = "OR_N";
-    break;
-  case 32127: // PCS_NAD83_Oregon_South
-    sp_nad27 = FALSE; sp = "OR_S";
-    break;
-  case 32128: // PCS_NAD83_Pennsylvania_N
-    sp_nad27 = FALSE; sp = "PA_N";
-    break;
-  case 32129: // PCS_NAD83_Pennsylvania_S
-    sp_nad27 = FALSE; sp = "PA_S";
-    break;
-  case 32130: // PCS_NAD83_Rhode_Island
-    sp_nad27 = FALSE; sp = "RI";
-    break;
-  case 32133: // PCS_NAD83_South_Carolina
-    sp_nad27 = FALSE; sp = "SC";
-    break;
-  case 32134: // PCS_NAD83_South_Dakota_N
-    sp_nad27 = FALSE; sp = "SD_N";
-    break;
-  case 32135: // PCS_NAD83_South_Dakota_S
-    sp_nad27 = FALSE; sp = "SD_S";
-    break;
-  case 32136: // PCS_NAD83_Tennessee
-    sp_nad27 = FALSE; sp = "TN";
-    break;
-  case 32137: // PCS_NAD83_Texas_North
-    sp_nad27 = FALSE; sp = "TX_N";
-    break;
-  case 32138: // PCS_NAD83_Texas_North_Cen
-    sp_nad27 = FALSE; sp = "TX_NC";
-    break;
-  case 32139: // PCS_NAD83_Texas_Central
-    sp_nad27 = FALSE; sp = "TX_C";
-    break;
-  case 32140: // PCS_NAD83_Texas_South_Cen
-    sp_nad27 = FALSE; sp = "TX_SC";
-    break;
-  case 32141: // PCS_NAD83_Texas_South
-    sp_nad27 = FALSE; sp = "TX_S";
-    break;
-  case 32142: // PCS_NAD83_Utah_North
-    sp_nad27 = FALSE; sp = "UT_N";
-    break;
-  case 32143: // PCS_NAD83_Utah_Central
-    sp_nad27 = FALSE; sp = "UT_C";
-    break;
-  case 32144: // PCS_NAD83_Utah_South
-    sp_nad27 = FALSE; sp = "UT_S";
-    break;
-  case 32145: // PCS_NAD83_Vermont
-    sp_nad27 = FALSE; sp = "VT";
-    break;
-  case 32146: // PCS_NAD83_Virginia_North
-    sp_nad27 = FALSE; sp = "VA_N";
-    break;
-  case 32147: // PCS_NAD83_Virginia_South
-    sp_nad27 = FALSE; sp = "VA_S";
-    break;
-  case 32148: // PCS_NAD83_Washington_North
-    sp_nad27 = FALSE; sp = "WA_N";
-    break;
-  case 32149: // PCS_NAD83_Washington_South
-    sp_nad27 = FALSE; sp = "WA_S";
-    break;
-  case 32150: // PCS_NAD83_West_Virginia_N
-    sp_nad27 = FALSE; sp = "WV_N";
-    break;
-  case 32151: // PCS_NAD83_West_Virginia_S
-    sp_nad27 = FALSE; sp = "WV_S";
-    break;
-  case 32152: // PCS_NAD83_Wisconsin_North
-    sp_nad27 = FALSE; sp = "WI_N";
-    break;
-  case 32153: // PCS_NAD83_Wisconsin_Cen
-    sp_nad27 = FALSE; sp = "WI_C";
-    break;
-  case 32154: // PCS_NAD83_Wisconsin_South
-    sp_nad27 = FALSE; sp = "WI_S";
-    break;
-  case 32155: // PCS_NAD83_Wyoming_East
-    sp_nad27 = FALSE; sp = "WY_E";
-    break;
-  case 32156: // PCS_NAD83_Wyoming_E_Cen
-    sp_nad27 = FALSE; sp = "WY_EC";
-    break;
-  case 32157: // PCS_NAD83_Wyoming_W_Cen
-    sp_nad27 = FALSE; sp = "WY_WC";
-    break;
-  case 32158: // PCS_NAD83_Wyoming_West
-    sp_nad27 = FALSE; sp = "WY_W";
-    break;
-  case 32161: // PCS_NAD83_Puerto_Rico_Virgin_Is
-    sp_nad27 = FALSE; sp = "PR";
-    break;
-  case 32201: // PCS_WGS72_UTM_zone_1N 
-  case 32202: // PCS_WGS72_UTM_zone_2N 
-  case 32203: // PCS_WGS72_UTM_zone_3N 
-  case 32204: // PCS_WGS72_UTM_zone_4N 
-  case 32205: // PCS_WGS72_UTM_zone_5N 
-  case 32206: // PCS_WGS72_UTM_zone_6N 
-  case 32207: // PCS_WGS72_UTM_zone_7N 
-  case 32208:
-  case 32209:
-  case 32210:
-  case 32211:
-  case 32212:
-  case 32213:
-  case 32214:
-  case 32215:
-  case 32216:
-  case 32217:
-  case 32218:
-  case 32219:
-  case 32220:
-  case 32221:
-  case 32222:
-  case 32223:
-  case 32224:
-  case 32225:
-  case 32226:
-  case 32227:
-  case 32228:
-  case 32229:
-  case 32230:
-  case 32231:
-  case 32232:
-  case 32233:
-  case 32234:
-  case 32235:
-  case 32236:
-  case 32237:
-  case 32238:
-  case 32239:
-  case 32240:
-  case 32241:
-  case 32242:
-  case 32243:
-  case 32244:
-  case 32245:
-  case 32246:
-  case 32247:
-  case 32248:
-  case 32249:
-  case 32250:
-  case 32251:
-  case 32252:
-  case 32253:
-  case 32254:
-  case 32255:
-  case 32256:
-  case 32257:
-  case 32258:
-  case 32259: // PCS_WGS72_UTM_zone_59N 
-  case 32260: // PCS_WGS72_UTM_zone_60N 
-    utm_northern = TRUE; utm_zone = value-32200;
-    ellipsoid_id = CRS_ELLIPSOID_WGS72;
-    break;
-  case 32301: // PCS_WGS72_UTM_zone_1S
-  case 32302: // PCS_WGS72_UTM_zone_2S
-  case 32303: // PCS_WGS72_UTM_zone_3S
-  case 32304: // PCS_WGS72_UTM_zone_4S
-  case 32305: // PCS_WGS72_UTM_zone_5S
-  case 32306: // PCS_WGS72_UTM_zone_6S
-  case 32307: // PCS_WGS72_UTM_zone_7S
-  case 32308:
-  case 32309:
-  case 32310:
-  case 32311:
-  case 32312:
-  case 32313:
-  case 32314:
-  case 32315:
-  case 32316:
-  case 32317:
-  case 32318:
-  case 32319:
-  case 32320:
-  case 32321:
-  case 32322:
-  case 32323:
-  case 32324:
-  case 32325:
-  case 32326:
-  case 32327:
-  case 32328:
-  case 32329:
-  case 32330:
-  case 32331:
-  case 32332:
-  case 32333:
-  case 32334:
-  case 32335:
-  case 32336:
-  case 32337:
-  case 32338:
-  case 32339:
-  case 32340:
-  case 32341:
-  case 32342:
-  case 32343:
-  case 32344:
-  case 32345:
-  case 32346:
-  case 32347:
-  case 32348:
-  case 32349:
-  case 32350:
-  case 32351:
-  case 32352:
-  case 32353:
-  case 32354:
-  case 32355:
-  case 32356:
-  case 32357:
-  case 32358:
-  case 32359: // PCS_WGS72_UTM_zone_59S
-  case 32360: // PCS_WGS72_UTM_zone_60S
-    utm_northern = FALSE; utm_zone = value-32300;
-    ellipsoid_id = CRS_ELLIPSOID_WGS72;
-    break;
-  case 32401: // PCS_WGS72BE_UTM_zone_1N
-  case 32402: // PCS_WGS72BE_UTM_zone_2N
-  case 32403: // PCS_WGS72BE_UTM_zone_3N
-  case 32404: // PCS_WGS72BE_UTM_zone_4N
-  case 32405: // PCS_WGS72BE_UTM_zone_5N
-  case 32406: // PCS_WGS72BE_UTM_zone_6N
-  case 32407: // PCS_WGS72BE_UTM_zone_7N
-  case 32408:
-  case 32409:
-  case 32410:
-  case 32411:
-  case 32412:
-  case 32413:
-  case 32414:
-  case 32415:
-  case 32416:
-  case 32417:
-  case 32418:
-  case 32419:
-  case 32420:
-  case 32421:
-  case 32422:
-  case 32423:
-  case 32424:
-  case 32425:
-  case 32426:
-  case 32427:
-  case 32428:
-  case 32429:
-  case 32430:
-  case 32431:
-  case 32432:
-  case 32433:
-  case 32434:
-  case 32435:
-  case 32436:
-  case 32437:
-  case 32438:
-  case 32439:
-  case 32440:
-  case 32441:
-  case 32442:
-  case 32443:
-  case 32444:
-  case 32445:
-  case 32446:
-  case 32447:
-  case 32448:
-  case 32449:
-  case 32450:
-  case 32451:
-  case 32452:
-  case 32453:
-  case 32454:
-  case 32455:
-  case 32456:
-  case 32457:
-  case 32458:
-  case 32459: // PCS_WGS72BE_UTM_zone_59N
-  case 32460: // PCS_WGS72BE_UTM_zone_60N
-    utm_northern = TRUE; utm_zone = value-32400;
-    ellipsoid_id = CRS_ELLIPSOID_WGS72;
-    break;
-  case 32501: // PCS_WGS72BE_UTM_zone_1S
-  case 32502: // PCS_WGS72BE_UTM_zone_2S
-  case 32503: // PCS_WGS72BE_UTM_zone_3S
-  case 32504: // PCS_WGS72BE_UTM_zone_4S
-  case 32505: // PCS_WGS72BE_UTM_zone_5S
-  case 32506: // PCS_WGS72BE_UTM_zone_6S
-  case 32507: // PCS_WGS72BE_UTM_zone_7S
-  case 32508:
-  case 32509:
-  case 32510:
-  case 32511:
-  case 32512:
-  case 32513:
-  case 32514:
-  case 32515:
-  case 32516:
-  case 32517:
-  case 32518:
-  case 32519:
-  case 32520:
-  case 32521:
-  case 32522:
-  case 32523:
-  case 32524:
-  case 32525:
-  case 32526:
-  case 32527:
-  case 32528:
-  case 32529:
-  case 32530:
-  case 32531:
-  case 32532:
-  case 32533:
-  case 32534:
-  case 32535:
-  case 32536:
-  case 32537:
-  case 32538:
-  case 32539:
-  case 32540:
-  case 32541:
-  case 32542:
-  case 32543:
-  case 32544:
-  case 32545:
-  case 32546:
-  case 32547:
-  case 32548:
-  case 32549:
-  case 32550:
-  case 32551:
-  case 32552:
-  case 32553:
-  case 32554:
-  case 32555:
-  case 32556:
-  case 32557:
-  case 32558:
-  case 32559: // PCS_WGS72BE_UTM_zone_59S
-  case 32560: // PCS_WGS72BE_UTM_zone_60S
-    utm_northern = FALSE; utm_zone = value-32500;
-    ellipsoid_id = CRS_ELLIPSOID_WGS72;
-    break;
-  case 32601: // PCS_WGS84_UTM_zone_1N
-  case 32602: // PCS_WGS84_UTM_zone_2N
-  case 32603: // PCS_WGS84_UTM_zone_3N
-  case 32604: // PCS_WGS84_UTM_zone_4N
-  case 32605: // PCS_WGS84_UTM_zone_5N
-  case 32606: // PCS_WGS84_UTM_zone_6N
-  case 32607: // PCS_WGS84_UTM_zone_7N
-  case 32608:
-  case 32609:
-  case 32610:
-  case 32611:
-  case 32612:
-  case 32613:
-  case 32614:
-  case 32615:
-  case 32616:
-  case 32617:
-  case 32618:
-  case 32619:
-  case 32620:
-  case 32621:
-  case 32622:
-  case 32623:
-  case 32624:
-  case 32625:
-  case 32626:
-  case 32627:
-  case 32628:
-  case 32629:
-  case 32630:
-  case 32631:
-  case 32632:
-  case 32633:
-  case 32634:
-  case 32635:
-  case 32636:
-  case 32637:
-  case 32638:
-  case 32639:
-  case 32640:
-  case 32641:
-  case 32642:
-  case 32643:
-  case 32644:
-  case 32645:
-  case 32646:
-  case 32647:
-  case 32648:
-  case 32649:
-  case 32650:
-  case 32651:
-  case 32652:
-  case 32653:
-  case 32654:
-  case 32655:
-  case 32656:
-  case 32657:
-  case 32658:
-  case 32659: // PCS_WGS84_UTM_zone_59N
-  case 32660: // PCS_WGS84_UTM_zone_60N
-    utm_northern = TRUE; utm_zone = value-32600;
-    ellipsoid_id = CRS_ELLIPSOID_WGS84;
-    break;
-  case 32701: // PCS_WGS84_UTM_zone_1S
-  case 32702: // PCS_WGS84_UTM_zone_2S
-  case 32703: // PCS_WGS84_UTM_zone_3S
-  case 32704: // PCS_WGS84_UTM_zone_4S
-  case 32705: // PCS_WGS84_UTM_zone_5S
-  case 32706: // PCS_WGS84_UTM_zone_6S
-  case 32707: // PCS_WGS84_UTM_zone_7S
-  case 32708:
-  case 32709:
-  case 32710:
-  case 32711:
-  case 32712:
-  case 32713:
-  case 32714:
-  case 32715:
-  case 32716:
-  case 32717:
-  case 32718:
-  case 32719:
-  case 32720:
-  case 32721:
-  case 32722:
-  case 32723:
-  case 32724:
-  case 32725:
-  case 32726:
-  case 32727:
-  case 32728:
-  case 32729:
-  case 32730:
-  case 32731:
-  case 32732:
-  case 32733:
-  case 32734:
-  case 32735:
-  case 32736:
-  case 32737:
-  case 32738:
-  case 32739:
-  case 32740:
-  case 32741:
-  case 32742:
-  case 32743:
-  case 32744:
-  case 32745:
-  case 32746:
-  case 32747:
-  case 32748:
-  case 32749:
-  case 32750:
-  case 32751:
-  case 32752:
-  case 32753:
-  case 32754:
-  case 32755:
-  case 32756:
-  case 32757:
-  case 32758:
-  case 32759: // PCS_WGS84_UTM_zone_59S
-  case 32760: // PCS_WGS84_UTM_zone_60S
-    utm_northern = FALSE; utm_zone = value-32700;
-    ellipsoid_id = CRS_ELLIPSOID_WGS84;
-    break;
+void CRScheck::set_elevation_in_feet(const BOOL from_geokeys)
+{
+  if (from_geokeys)
+    elevation_units[0] = 2;
+  else
+    elevation_units[1] = 2;
+}
+
+void CRScheck::set_elevation_in_meter(const BOOL from_geokeys)
+{
+  if (from_geokeys)
+    elevation_units[0] = 1;
+  else
+    elevation_units[1] = 1;
+}
+
+BOOL CRScheck::set_ellipsoid(const I32 ellipsoid_id, const BOOL from_geokeys, char* description)
+{
+  if ((ellipsoid_id <= 0) || (ellipsoid_id >= 25))
+  {
+    return FALSE;
+  }
+
+  CRSprojectionEllipsoid* ellipsoid;
+
+  if (from_geokeys)
+  {
+    if (ellipsoids[0] == 0)
+    {
+      ellipsoids[0] = new CRSprojectionEllipsoid();
+    }
+    ellipsoid = ellipsoids[0];
+  }
+  else
+  {
+    if (ellipsoids[1] == 0)
+    {
+      ellipsoids[1] = new CRSprojectionEllipsoid();
+    }
+    ellipsoid = ellipsoids[1];
+  }
+
+  ellipsoid->id = ellipsoid_id;
+  ellipsoid->name = ellipsoid_list[ellipsoid_id].name;
+  ellipsoid->equatorial_radius = ellipsoid_list[ellipsoid_id].equatorialRadius;
+  ellipsoid->eccentricity_squared = ellipsoid_list[ellipsoid_id].eccentricitySquared;
+  ellipsoid->eccentricity_prime_squared = (ellipsoid->eccentricity_squared)/(1-ellipsoid->eccentricity_squared);
+  ellipsoid->polar_radius = ellipsoid->equatorial_radius*sqrt(1-ellipsoid->eccentricity_squared);    
+  ellipsoid->eccentricity = sqrt(ellipsoid->eccentricity_squared);
+  ellipsoid->eccentricity_e1 = (1-sqrt(1-ellipsoid->eccentricity_squared))/(1+sqrt(1-ellipsoid->eccentricity_squared));
+
+  if (description)
+  {
+    sprintf(description, "%2d - %s (%g %g)", ellipsoid->id, ellipsoid->name, ellipsoid->equatorial_radius, ellipsoid->eccentricity_squared);
+  }
+
+  return TRUE;
+}
+
+// finds the known ellipsoid closest to the parameters or otherwise keeps them
+// as a user defined one
+
+BOOL CRScheck::set_ellipsoid(const F64 equatorial_radius, const F64 inverse_flattening, const BOOL from_geokeys, char* description)
+{
+  if (equatorial_radius <= 0.0)
+  {
+    return FALSE;
+  }
+
+  I32 id, best_id = -1;
+  F64 best_difference = 0.001;
+  for (id = 1; id < 25; id++)
+  {
+    if (fabs(ellipsoid_list[id].equatorialRadius - equatorial_radius) < 0.5)
+    {
+      F64 difference = fabs(ellipsoid_list[id].inverseFlattening - inverse_flattening);
+      if (difference < best_difference)
+      {
+        best_difference = difference;
+        best_id = id;
+      }
+    }
+  }
+
+  if (best_id != -1)
+  {
+    return set_ellipsoid(best_id, from_geokeys, description);
+  }
+
+  CRSprojectionEllipsoid* ellipsoid;
+
+  if (from_geokeys)
+  {
+    if (ellipsoids[0] == 0)
+    {
+      ellipsoids[0] = new CRSprojectionEllipsoid();
+    }
+    ellipsoid = ellipsoids[0];
+  }
+  else
+  {
+    if (ellipsoids[1] == 0)
+    {
+      ellipsoids[1] = new CRSprojectionEllipsoid();
+    }
+    ellipsoid = ellipsoids[1];
+  }
+
+  // an inverse flattening of zero is a sphere
+
+  ellipsoid->id = 0;
+  ellipsoid->name = "user defined";
+  ellipsoid->equatorial_radius = equatorial_radius;
+  ellipsoid->inverse_flattening = inverse_flattening;
+  ellipsoid->eccentricity_squared = (inverse_flattening > 0.0 ? (2.0 - 1.0/inverse_flattening)/inverse_flattening : 0.0);
+  ellipsoid->eccentricity_prime_squared = (ellipsoid->eccentricity_squared)/(1-ellipsoid->eccentricity_squared);
+  ellipsoid->polar_radius = ellipsoid->equatorial_radius*sqrt(1-ellipsoid->eccentricity_squared);
+  ellipsoid->eccentricity = sqrt(ellipsoid->eccentricity_squared);
+  ellipsoid->eccentricity_e1 = (1-sqrt(1-ellipsoid->eccentricity_squared))/(1+sqrt(1-ellipsoid->eccentricity_squared));
+
+  if (description)
+  {
+    sprintf(description, "user defined ellipsoid (%g %g)", ellipsoid->equatorial_radius, ellipsoid->eccentricity_squared);
+  }
+
+  return TRUE;
+}
+
+void CRScheck::set_projection(CRSprojectionParameters* projection, const BOOL from_geokeys)
+{
+  if (from_geokeys)
+  {
+    if (projections[0]) delete projections[0];
+    projections[0] = projection;
+  }
+  else
+  {
+    if (projections[1]) delete projections[1];
+    projections[1] = projection;
+  }
+}
+
+BOOL CRScheck::set_latlong_projection(const BOOL from_geokeys, CHAR* description)
+{
+  CRSprojectionParameters* latlong = new CRSprojectionParameters();
+  latlong->type = CRS_PROJECTION_LAT_LONG;
+  sprintf(latlong->name, "latitude/longitude");
+  set_projection(latlong, from_geokeys);
+  if (description)
+  {
+    sprintf(description, "%s", latlong->name);
+  }
+  return TRUE;
+}
+
+BOOL CRScheck::set_longlat_projection(const BOOL from_geokeys, CHAR* description)
+{
+  CRSprojectionParameters* longlat = new CRSprojectionParameters();
+  longlat->type = CRS_PROJECTION_LONG_LAT;
+  sprintf(longlat->name, "longitude/latitude");
+  set_projection(longlat, from_geokeys);
+  if (description)
+  {
+    sprintf(description, "%s", longlat->name);
+  }
+  return TRUE;
+}
+
+BOOL CRScheck::set_utm_projection(const CHAR* zone, const BOOL from_geokeys, CHAR* description)
+{
+  I32 zone_number;
+  CHAR* zone_letter;
+  zone_number = strtoul(zone, &zone_letter, 10);
+  if ((*zone_letter < 'C') || (*zone_letter > 'X'))
+  {
+    return FALSE;
+  }
+  if ((zone_number < 0) || (zone_number > 60))
+  {
+    return FALSE;
+  }
+  CRSprojectionParametersUTM* utm = new CRSprojectionParametersUTM();
+  utm->type = CRS_PROJECTION_UTM;
+  utm->utm_zone_number = zone_number;
+  utm->utm_zone_letter = *zone_letter;
+  if((*zone_letter - 'N') >= 0)
+  {
+    utm->utm_northern_hemisphere = TRUE; // point is in northern hemisphere
+  }
+  else
+  {
+    utm->utm_northern_hemisphere = FALSE; //point is in southern hemisphere
   }
+  sprintf(utm->name, "UTM zone %s (%s)", zone, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
+  utm->utm_long_origin = (zone_number - 1) * 6 - 180 + 3; // + 3 puts origin in middle of zone
+  set_projection(utm, from_geokeys);
+  if (description)
+  {
+    sprintf(description, "UTM %d %s", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
+  }
+  return TRUE;
+}
 
-  if (ellipsoid_id == -1)
+BOOL CRScheck::set_utm_projection(const I32 zone_number, const BOOL northern, const BOOL from_geokeys, CHAR* description)
+{
+  if ((zone_number < 0) || (zone_number > 60))
+  {
+    return FALSE;
+  }
+  CRSprojectionParametersUTM* utm = new CRSprojectionParametersUTM();
+  utm->type = CRS_PROJECTION_UTM;
+  utm->utm_zone_number = zone_number;
+  utm->utm_zone_letter = ' ';
+  utm->utm_northern_hemisphere = northern;
+  sprintf(utm->name, "UTM zone %d (%s)", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
+  utm->utm_long_origin = (zone_number - 1) * 6 - 180 + 3;  // + 3 puts origin in middle of zone
+  set_projection(utm, from_geokeys);
+  if (description)
+  {
+    sprintf(description, "UTM %d %s", zone_number, (utm->utm_northern_hemisphere ? "northern hemisphere" : "southern hemisphere"));
+  }
+  return TRUE;
+}
+
+// Configure a Lambert Conic Conformal Projection
+//
+// The function Set_Lambert_Parameters receives the ellipsoid parameters and
+// Lambert Conformal Conic projection parameters as inputs, and sets the
+// corresponding state variables.
+//
+// falseEasting & falseNorthing are just an offset in meters added 
+// to the final coordinate calculated.
+//
+// latOriginDegree & longMeridianDegree are the "center" latitiude and
+// longitude in decimal degrees of the area being projected. All coordinates
+// will be calculated in meters relative to this point on the earth.
+//
+// firstStdParallelDegree & secondStdParallelDegree are the two lines of
+// longitude in decimal degrees (that is they run east-west) that define
+// where the "cone" intersects the earth. They bracket the area being projected.
+void CRScheck::set_lambert_conformal_conic_projection(const F64 falseEasting, const F64 falseNorthing, const F64 latOriginDegree, const F64 longMeridianDegree, const F64 firstStdParallelDegree, const F64 secondStdParallelDegree, const BOOL from_geokeys, CHAR* description)
+{
+  CRSprojectionParametersLCC* lcc = new CRSprojectionParametersLCC();
+  lcc->type = CRS_PROJECTION_LCC;
+  sprintf(lcc->name, "Lambert Conformal Conic");
+  lcc->lcc_false_easting_meter = falseEasting;
+  lcc->lcc_false_northing_meter = falseNorthing;
+  lcc->lcc_lat_origin_degree = latOriginDegree;
+  lcc->lcc_long_meridian_degree = longMeridianDegree;
+  lcc->lcc_first_std_parallel_degree = firstStdParallelDegree;
+  lcc->lcc_second_std_parallel_degree = secondStdParallelDegree;
+  lcc->lcc_lat_origin_radian = deg2rad*lcc->lcc_lat_origin_degree;
+  lcc->lcc_long_meridian_radian = deg2rad*lcc->lcc_long_meridian_degree;
+  lcc->lcc_first_std_parallel_radian = deg2rad*lcc->lcc_first_std_parallel_degree;
+  lcc->lcc_second_std_parallel_radian = deg2rad*lcc->lcc_second_std_parallel_degree;
+  set_projection(lcc, from_geokeys);
+  if (description)
   {
-    if (utm_zone != -1) ellipsoid_id = CRS_ELLIPSOID_WGS84;
-    else if (sp != 0) ellipsoid_id = (sp_nad27 ? CRS_ELLIPSOID_NAD27 : CRS_ELLIPSOID_NAD83);
+    sprintf(description, "false east/north: %g/%g [m], origin lat/ meridian long: %g/%g, parallel 1st/2nd: %g/%g", lcc->lcc_false_easting_meter, lcc->lcc_false_northing_meter, lcc->lcc_lat_origin_degree, lcc->lcc_long_meridian_degree, lcc->lcc_first_std_parallel_degree, lcc->lcc_second_std_parallel_degree);
   }
+}
 
-  if (ellipsoid_id != -1)
+/*
+  * The function set_transverse_mercator_projection receives the Tranverse
+  * Mercator projection parameters as input and sets the corresponding state
+  * variables. 
+  * falseEasting   : Easting/X in meters at the center of the projection
+  * falseNorthing  : Northing/Y in meters at the center of the projection
+  * latOriginDegree     : Latitude in decimal degree at the origin of the projection
+  * longMeridianDegree  : Longitude n decimal degree at the center of the projection
+  * scaleFactor         : Projection scale factor
+*/
+void CRScheck::set_transverse_mercator_projection(const F64 falseEasting, const F64 falseNorthing, const F64 latOriginDegree, const F64 longMeridianDegree, const F64 scaleFactor, const BOOL from_geokeys, CHAR* description)
+{
+  CRSprojectionParametersTM* tm = new CRSprojectionParametersTM();
+  tm->type = CRS_PROJECTION_TM;
+  sprintf(tm->name, "Transverse Mercator");
+  tm->tm_false_easting_meter = falseEasting;
+  tm->tm_false_northing_meter = falseNorthing;
+  tm->tm_lat_origin_degree = latOriginDegree;
+  tm->tm_long_meridian_degree = longMeridianDegree;
+  tm->tm_scale_factor = scaleFactor;
+  tm->tm_lat_origin_radian = deg2rad*tm->tm_lat_origin_degree;
+  tm->tm_long_meridian_radian = deg2rad*tm->tm_long_meridian_degree;
+  set_projection(tm, from_geokeys);
+  if (description)
   {
-    set_ellipsoid(ellipsoid_id, TRUE);
+    sprintf(description, "false east/north: %g/%g [m], origin lat/meridian long: %g/%g, scale: %g", tm->tm_false_easting_meter, tm->tm_false_northing_meter, tm->tm_lat_origin_degree, tm->tm_long_meridian_degree, tm->tm_scale_factor);
   }
+}
 
-  if (utm_zone != -1)
+BOOL CRScheck::set_state_plane_nad27_lcc(const U16 epsg, const BOOL from_geokeys, CHAR* description)
+{
+  const StatePlaneLCC* sp = find_state_plane_lcc(state_plane_lcc_nad27_list, sizeof(state_plane_lcc_nad27_list)/sizeof(StatePlaneLCC) - 1, epsg);
+  if (sp == 0)
   {
-    if (set_utm_projection(utm_zone, utm_northern, TRUE, description))
-    {
-      return TRUE;
-    }
+    return FALSE;
   }
-
-  if (sp)
+  set_ellipsoid(CRS_ELLIPSOID_NAD27, from_geokeys);
+  set_lambert_conformal_conic_projection(sp->falseEasting, sp->falseNorthing, sp->latOriginDegree, sp->longMeridianDegree, sp->firstStdParallelDegree, sp->secondStdParallelDegree, from_geokeys);
+  if (description)
   {
-    if (sp_nad27)
-    {
-      if (set_state_plane_nad27_lcc(sp, TRUE, description))
-      {
-        return TRUE;
-      }
-      if (set_state_plane_nad27_tm(sp, TRUE, description))
-      {
-        return TRUE;
-      }
-    }
-    else
-    {
-      if (set_state_plane_nad83_lcc(sp, TRUE, description))
-      {
-        return TRUE;
-      }
-      if (set_state_plane_nad83_tm(sp, TRUE, description))
-      {
-        return TRUE;
-      }
-    }
+    sprintf(description, "stateplane27 %s", sp->zone);
   }
+  return TRUE;
+}
 
-  if (value == EPSG_ETRS89_Poland_CS92)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, -5300000.0, 0.0, 19.0, 0.9993, 0); // "ETRS89 / Poland CS92"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / Poland CS92");
-    return TRUE;
-  }
-  else if (value == EPSG_NZGD2000)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(1600000.0, 10000000.0, 0.0, 173.0, 0.9996, 0); // "NZGD2000 / New Zealand Transverse Mercator 2000"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "NZGD2000");
-    return TRUE;
-  }
-  else if (value == EPSG_NAD83_HARN_UTM2_South_American_Samoa)
+BOOL CRScheck::set_state_plane_nad83_lcc(const U16 epsg, const BOOL from_geokeys, CHAR* description)
+{
+  const StatePlaneLCC* sp = find_state_plane_lcc(state_plane_lcc_nad83_list, sizeof(state_plane_lcc_nad83_list)/sizeof(StatePlaneLCC) - 1, epsg);
+  if (sp == 0)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 10000000.0, 0.0, -171.0, 0.9996, 0); // "NAD83(HARN) / UTM zone 2S (American Samoa)"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "UTM zone 2S (American Samoa)");
-    return TRUE;
+    return FALSE;
   }
-  else if (value == EPSG_NAD83_HARN_Virginia_North_ftUS)
+  set_ellipsoid(CRS_ELLIPSOID_NAD83, from_geokeys);
+  set_lambert_conformal_conic_projection(sp->falseEasting, sp->falseNorthing, sp->latOriginDegree, sp->longMeridianDegree, sp->firstStdParallelDegree, sp->secondStdParallelDegree, from_geokeys);
+  if (description)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(11482916.667, 6561666.667, 37.66666666666666, -78.5, 39.2, 38.03333333333333, 0); // "NAD83(HARN) / Virginia North (ftUS)"
-    set_coordinates_in_survey_feet(TRUE);
-    if (description) sprintf(description, "NAD83(HARN) / Virginia North (ftUS)");
-    return TRUE;
+    sprintf(description, "stateplane83 %s", sp->zone);
   }
-  else if (value == EPSG_NAD83_HARN_Virginia_South_ftUS)
+  return TRUE;
+}
+
+BOOL CRScheck::set_state_plane_nad27_tm(const U16 epsg, const BOOL from_geokeys, CHAR* description)
+{
+  const StatePlaneTM* sp = find_state_plane_tm(state_plane_tm_nad27_list, sizeof(state_plane_tm_nad27_list)/sizeof(StatePlaneTM) - 1, epsg);
+  if (sp == 0)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(11482916.667, 3280833.333, 36.33333333333334, -78.5, 37.96666666666667, 36.76666666666667, 0); // "NAD83(HARN) / Virginia South (ftUS)"
-    set_coordinates_in_survey_feet(TRUE);
-    if (description) sprintf(description, "NAD83(HARN) / Virginia South (ftUS)");
-    return TRUE;
+    return FALSE;
   }
-  else if (value == EPSG_ETRS89_ETRS_LCC)
+  set_ellipsoid(CRS_ELLIPSOID_NAD27, from_geokeys);
+  set_transverse_mercator_projection(sp->falseEasting, sp->falseNorthing, sp->latOriginDegree, sp->longMeridianDegree, sp->scaleFactor, from_geokeys);
+  if (description)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(4000000.0, 2800000.0, 52.0, 10.0, 35.0, 65.0, 0); // "ETRS89 / ETRS-LCC"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-LCC");
-    return TRUE;
+    sprintf(description, "stateplane27 %s", sp->zone);
   }
-  else if (value == EPSG_ETRS89_ETRS_TM34)
+  return TRUE;
+}
+
+BOOL CRScheck::set_state_plane_nad83_tm(const U16 epsg, const BOOL from_geokeys, CHAR* description)
+{
+  const StatePlaneTM* sp = find_state_plane_tm(state_plane_tm_nad83_list, sizeof(state_plane_tm_nad83_list)/sizeof(StatePlaneTM) - 1, epsg);
+  if (sp == 0)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 21.0, 0.9996, 0); // "ETRS89 / ETRS-TM34"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-TM34");
-    return TRUE;
+    return FALSE;
   }
-  else if (value == EPSG_ETRS89_ETRS_TM35)
+  set_ellipsoid(CRS_ELLIPSOID_NAD83, from_geokeys);
+  set_transverse_mercator_projection(sp->falseEasting, sp->falseNorthing, sp->latOriginDegree, sp->longMeridianDegree, sp->scaleFactor, from_geokeys);
+  if (description)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 27.0, 0.9996, 0); // "ETRS89 / ETRS-TM35"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-TM35");
-    return TRUE;
+    sprintf(description, "stateplane83 %s", sp->zone);
   }
-  else if (value == EPSG_ETRS89_ETRS_TM36)
+  return TRUE;
+}
+
+BOOL CRScheck::set_vertical_from_VerticalCSTypeGeoKey(U16 value)
+{
+  if ((5000 <= value) && (value <= 5099))      // [5000, 5099] = EPSG Ellipsoid Vertical CS Codes
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 33.0, 0.9996, 0); // "ETRS89 / ETRS-TM36"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-TM36");
-    return TRUE;
+    vertical_epsg[0] = value;
   }
-  else if (value == EPSG_ETRS89_ETRS_TM35FIN)
+  else if ((5101 <= value) && (value <= 5199)) // [5100, 5199] = EPSG Orthometric Vertical CS Codes
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, 0.0, 0.0, 27.0, 0.9996, 0); // "ETRS89 / ETRS-TM35FIN"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / ETRS-TM35FIN");
-    return TRUE;
+    vertical_epsg[0] = value;
   }
-  else if (value == EPSG_Fiji_1956_UTM60_South)
+  else if ((5200 <= value) && (value <= 5999)) // [5200, 5999] = Reserved EPSG
   {
-    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
-    set_utm_projection(60, false, 0); // "Fiji 1956 / UTM zone 60S"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Fiji 1956 / UTM zone 60S");
+    vertical_epsg[0] = value;
   }
-  else if (value == EPSG_Fiji_1956_UTM1_South)
+  else
   {
-    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
-    set_utm_projection(1, false, 0); // "Fiji 1956 / UTM zone 1S"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Fiji 1956 / UTM zone 1S");
+//    fprintf(stderr, "set_VerticalCSTypeGeoKey: look-up for %d not implemented\012", value);
+    return FALSE;
   }
-  else if (value == EPSG_Fiji_Map_Grid_1986)
+  return TRUE;
+}
+
+BOOL CRScheck::set_coordinates_from_ProjLinearUnitsGeoKey(U16 value)
+{
+  switch (value)
   {
-    set_ellipsoid(CRS_ELLIPSOID_WGS72, TRUE);
-    set_transverse_mercator_projection(2000000.0, 4000000.0, -17.0, 178.75, 0.99985, 0); // "Fiji 1986 / Fiji Map Grid"
+  case 9001: // Linear_Meter
     set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Fiji 1986 / Fiji Map Grid");
-    return TRUE;
-  }
-  else if (value == EPSG_Slovene_National_Grid_1996)
-  {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(1312333.333 * surveyfeet2meter, 0.0 * surveyfeet2meter, 37.66666666666666, -77, 39.45, 38.3, 0); // "NAD83(NSRS2007) / Maryland (ftUS)"
+    break;
+  case 9002: // Linear_Foot
+    set_coordinates_in_feet(TRUE);
+    break;
+  case 9003: // Linear_Foot_US_Survey
     set_coordinates_in_survey_feet(TRUE);
-    if (description) sprintf(description, "NAD83(NSRS2007) / Maryland (ftUS)");
-    return TRUE;
+    break;
+  default:
+//    fprintf(stderr, "set_VerticalUnitsGeoKey: look-up for %d not implemented\n", value);
+    return FALSE;
   }
-  else if (value == EPSG_Slovene_National_Grid_1996)
+  return TRUE;
+}
+
+BOOL CRScheck::set_elevation_from_VerticalUnitsGeoKey(U16 value)
+{
+  switch (value)
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(500000.0, -5000000.0, 0.0, 15.0, 0.9999, 0); // "Slovenia 1996 / Slovene National Grid"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Slovenia 1996 / Slovene National Grid");
-    return TRUE;
+  case 9001: // Linear_Meter
+    set_elevation_in_meter(TRUE);
+    break;
+  case 9002: // Linear_Foot
+    set_elevation_in_feet(TRUE);
+    break;
+  case 9003: // Linear_Foot_US_Survey
+    set_elevation_in_survey_feet(TRUE);
+    break;
+  default:
+//    fprintf(stderr, "set_VerticalUnitsGeoKey: look-up for %d not implemented\n", value);
+    return FALSE;
   }
-  else if (value == EPSG_MGI_1901_Slovene_National_Grid)
+  return TRUE;
+}
+
+static const short EPSG_ETRS89_Poland_CS92 = 2180;
+static const short EPSG_NZGD2000 = 2193;
+static const short EPSG_NAD83_HARN_UTM2_South_American_Samoa = 2195;
+static const short EPSG_NAD83_HARN_Virginia_North_ftUS = 2924;
+static const short EPSG_NAD83_HARN_Virginia_South_ftUS = 2925;
+static const short EPSG_ETRS89_ETRS_LCC = 3034;
+static const short EPSG_ETRS89_ETRS_TM34 = 3046;
+static const short EPSG_ETRS89_ETRS_TM35 = 3047;
+static const short EPSG_ETRS89_ETRS_TM36 = 3048;
+static const short EPSG_ETRS89_ETRS_TM35FIN = 3067;
+static const short EPSG_Fiji_1956_UTM60_South = 3141;
+static const short EPSG_Fiji_1956_UTM1_South = 3142;
+static const short EPSG_Fiji_Map_Grid_1986 = 3460;
+static const short EPSG_NAD83_NSRS2007_Maryland_ftUS = 3582;
+static const short EPSG_Slovene_National_Grid_1996 = 3794;
+static const short EPSG_MGI_1901_Slovene_National_Grid = 3912;
+static const short EPSG_RGF93_CC42 = 3942;
+static const short EPSG_RGF93_CC43 = 3943;
+static const short EPSG_RGF93_CC44 = 3944;
+static const short EPSG_RGF93_CC45 = 3945;
+static const short EPSG_RGF93_CC46 = 3946;
+static const short EPSG_RGF93_CC47 = 3947;
+static const short EPSG_RGF93_CC48 = 3948;
+static const short EPSG_RGF93_CC49 = 3949;
+static const short EPSG_RGF93_CC50 = 3950;
+static const short EPSG_ETRS89_DKTM1 = 4093;
+static const short EPSG_ETRS89_DKTM2 = 4094;
+static const short EPSG_ETRS89_DKTM3 = 4095;
+static const short EPSG_ETRS89_DKTM4 = 4096;
+static const short EPSG_ETRS89_UTM32_north_zE_N = 4647;
+static const short EPSG_ETRS89_NTM_zone_5 = 5105;
+static const short EPSG_ETRS89_NTM_zone_6 = 5106;
+static const short EPSG_ETRS89_NTM_zone_7 = 5107;
+static const short EPSG_ETRS89_NTM_zone_8 = 5108;
+static const short EPSG_ETRS89_NTM_zone_9 = 5109;
+static const short EPSG_ETRS89_NTM_zone_10 = 5110;
+static const short EPSG_ETRS89_NTM_zone_11 = 5111;
+static const short EPSG_ETRS89_NTM_zone_12 = 5112;
+static const short EPSG_ETRS89_NTM_zone_13 = 5113;
+static const short EPSG_ETRS89_NTM_zone_14 = 5114;
+static const short EPSG_ETRS89_NTM_zone_15 = 5115;
+static const short EPSG_ETRS89_NTM_zone_16 = 5116;
+static const short EPSG_ETRS89_NTM_zone_17 = 5117;
+static const short EPSG_ETRS89_NTM_zone_18 = 5118;
+static const short EPSG_ETRS89_NTM_zone_19 = 5119;
+static const short EPSG_ETRS89_NTM_zone_20 = 5120;
+static const short EPSG_ETRS89_NTM_zone_21 = 5121;
+static const short EPSG_ETRS89_NTM_zone_22 = 5122;
+static const short EPSG_ETRS89_NTM_zone_23 = 5123;
+static const short EPSG_ETRS89_NTM_zone_24 = 5124;
+static const short EPSG_ETRS89_NTM_zone_25 = 5125;
+static const short EPSG_ETRS89_NTM_zone_26 = 5126;
+static const short EPSG_ETRS89_NTM_zone_27 = 5127;
+static const short EPSG_ETRS89_NTM_zone_28 = 5128;
+static const short EPSG_ETRS89_NTM_zone_29 = 5129;
+static const short EPSG_ETRS89_NTM_zone_30 = 5130;
+static const short EPSG_ETRS89_UTM33_north_zE_N = 5650;
+static const short EPSG_OSGB_1936 = 27700;
+static const short EPSG_Belgian_Lambert_1972 = 31370;
+
+// projected CRSs that are UTM zones. the zone is the EPSG code minus the
+// offset and an ellipsoid of -1 means WGS 84. single zones with their own
+// name are described and in meter. sorted by EPSG code.
+
+class CRSepsgUTM
+{
+public:
+  U16 first;
+  U16 last;
+  U16 offset;
+  BOOL northern;
+  I32 ellipsoid_id;
+  const CHAR* description;
+};
+
+static const CRSepsgUTM epsg_utm_list[] =
+{
+  { 2955, 2957, 2944, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83(CSRS) / UTM zone 11N to 13N
+  { 2958, 2962, 2941, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83(CSRS) / UTM zone 17N to 21N
+  { 3097, 3101, 3046, TRUE, CRS_ELLIPSOID_NAD83 }, // JGD2000 / UTM zone 51N to 55N
+  { 3141, 3141, 3081, FALSE, CRS_ELLIPSOID_Inter, "Fiji 1956 / UTM zone 60S" },
+  { 3142, 3142, 3141, FALSE, CRS_ELLIPSOID_Inter, "Fiji 1956 / UTM zone 1S" },
+  { 3154, 3157, 3147, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83(CSRS) / UTM zone 7N to 10N
+  { 3158, 3160, 3144, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83(CSRS) / UTM zone 14N to 16N
+  { 3740, 3749, 3730, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83(HARN) / UTM zone 10N to 19N
+  { 3761, 3761, 3739, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83(CSRS) / UTM zone 22N
+  { 6328, 6329, 6269, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83(2011) / UTM zone 59N to 60N
+  { 6330, 6348, 6329, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83(2011) / UTM zone 1N to 19N
+  { 6688, 6692, 6637, TRUE, CRS_ELLIPSOID_NAD83 }, // JGD2011 / UTM zone 51N to 55N
+  { 7846, 7859, 7800, FALSE, CRS_ELLIPSOID_NAD83 }, // GDA2020 / MGA zone 46 to 59
+  { 20137, 20138, 20100, TRUE, -1 }, // Adindan_UTM_zone_37N to 38N
+  { 20437, 20439, 20400, TRUE, -1 }, // Ain_el_Abd_UTM_zone_37N to 39N
+  { 20538, 20539, 20500, TRUE, -1 }, // Afgooye_UTM_zone_38N to 39N
+  { 20822, 20824, 20800, FALSE, -1 }, // Aratu_UTM_zone_22S to 24S
+  { 21148, 21150, 21100, FALSE, -1 }, // Batavia_UTM_zone_48S to 50S
+  { 21817, 21818, 21800, TRUE, -1 }, // Bogota_UTM_zone_17N to 18N
+  { 22032, 22033, 22000, FALSE, -1 }, // Camacupa_UTM_32S to 33S
+  { 22332, 22332, 22300, TRUE, -1 }, // Carthage_UTM_zone_32N
+  { 22523, 22524, 22500, FALSE, -1 }, // Corrego_Alegre_UTM_23S to 24S
+  { 22832, 22832, 22800, TRUE, -1 }, // Douala_UTM_zone_32N
+  { 23028, 23038, 23000, TRUE, CRS_ELLIPSOID_Inter }, // ED50_UTM_zone_28N to 38N
+  { 23239, 23240, 23200, TRUE, -1 }, // Fahud_UTM_zone_39N to 40N
+  { 23433, 23433, 23400, TRUE, -1 }, // Garoua_UTM_zone_33N
+  { 23846, 23853, 23800, TRUE, CRS_ELLIPSOID_ID74 }, // ID74_UTM_zone_46N to 53N
+  { 23886, 23894, 23840, FALSE, CRS_ELLIPSOID_ID74 }, // ID74_UTM_zone_46S to 54S
+  { 23947, 23948, 23900, TRUE, -1 }, // Indian_1954_UTM_47N to 48N
+  { 24047, 24048, 24000, TRUE, -1 }, // Indian_1975_UTM_47N to 48N
+  { 24547, 24548, 24500, TRUE, -1 }, // Kertau_UTM_zone_47N to 48N
+  { 24720, 24721, 24700, TRUE, -1 }, // La_Canoa_UTM_zone_20N to 21N
+  { 24818, 24821, 24800, TRUE, -1 }, // PSAD56_UTM_zone_18N to 21N
+  { 24877, 24880, 24860, FALSE, -1 }, // PSAD56_UTM_zone_17S to 20S
+  { 25231, 25231, 25200, TRUE, -1 }, // Lome_UTM_zone_31N
+  { 25828, 25838, 25800, TRUE, CRS_ELLIPSOID_NAD83 }, // ETRS89_UTM_zone_28N to 38N
+  { 25932, 25932, 25900, FALSE, -1 }, // Malongo_1987_UTM_32S
+  { 26237, 26237, 26200, TRUE, -1 }, // Massawa_UTM_zone_37N
+  { 26331, 26332, 26300, TRUE, -1 }, // Minna_UTM_zone_31N to 32N
+  { 26432, 26432, 26400, FALSE, -1 }, // Mhast_UTM_zone_32S
+  { 26632, 26632, 26600, TRUE, -1 }, // M_poraloko_UTM_32N
+  { 26692, 26692, 26660, FALSE, -1 }, // Minna_UTM_zone_32S
+  { 26701, 26722, 26700, TRUE, CRS_ELLIPSOID_NAD27 }, // NAD27 / UTM zone 1N to 22N
+  { 26901, 26923, 26900, TRUE, CRS_ELLIPSOID_NAD83 }, // NAD83 / UTM zone 1N to 23N
+  { 28348, 28358, 28300, FALSE, CRS_ELLIPSOID_GDA94 }, // GDA94_MGA_zone_48 to 58
+  { 29118, 29122, 29100, TRUE, CRS_ELLIPSOID_SAD69 }, // SAD69_UTM_zone_18N to 22N
+  { 29177, 29185, 29160, FALSE, CRS_ELLIPSOID_SAD69 }, // SAD69_UTM_zone_17S to 25S
+  { 29220, 29221, 29200, FALSE, -1 }, // Sapper_Hill_UTM_20S to 21S
+  { 29333, 29333, 29300, FALSE, -1 }, // Schwarzeck_UTM_33S
+  { 29635, 29636, 29600, TRUE, -1 }, // Sudan_UTM_zone_35N to 36N
+  { 29738, 29739, 29700, FALSE, -1 }, // Tananarive_UTM_38S to 39S
+  { 29849, 29850, 29800, TRUE, -1 }, // Timbalai_1948_UTM_49N to 50N
+  { 30339, 30340, 30300, TRUE, -1 }, // TC_1948_UTM_zone_39N to 40N
+  { 30729, 30732, 30700, TRUE, -1 }, // Nord_Sahara_UTM_29N to 32N
+  { 31028, 31028, 31000, TRUE, -1 }, // Yoff_UTM_zone_28N
+  { 31121, 31121, 31100, TRUE, -1 }, // Zanderij_UTM_zone_21N
+  { 31965, 31976, 31954, TRUE, CRS_ELLIPSOID_NAD83 }, // SIRGAS 2000 / UTM zone 11N to 22N
+  { 31977, 31985, 31960, FALSE, CRS_ELLIPSOID_NAD83 }, // SIRGAS 2000 / UTM zone 17S to 25S
+  { 32201, 32260, 32200, TRUE, CRS_ELLIPSOID_WGS72 }, // WGS72_UTM_zone_1N to 60N
+  { 32301, 32360, 32300, FALSE, CRS_ELLIPSOID_WGS72 }, // WGS72_UTM_zone_1S to 60S
+  { 32401, 32460, 32400, TRUE, CRS_ELLIPSOID_WGS72 }, // WGS72BE_UTM_zone_1N to 60N
+  { 32501, 32560, 32500, FALSE, CRS_ELLIPSOID_WGS72 }, // WGS72BE_UTM_zone_1S to 60S
+  { 32601, 32660, 32600, TRUE, CRS_ELLIPSOID_WGS84 }, // WGS84_UTM_zone_1N to 60N
+  { 32701, 32760, 32700, FALSE, CRS_ELLIPSOID_WGS84 }, // WGS84_UTM_zone_1S to 60S
+};
+
+// deprecated EPSG codes of state plane zones whose list entry uses the current code
+
+static const U16 epsg_state_plane_alias_list[][2] =
+{
+  { 2204, 32036 }, // NAD27 / Tennessee
+  { 2205, 26979 }, // NAD83 / Kentucky North
+};
+
+// projected CRSs that are national or regional transverse mercator or lambert
+// conformal conic grids. the false easting and northing are in meter and the
+// last two numbers are the scale factor (TM) or the 1st and 2nd standard
+// parallel (LCC). sorted by EPSG code.
+
+class CRSepsgGrid
+{
+public:
+  U16 epsg;
+  I32 ellipsoid_id;
+  I32 projection;
+  U32 units;
+  F64 false_easting_meter;
+  F64 false_northing_meter;
+  F64 lat_origin_degree;
+  F64 long_meridian_degree;
+  F64 scale_factor_or_first_std_parallel;
+  F64 second_std_parallel;
+  const CHAR* description;
+};
+
+static const CRSepsgGrid epsg_grid_list[] =
+{
+  { EPSG_ETRS89_Poland_CS92, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 500000.0, -5300000.0, 0.0, 19.0, 0.9993, 0.0, "ETRS89 / Poland CS92" },
+  { EPSG_NZGD2000, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 1600000.0, 10000000.0, 0.0, 173.0, 0.9996, 0.0, "NZGD2000" },
+  { EPSG_NAD83_HARN_UTM2_South_American_Samoa, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 500000.0, 10000000.0, 0.0, -171.0, 0.9996, 0.0, "UTM zone 2S (American Samoa)" },
+  { EPSG_NAD83_HARN_Virginia_North_ftUS, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 3, 11482916.667*surveyfeet2meter, 6561666.667*surveyfeet2meter, 37.66666666666666, -78.5, 39.2, 38.03333333333333, "NAD83(HARN) / Virginia North (ftUS)" },
+  { EPSG_NAD83_HARN_Virginia_South_ftUS, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 3, 11482916.667*surveyfeet2meter, 3280833.333*surveyfeet2meter, 36.33333333333334, -78.5, 37.96666666666667, 36.76666666666667, "NAD83(HARN) / Virginia South (ftUS)" },
+  { EPSG_ETRS89_ETRS_LCC, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 4000000.0, 2800000.0, 52.0, 10.0, 35.0, 65.0, "ETRS89 / ETRS-LCC" },
+  { EPSG_ETRS89_ETRS_TM34, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 500000.0, 0.0, 0.0, 21.0, 0.9996, 0.0, "ETRS89 / ETRS-TM34" },
+  { EPSG_ETRS89_ETRS_TM35, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 500000.0, 0.0, 0.0, 27.0, 0.9996, 0.0, "ETRS89 / ETRS-TM35" },
+  { EPSG_ETRS89_ETRS_TM36, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 500000.0, 0.0, 0.0, 33.0, 0.9996, 0.0, "ETRS89 / ETRS-TM36" },
+  { EPSG_ETRS89_ETRS_TM35FIN, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 500000.0, 0.0, 0.0, 27.0, 0.9996, 0.0, "ETRS89 / ETRS-TM35FIN" },
+  { EPSG_Fiji_Map_Grid_1986, CRS_ELLIPSOID_WGS72, CRS_PROJECTION_TM, 1, 2000000.0, 4000000.0, -17.0, 178.75, 0.99985, 0.0, "Fiji 1986 / Fiji Map Grid" },
+  { EPSG_NAD83_NSRS2007_Maryland_ftUS, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 3, 1312333.333*surveyfeet2meter, 0.0, 37.66666666666666, -77.0, 39.45, 38.3, "NAD83(NSRS2007) / Maryland (ftUS)" },
+  { EPSG_Slovene_National_Grid_1996, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 500000.0, -5000000.0, 0.0, 15.0, 0.9999, 0.0, "Slovenia 1996 / Slovene National Grid" },
+  { EPSG_MGI_1901_Slovene_National_Grid, 3, CRS_PROJECTION_TM, 1, 500000.0, -5000000.0, 0.0, 15.0, 0.9999, 0.0, "MGI 1901 / Slovene National Grid" },
+  { EPSG_RGF93_CC42, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 1200000.0, 42.0, 3.0, 41.25, 42.75, "RGF93 / CC42 Reseau_Geodesique_Francais_1993" },
+  { EPSG_RGF93_CC43, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 2200000.0, 43.0, 3.0, 42.25, 43.75, "RGF93 / CC43 Reseau_Geodesique_Francais_1993" },
+  { EPSG_RGF93_CC44, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 3200000.0, 44.0, 3.0, 43.25, 44.75, "RGF93 / CC44 Reseau_Geodesique_Francais_1993" },
+  { EPSG_RGF93_CC45, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 4200000.0, 45.0, 3.0, 44.25, 45.75, "RGF93 / CC45 Reseau_Geodesique_Francais_1993" },
+  { EPSG_RGF93_CC46, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 5200000.0, 46.0, 3.0, 45.25, 46.75, "RGF93 / CC46 Reseau_Geodesique_Francais_1993" },
+  { EPSG_RGF93_CC47, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 6200000.0, 47.0, 3.0, 46.25, 47.75, "RGF93 / CC47 Reseau_Geodesique_Francais_1993" },
+  { EPSG_RGF93_CC48, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 7200000.0, 48.0, 3.0, 47.25, 48.75, "RGF93 / CC48 Reseau_Geodesique_Francais_1993" },
+  { EPSG_RGF93_CC49, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 8200000.0, 49.0, 3.0, 48.25, 49.75, "RGF93 / CC49 Reseau_Geodesique_Francais_1993" },
+  { EPSG_RGF93_CC50, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_LCC, 1, 1700000.0, 9200000.0, 50.0, 3.0, 49.25, 50.75, "RGF93 / CC50 Reseau_Geodesique_Francais_1993" },
+  { EPSG_ETRS89_DKTM1, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 200000.0, -5000000.0, 0.0, 9.0, 0.99998, 0.0, "ETRS89 / DKTM1" },
+  { EPSG_ETRS89_DKTM2, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 400000.0, -5000000.0, 0.0, 10.0, 0.99998, 0.0, "ETRS89 / DKTM2" },
+  { EPSG_ETRS89_DKTM3, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 600000.0, -5000000.0, 0.0, 11.75, 0.99998, 0.0, "ETRS89 / DKTM3" },
+  { EPSG_ETRS89_DKTM4, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 800000.0, -5000000.0, 0.0, 15.0, 0.99998, 0.0, "ETRS89 / DKTM4" },
+  { EPSG_ETRS89_UTM32_north_zE_N, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 32500000.0, 0.0, 0.0, 9.0, 0.9996, 0.0, "ETRS89 / UTM zone 32N (zE-N)" },
+  { EPSG_ETRS89_NTM_zone_5, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 5.5, 1.0, 0.0, "ETRS89 / NTM zone 5" },
+  { EPSG_ETRS89_NTM_zone_6, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 6.5, 1.0, 0.0, "ETRS89 / NTM zone 6" },
+  { EPSG_ETRS89_NTM_zone_7, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 7.5, 1.0, 0.0, "ETRS89 / NTM zone 7" },
+  { EPSG_ETRS89_NTM_zone_8, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 8.5, 1.0, 0.0, "ETRS89 / NTM zone 8" },
+  { EPSG_ETRS89_NTM_zone_9, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 9.5, 1.0, 0.0, "ETRS89 / NTM zone 9" },
+  { EPSG_ETRS89_NTM_zone_10, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 10.5, 1.0, 0.0, "ETRS89 / NTM zone 10" },
+  { EPSG_ETRS89_NTM_zone_11, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 11.5, 1.0, 0.0, "ETRS89 / NTM zone 11" },
+  { EPSG_ETRS89_NTM_zone_12, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 12.5, 1.0, 0.0, "ETRS89 / NTM zone 12" },
+  { EPSG_ETRS89_NTM_zone_13, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 13.5, 1.0, 0.0, "ETRS89 / NTM zone 13" },
+  { EPSG_ETRS89_NTM_zone_14, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 14.5, 1.0, 0.0, "ETRS89 / NTM zone 14" },
+  { EPSG_ETRS89_NTM_zone_15, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 15.5, 1.0, 0.0, "ETRS89 / NTM zone 15" },
+  { EPSG_ETRS89_NTM_zone_16, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 16.5, 1.0, 0.0, "ETRS89 / NTM zone 16" },
+  { EPSG_ETRS89_NTM_zone_17, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 17.5, 1.0, 0.0, "ETRS89 / NTM zone 17" },
+  { EPSG_ETRS89_NTM_zone_18, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 18.5, 1.0, 0.0, "ETRS89 / NTM zone 18" },
+  { EPSG_ETRS89_NTM_zone_19, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 19.5, 1.0, 0.0, "ETRS89 / NTM zone 19" },
+  { EPSG_ETRS89_NTM_zone_20, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 20.5, 1.0, 0.0, "ETRS89 / NTM zone 20" },
+  { EPSG_ETRS89_NTM_zone_21, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 21.5, 1.0, 0.0, "ETRS89 / NTM zone 21" },
+  { EPSG_ETRS89_NTM_zone_22, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 22.5, 1.0, 0.0, "ETRS89 / NTM zone 22" },
+  { EPSG_ETRS89_NTM_zone_23, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 23.5, 1.0, 0.0, "ETRS89 / NTM zone 23" },
+  { EPSG_ETRS89_NTM_zone_24, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 24.5, 1.0, 0.0, "ETRS89 / NTM zone 24" },
+  { EPSG_ETRS89_NTM_zone_25, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 25.5, 1.0, 0.0, "ETRS89 / NTM zone 25" },
+  { EPSG_ETRS89_NTM_zone_26, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 26.5, 1.0, 0.0, "ETRS89 / NTM zone 26" },
+  { EPSG_ETRS89_NTM_zone_27, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 27.5, 1.0, 0.0, "ETRS89 / NTM zone 27" },
+  { EPSG_ETRS89_NTM_zone_28, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 28.5, 1.0, 0.0, "ETRS89 / NTM zone 28" },
+  { EPSG_ETRS89_NTM_zone_29, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 29.5, 1.0, 0.0, "ETRS89 / NTM zone 29" },
+  { EPSG_ETRS89_NTM_zone_30, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 100000.0, 1000000.0, 58.0, 30.5, 1.0, 0.0, "ETRS89 / NTM zone 30" },
+  { EPSG_ETRS89_UTM33_north_zE_N, CRS_ELLIPSOID_NAD83, CRS_PROJECTION_TM, 1, 33500000.0, 0.0, 0.0, 15.0, 0.9996, 0.0, "ETRS89 / UTM zone 33N (zE-N)" },
+  { EPSG_OSGB_1936, 1, CRS_PROJECTION_TM, 1, 400000.0, -100000.0, 49.0, -2.0, 0.9996012717, 0.0, "OSGB 1936 / British National Grid" },
+  { EPSG_Belgian_Lambert_1972, CRS_ELLIPSOID_Inter, CRS_PROJECTION_LCC, 1, 150000.013, 5400088.438, 90.0, 4.367486666666666, 51.16666723333333, 49.8333339, "Belge 1972 / Belgian Lambert 72" },
+};
+
+BOOL CRScheck::set_projection_from_ProjectedCSTypeGeoKey(const U16 value, CHAR* description)
+{
+  I32 low, high, mid;
+
+  // is it a UTM zone
+
+  low = 0;
+  high = sizeof(epsg_utm_list)/sizeof(CRSepsgUTM) - 1;
+  while (low <= high)
   {
-    set_ellipsoid(3, TRUE); // Bessel 1841
-    set_transverse_mercator_projection(500000.0, -5000000.0, 0.0, 15.0, 0.9999, 0); // "MGI 1901 / Slovene National Grid"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "MGI 1901 / Slovene National Grid");
-    return TRUE;    
+    mid = (low + high) / 2;
+    if (epsg_utm_list[mid].last < value) low = mid + 1;
+    else if (epsg_utm_list[mid].first > value) high = mid - 1;
+    else
+    {
+      const CRSepsgUTM* utm = &epsg_utm_list[mid];
+      set_ellipsoid((utm->ellipsoid_id == -1 ? CRS_ELLIPSOID_WGS84 : utm->ellipsoid_id), TRUE);
+      if (!set_utm_projection(value - utm->offset, utm->northern, TRUE, description))
+      {
+        return FALSE;
+      }
+      if (utm->description)
+      {
+        set_coordinates_in_meter(TRUE);
+        if (description) sprintf(description, "%s", utm->description);
+      }
+      return TRUE;
+    }
   }
-  else if ((EPSG_RGF93_CC42 <= value) && (value <= EPSG_RGF93_CC50))
+
+  // is it a state plane zone
+
+  U16 epsg = value;
+  for (mid = 0; mid < (I32)(sizeof(epsg_state_plane_alias_list)/sizeof(epsg_state_plane_alias_list[0])); mid++)
   {
-    int v = value - EPSG_RGF93_CC42;
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_lambert_conformal_conic_projection(1700000.0, 1200000.0+v*1000000, 42.0+v, 3.0, 41.25+v, 42.75+v, 0);
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "RGF93 / CC%d Reseau_Geodesique_Francais_1993", value-3900);
-    return TRUE;
+    if (epsg_state_plane_alias_list[mid][1] == value) epsg = epsg_state_plane_alias_list[mid][0];
   }
-  else if ((EPSG_ETRS89_DKTM1 <= value) && (value <= EPSG_ETRS89_DKTM4))
+  if (set_state_plane_nad27_lcc(epsg, TRUE, description))
   {
-    int v = ((value - EPSG_ETRS89_DKTM1)%4) + 1;
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(200000.0*v, -5000000.0, 0.0, 9.0 + (v == 1 ? 0.0 : (v == 2 ? 1.0 : (v == 3 ? 2.75 : 6.0))), 0.99998, 0);
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / DKTM%d", v);
     return TRUE;
   }
-  else if (value == EPSG_ETRS89_UTM32_north_zE_N)
+  if (set_state_plane_nad27_tm(epsg, TRUE, description))
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(32500000.0, 0.0, 0.0, 9.0, 0.9996, 0); // "ETRS89 / UTM zone 32N (zE-N)"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / UTM zone 32N (zE-N)");
     return TRUE;
   }
-  else if ((EPSG_ETRS89_NTM_zone_5 <= value) && (value <= EPSG_ETRS89_NTM_zone_30))
+  if (set_state_plane_nad83_lcc(epsg, TRUE, description))
   {
-    int v = value - 5100;
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(100000.0, 1000000.0, 58.0, 0.3+v, 1.0, 0);
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / NTM zone %d", v);
     return TRUE;
   }
-  else if (value == EPSG_ETRS89_UTM33_north_zE_N)
+  if (set_state_plane_nad83_tm(epsg, TRUE, description))
   {
-    set_ellipsoid(CRS_ELLIPSOID_NAD83, TRUE); // GRS 1980
-    set_transverse_mercator_projection(33500000.0, 0.0, 0.0, 15.0, 0.9996, 0); // "ETRS89 / UTM zone 33N (zE-N)"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "ETRS89 / UTM zone 33N (zE-N)");
     return TRUE;
   }
-  else if (value == EPSG_OSGB_1936)
-  {
-    set_ellipsoid(1, TRUE); // Airy 1830
-    set_transverse_mercator_projection(400000.0, -100000.0, 49.0, -2.0, 0.9996012717, 0); // "OSGB 1936 / British National Grid"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "OSGB 1936 / British National Grid");
-    return TRUE;
-  } 
-  else if (value == EPSG_Belgian_Lambert_1972)
+
+  // is it a national or regional grid
+
+  low = 0;
+  high = sizeof(epsg_grid_list)/sizeof(CRSepsgGrid) - 1;
+  while (low <= high)
   {
-    set_ellipsoid(CRS_ELLIPSOID_Inter, TRUE);
-    set_lambert_conformal_conic_projection(150000.013, 5400088.438, 90, 4.367486666666666, 51.16666723333333, 49.8333339, 0); // "Belge 1972 / Belgian Lambert 72"
-    set_coordinates_in_meter(TRUE);
-    if (description) sprintf(description, "Belge 1972 / Belgian Lambert 72");
-    return TRUE;
+    mid = (low + high) / 2;
+    if (epsg_grid_list[mid].epsg < value) low = mid + 1;
+    else if (epsg_grid_list[mid].epsg > value) high = mid - 1;
+    else
+    {
+      const CRSepsgGrid* grid = &epsg_grid_list[mid];
+      set_ellipsoid(grid->ellipsoid_id, TRUE);
+      if (grid->projection == CRS_PROJECTION_TM)
+      {
+        set_transverse_mercator_projection(grid->false_easting_meter, grid->false_northing_meter, grid->lat_origin_degree, grid->long_meridian_degree, grid->scale_factor_or_first_std_parallel, TRUE);
+      }
+      else
+      {
+        set_lambert_conformal_conic_projection(grid->false_easting_meter, grid->false_northing_meter, grid->lat_origin_degree, grid->long_meridian_degree, grid->scale_factor_or_first_std_parallel, grid->second_std_parallel, TRUE);
+      }
+      if (grid->units == 3)
+      {
+        set_coordinates_in_survey_feet(TRUE);
+      }
+      else if (grid->units == 2)
+      {
+        set_coordinates_in_feet(TRUE);
+      }
+      else
+      {
+        set_coordinates_in_meter(TRUE);
+      }
+      if (description) sprintf(description, "%s", grid->description);
+      return TRUE;
+    }
   }
+
   fprintf(stderr, "CRScheck::set_projection_from_ProjectedCSTypeGeoKey: %d not implemented\n", value);
   return FALSE;
 }
@@ -3091,7 +2455,10 @@ BOOL CRScheck::check_geokeys(LASheader* lasheader, CHAR* description)
       break;
     case 3072: // ProjectedCSTypeGeoKey
       if (geokey_entries[i].value_offset != 32767)
+      {
+        horizontal_epsg[0] = geokey_entries[i].value_offset;
         has_projection = set_projection_from_ProjectedCSTypeGeoKey(geokey_entries[i].value_offset, description);
+      }
       break;
     case 3075: // ProjCoordTransGeoKey
       user_defined_projection = 0;
@@ -3209,101 +2576,1080 @@ BOOL CRScheck::check_geokeys(LASheader* lasheader, CHAR* description)
     case 4096: // VerticalCSTypeGeoKey 
       set_vertical_from_VerticalCSTypeGeoKey(geokey_entries[i].value_offset);
       break;
-    case 4099: // VerticalUnitsGeoKey
-      set_elevation_from_VerticalUnitsGeoKey(geokey_entries[i].value_offset);
+    case 4099: // VerticalUnitsGeoKey
+      set_elevation_from_VerticalUnitsGeoKey(geokey_entries[i].value_offset);
+      break;
+    }
+  }
+
+  if (ellipsoid != -1)
+  {
+    set_ellipsoid(ellipsoid, TRUE);
+  }
+
+  if (!has_projection)
+  {
+    // the false easting and northing are in the linear unit of the projection
+
+    F64 meter_per_unit = (coordinate_units[0] == 3 ? surveyfeet2meter : (coordinate_units[0] == 2 ? feet2meter : 1.0));
+
+    if (user_defined_projection == 1)
+    {
+      if ((offsetProjFalseEastingGeoKey >= 0) &&
+          (offsetProjFalseNorthingGeoKey >= 0) &&
+          (offsetProjNatOriginLatGeoKey >= 0) &&
+          (offsetProjCenterLongGeoKey >= 0) &&
+          (offsetProjScaleAtNatOriginGeoKey >= 0))
+      {
+        F64 falseEasting = meter_per_unit*geokey_double_params[offsetProjFalseEastingGeoKey];
+        F64 falseNorthing = meter_per_unit*geokey_double_params[offsetProjFalseNorthingGeoKey];
+        F64 latOriginDeg = geokey_double_params[offsetProjNatOriginLatGeoKey];
+        F64 longMeridianDeg = geokey_double_params[offsetProjCenterLongGeoKey];
+        F64 scaleFactor = geokey_double_params[offsetProjScaleAtNatOriginGeoKey];
+        set_transverse_mercator_projection(falseEasting, falseNorthing, latOriginDeg, longMeridianDeg, scaleFactor, TRUE, description);
+        if (description)
+        {
+          sprintf(description, "generic transverse mercator");
+        }
+        has_projection = TRUE;
+      }
+    }
+    else if (user_defined_projection == 8)
+    {
+      if ((offsetProjFalseEastingGeoKey >= 0) &&
+          (offsetProjFalseNorthingGeoKey >= 0) &&
+          (offsetProjNatOriginLatGeoKey >= 0) &&
+          (offsetProjCenterLongGeoKey >= 0) &&
+          (offsetProjStdParallel1GeoKey >= 0) &&
+          (offsetProjStdParallel2GeoKey >= 0))
+      {
+        F64 falseEasting = meter_per_unit*geokey_double_params[offsetProjFalseEastingGeoKey];
+        F64 falseNorthing = meter_per_unit*geokey_double_params[offsetProjFalseNorthingGeoKey];
+        F64 latOriginDeg = geokey_double_params[offsetProjNatOriginLatGeoKey];
+        F64 longOriginDeg = geokey_double_params[offsetProjCenterLongGeoKey];
+        F64 firstStdParallelDeg = geokey_double_params[offsetProjStdParallel1GeoKey];
+        F64 secondStdParallelDeg = geokey_double_params[offsetProjStdParallel2GeoKey];
+        set_lambert_conformal_conic_projection(falseEasting, falseNorthing, latOriginDeg, longOriginDeg, firstStdParallelDeg, secondStdParallelDeg, TRUE, description);
+        if (description)
+        {
+          sprintf(description, "generic lambert conformal conic");
+        }
+        has_projection = TRUE;
+      }
+    }
+  }
+  return has_projection;
+}
+
+BOOL CRScheck::set_projection_from_wkt(LASheader* lasheader, const CRSwkt* wkt, const I32 crs, CHAR* description)
+{
+  CHAR note[512];
+  I32 i, unit, length;
+  const CHAR* text;
+  BOOL projected = wkt->is(crs, CRS_WKT_PROJECTED);
+
+  // the datum with its ellipsoid lives in the (base) geographic CRS
+
+  I32 geographic = (projected ? wkt->find(crs, CRS_WKT_GEOGRAPHIC) : crs);
+  if (geographic == -1)
+  {
+    sprintf(note, "OGC WKT of the projected CRS does not specify its geographic CRS");
+    lasheader->add_fail("CRS", note);
+    return FALSE;
+  }
+
+  I32 datum = wkt->find(geographic, "DATUM|GEODETICDATUM|TRF|ENSEMBLE|DATUMENSEMBLE");
+  I32 ellipsoid = (datum == -1 ? -1 : wkt->find(datum, "SPHEROID|ELLIPSOID"));
+  if (ellipsoid == -1)
+  {
+    sprintf(note, "OGC WKT does not specify the ellipsoid of the datum");
+    lasheader->add_fail("CRS", note);
+  }
+  else
+  {
+    F64 equatorial_radius = wkt->get_number(ellipsoid, 1, 0.0);
+    unit = wkt->find(ellipsoid, "LENGTHUNIT|UNIT");
+    if (unit != -1) equatorial_radius *= wkt->get_number(unit, 1, 1.0);
+    if (!set_ellipsoid(equatorial_radius, wkt->get_number(ellipsoid, 2, 0.0), FALSE))
+    {
+      sprintf(note, "OGC WKT specifies an ellipsoid with an invalid equatorial radius of %g", equatorial_radius);
+      lasheader->add_fail("CRS", note);
+    }
+  }
+
+  if (!projected)
+  {
+    return set_longlat_projection(FALSE, description);
+  }
+
+  horizontal_epsg[1] = wkt->get_epsg_code(crs);
+
+  F64 radian_per_unit = deg2rad;
+  unit = wkt->find(geographic, "ANGLEUNIT|UNIT");
+  if (unit != -1) radian_per_unit = wkt->get_number(unit, 1, deg2rad);
+
+  // the unit of the projected coordinates follows the parameters (WKT1) or is part of the axes (WKT2)
+
+  F64 meter_per_unit = 1.0;
+  unit = wkt->find(crs, "LENGTHUNIT|UNIT");
+  if (unit == -1)
+  {
+    I32 axis = wkt->find(crs, "AXIS");
+    if (axis != -1) unit = wkt->find(axis, "LENGTHUNIT|UNIT");
+  }
+  if (unit == -1)
+  {
+    sprintf(note, "OGC WKT does not specify the unit of the projected coordinates");
+    lasheader->add_warning("CRS", note);
+  }
+  else
+  {
+    meter_per_unit = wkt->get_number(unit, 1, 1.0);
+    coordinate_units[1] = get_unit_code(meter_per_unit);
+    if (coordinate_units[1] == 0)
+    {
+      sprintf(note, "OGC WKT uses a linear unit of %g meter that is neither meter nor feet nor survey feet", meter_per_unit);
+      lasheader->add_warning("CRS", note);
+    }
+  }
+
+  // the projection method and its parameters are children of the CRS (WKT1) or of its conversion (WKT2)
+
+  I32 parameters = crs;
+  I32 method = wkt->find(crs, "PROJECTION");
+  if (method == -1)
+  {
+    parameters = wkt->find(crs, "CONVERSION|DERIVINGCONVERSION");
+    method = (parameters == -1 ? -1 : wkt->find(parameters, "METHOD|PROJECTION"));
+  }
+  I32 method_name = (method == -1 ? -1 : wkt->get_value(method, 0));
+  if (method_name == -1)
+  {
+    sprintf(note, "OGC WKT of the projected CRS does not specify a projection method");
+    lasheader->add_fail("CRS", note);
+    return FALSE;
+  }
+
+  // collect the parameters in meter and degree
+
+  F64 values[CRS_PARAMETER_NUMBER];
+  BOOL has[CRS_PARAMETER_NUMBER];
+  for (i = 0; i < CRS_PARAMETER_NUMBER; i++)
+  {
+    values[i] = 0.0;
+    has[i] = FALSE;
+  }
+  values[CRS_PARAMETER_SCALE_FACTOR] = 1.0;
+
+  I32 parameter;
+  for (parameter = wkt->find(parameters, "PARAMETER"); parameter != -1; parameter = wkt->find_next(parameter, "PARAMETER"))
+  {
+    I32 name = wkt->get_value(parameter, 0);
+    if (name == -1) continue;
+    for (i = 0; i < CRS_PARAMETER_NUMBER; i++)
+    {
+      if (wkt->is(name, crs_wkt_parameter_names[i])) break;
+    }
+    if (i == CRS_PARAMETER_NUMBER) continue;
+    F64 value = wkt->get_number(parameter, 1, 0.0);
+    unit = wkt->find(parameter, "LENGTHUNIT|ANGLEUNIT|SCALEUNIT|UNIT");
+    if ((i == CRS_PARAMETER_FALSE_EASTING) || (i == CRS_PARAMETER_FALSE_NORTHING))
+    {
+      value *= (unit == -1 ? meter_per_unit : wkt->get_number(unit, 1, 1.0));
+    }
+    else if (i == CRS_PARAMETER_SCALE_FACTOR)
+    {
+      value *= (unit == -1 ? 1.0 : wkt->get_number(unit, 1, 1.0));
+    }
+    else
+    {
+      value *= (unit == -1 ? radian_per_unit : wkt->get_number(unit, 1, deg2rad)) * rad2deg;
+    }
+    values[i] = value;
+    has[i] = TRUE;
+  }
+
+  U32 method_code = wkt->get_epsg_code(method);
+  if ((method_code == 9807) || wkt->is(method_name, "Transverse_Mercator|Gauss_Kruger"))
+  {
+    if (!has[CRS_PARAMETER_LONG_MERIDIAN])
+    {
+      sprintf(note, "OGC WKT of the transverse mercator projection does not specify the central meridian");
+      lasheader->add_fail("CRS", note);
+      return FALSE;
+    }
+
+    // maybe it is a UTM zone
+
+    F64 zone = (values[CRS_PARAMETER_LONG_MERIDIAN] + 183.0) / 6.0;
+    I32 zone_number = I32_QUANTIZE(zone);
+    if ((fabs(zone - zone_number) < 1e-6) && (zone_number >= 1) && (zone_number <= 60) &&
+        (fabs(values[CRS_PARAMETER_SCALE_FACTOR] - 0.9996) < 1e-9) &&
+        (fabs(values[CRS_PARAMETER_FALSE_EASTING] - 500000.0) < 0.001) &&
+        (fabs(values[CRS_PARAMETER_LAT_ORIGIN]) < 1e-9) &&
+        ((fabs(values[CRS_PARAMETER_FALSE_NORTHING]) < 0.001) || (fabs(values[CRS_PARAMETER_FALSE_NORTHING] - 10000000.0) < 0.001)))
+    {
+      return set_utm_projection(zone_number, (fabs(values[CRS_PARAMETER_FALSE_NORTHING]) < 0.001), FALSE, description);
+    }
+    set_transverse_mercator_projection(values[CRS_PARAMETER_FALSE_EASTING], values[CRS_PARAMETER_FALSE_NORTHING], values[CRS_PARAMETER_LAT_ORIGIN], values[CRS_PARAMETER_LONG_MERIDIAN], values[CRS_PARAMETER_SCALE_FACTOR], FALSE, description);
+    return TRUE;
+  }
+  else if ((method_code == 9802) || wkt->is(method_name, "Lambert_Conformal_Conic_2SP|Lambert Conic Conformal (2SP)|Lambert_Conformal_Conic"))
+  {
+    if (!has[CRS_PARAMETER_LONG_MERIDIAN] || !has[CRS_PARAMETER_FIRST_STD_PARALLEL])
+    {
+      sprintf(note, "OGC WKT of the lambert conformal conic projection does not specify the central meridian and the standard parallels");
+      lasheader->add_fail("CRS", note);
+      return FALSE;
+    }
+
+    // the ESRI flavor may have only one standard parallel
+
+    if (!has[CRS_PARAMETER_SECOND_STD_PARALLEL])
+    {
+      values[CRS_PARAMETER_SECOND_STD_PARALLEL] = values[CRS_PARAMETER_FIRST_STD_PARALLEL];
+    }
+    set_lambert_conformal_conic_projection(values[CRS_PARAMETER_FALSE_EASTING], values[CRS_PARAMETER_FALSE_NORTHING], values[CRS_PARAMETER_LAT_ORIGIN], values[CRS_PARAMETER_LONG_MERIDIAN], values[CRS_PARAMETER_FIRST_STD_PARALLEL], values[CRS_PARAMETER_SECOND_STD_PARALLEL], FALSE, description);
+    return TRUE;
+  }
+  else if (((method_code == 9801) || wkt->is(method_name, "Lambert_Conformal_Conic_1SP|Lambert Conic Conformal (1SP)")) && (fabs(values[CRS_PARAMETER_SCALE_FACTOR] - 1.0) < 1e-9))
+  {
+    // with a scale factor of one the latitude of origin is the standard parallel
+
+    set_lambert_conformal_conic_projection(values[CRS_PARAMETER_FALSE_EASTING], values[CRS_PARAMETER_FALSE_NORTHING], values[CRS_PARAMETER_LAT_ORIGIN], values[CRS_PARAMETER_LONG_MERIDIAN], values[CRS_PARAMETER_LAT_ORIGIN], values[CRS_PARAMETER_LAT_ORIGIN], FALSE, description);
+    return TRUE;
+  }
+
+  text = wkt->get_text(method_name, &length);
+  sprintf(note, "OGC WKT uses projection method '%.*s' whose check is not yet implemented", (length > 64 ? 64 : length), text);
+  lasheader->add_warning("CRS", note);
+  return FALSE;
+}
+
+BOOL CRScheck::check_wkt(LASheader* lasheader, CHAR* description)
+{
+  CHAR note[512];
+  I32 length;
+  const CHAR* text;
+  CRSwkt wkt;
+
+  if (!wkt.parse(lasheader->ogc_wkt))
+  {
+    sprintf(note, "OGC WKT string is not well formed (%s at character %u)", wkt.error, wkt.error_offset);
+    lasheader->add_fail("CRS", note);
+    return FALSE;
+  }
+
+  // a bound CRS wraps the CRS of the coordinates together with a transformation
+
+  I32 crs = wkt.root;
+  if (wkt.is(crs, "BOUNDCRS"))
+  {
+    I32 source = wkt.find(crs, "SOURCECRS");
+    crs = (source == -1 ? -1 : wkt.find(source, CRS_WKT_PROJECTED "|" CRS_WKT_GEOGRAPHIC "|" CRS_WKT_VERTICAL "|COMPD_CS|COMPOUNDCRS"));
+    if (crs == -1)
+    {
+      sprintf(note, "OGC WKT of the bound CRS does not specify a source CRS");
+      lasheader->add_fail("CRS", note);
+      return FALSE;
+    }
+  }
+
+  // a compound CRS has a horizontal and a vertical part
+
+  I32 horizontal = -1;
+  I32 vertical = -1;
+  if (wkt.is(crs, "COMPD_CS|COMPOUNDCRS"))
+  {
+    horizontal = wkt.find(crs, CRS_WKT_PROJECTED "|" CRS_WKT_GEOGRAPHIC);
+    vertical = wkt.find(crs, CRS_WKT_VERTICAL);
+  }
+  else if (wkt.is(crs, CRS_WKT_VERTICAL))
+  {
+    vertical = crs;
+  }
+  else if (wkt.is(crs, CRS_WKT_PROJECTED "|" CRS_WKT_GEOGRAPHIC))
+  {
+    horizontal = crs;
+  }
+
+  if (vertical != -1)
+  {
+    vertical_epsg[1] = wkt.get_epsg_code(vertical);
+    I32 unit = wkt.find(vertical, "LENGTHUNIT|UNIT");
+    if (unit == -1)
+    {
+      I32 axis = wkt.find(vertical, "AXIS");
+      if (axis != -1) unit = wkt.find(axis, "LENGTHUNIT|UNIT");
+    }
+    if (unit != -1)
+    {
+      elevation_units[1] = get_unit_code(wkt.get_number(unit, 1, 1.0));
+    }
+  }
+
+  if (horizontal == -1)
+  {
+    text = wkt.get_text(crs, &length);
+    sprintf(note, "OGC WKT of type %.*s does not specify a horizontal CRS", (length > 32 ? 32 : length), text);
+    lasheader->add_fail("CRS", note);
+    return FALSE;
+  }
+
+  if (!set_projection_from_wkt(lasheader, &wkt, horizontal, description))
+  {
+    return FALSE;
+  }
+
+  // the name of the (compound) CRS describes it best
+
+  if (description)
+  {
+    I32 name = wkt.get_value(crs, 0);
+    if (name != -1)
+    {
+      text = wkt.get_text(name, &length);
+      sprintf(description, "%.*s", (length > 256 ? 256 : length), text);
+    }
+  }
+  return TRUE;
+}
+
+void CRScheck::check_consistency(LASheader* lasheader)
+{
+  CHAR note[512];
+  static const CHAR* const unit_names[4] = { "unknown units", "meter", "feet", "survey feet" };
+  static const CHAR* const projection_names[5] = { "UTM", "lambert conformal conic", "transverse mercator", "geographic", "geographic" };
+
+  if (horizontal_epsg[0] && horizontal_epsg[1] && (horizontal_epsg[0] != horizontal_epsg[1]))
+  {
+    sprintf(note, "GeoTIFF tags specify EPSG code %u but OGC WKT specifies EPSG code %u", horizontal_epsg[0], horizontal_epsg[1]);
+    lasheader->add_warning("CRS", note);
+  }
+
+  if (coordinate_units[0] && coordinate_units[1] && (coordinate_units[0] != coordinate_units[1]))
+  {
+    sprintf(note, "GeoTIFF tags specify coordinates in %s but OGC WKT in %s", unit_names[coordinate_units[0]], unit_names[coordinate_units[1]]);
+    lasheader->add_warning("CRS", note);
+  }
+
+  if (elevation_units[0] && elevation_units[1] && (elevation_units[0] != elevation_units[1]))
+  {
+    sprintf(note, "GeoTIFF tags specify elevations in %s but OGC WKT in %s", unit_names[elevation_units[0]], unit_names[elevation_units[1]]);
+    lasheader->add_warning("CRS", note);
+  }
+
+  if (vertical_epsg[0] && vertical_epsg[1] && (vertical_epsg[0] != vertical_epsg[1]))
+  {
+    sprintf(note, "GeoTIFF tags specify vertical EPSG code %u but OGC WKT specifies vertical EPSG code %u", vertical_epsg[0], vertical_epsg[1]);
+    lasheader->add_warning("CRS", note);
+  }
+
+  if (ellipsoids[0] && ellipsoids[1])
+  {
+    if ((fabs(ellipsoids[0]->equatorial_radius - ellipsoids[1]->equatorial_radius) > 0.5) || (fabs(ellipsoids[0]->eccentricity_squared - ellipsoids[1]->eccentricity_squared) > 1e-8))
+    {
+      sprintf(note, "GeoTIFF tags specify ellipsoid '%s' but OGC WKT specifies ellipsoid '%s'", ellipsoids[0]->name, ellipsoids[1]->name);
+      lasheader->add_warning("CRS", note);
+    }
+  }
+
+  if (projections[0] && projections[1])
+  {
+    F64 parameters[2][CRS_PARAMETER_NUMBER];
+    I32 type0 = get_projection_parameters(projections[0], parameters[0]);
+    I32 type1 = get_projection_parameters(projections[1], parameters[1]);
+    if (type0 != type1)
+    {
+      sprintf(note, "GeoTIFF tags specify a %s projection but OGC WKT a %s projection", projection_names[type0], projection_names[type1]);
+      lasheader->add_warning("CRS", note);
+    }
+    else
+    {
+      for (I32 i = 0; i < CRS_PARAMETER_NUMBER; i++)
+      {
+        if (fabs(parameters[0][i] - parameters[1][i]) > crs_parameter_tolerances[i])
+        {
+          sprintf(note, "GeoTIFF tags and OGC WKT disagree on the %s of the %s projection (%g versus %g)", crs_parameter_descriptions[i], projection_names[type0], parameters[0][i], parameters[1][i]);
+          lasheader->add_warning("CRS", note);
+        }
+      }
+    }
+  }
+}
+
+// the coefficients of the meridian arc in a series of the third flattening
+
+static void compute_tm_parameters(CRSprojectionParametersTM* tm, const CRSprojectionEllipsoid* ellipsoid)
+{
+  F64 a = ellipsoid->equatorial_radius;
+  F64 tn = (ellipsoid->equatorial_radius - ellipsoid->polar_radius) / (ellipsoid->equatorial_radius + ellipsoid->polar_radius);
+  F64 tn2 = tn * tn;
+  F64 tn3 = tn2 * tn;
+  F64 tn4 = tn3 * tn;
+  F64 tn5 = tn4 * tn;
+
+  tm->tm_ap = a * (1.0 - tn + 5.0 * (tn2 - tn3) / 4.0 + 81.0 * (tn4 - tn5) / 64.0);
+  tm->tm_bp = 3.0 * a * (tn - tn2 + 7.0 * (tn3 - tn4) / 8.0 + 55.0 * tn5 / 64.0) / 2.0;
+  tm->tm_cp = 15.0 * a * (tn2 - tn3 + 3.0 * (tn4 - tn5) / 4.0) / 16.0;
+  tm->tm_dp = 35.0 * a * (tn3 - tn4 + 11.0 * tn5 / 16.0) / 48.0;
+  tm->tm_ep = 315.0 * a * (tn4 - tn5) / 512.0;
+}
+
+static F64 compute_lcc_t(const F64 lat, const F64 e)
+{
+  F64 e_sin = e * sin(lat);
+  return tan(PI_OVER_4 - lat / 2.0) / pow((1.0 - e_sin) / (1.0 + e_sin), e / 2.0);
+}
+
+static F64 compute_lcc_m(const F64 lat, const F64 e2)
+{
+  F64 sin_lat = sin(lat);
+  return cos(lat) / sqrt(1.0 - e2 * sin_lat * sin_lat);
+}
+
+static void compute_lcc_parameters(CRSprojectionParametersLCC* lcc, const CRSprojectionEllipsoid* ellipsoid)
+{
+  F64 e = ellipsoid->eccentricity;
+  F64 e2 = ellipsoid->eccentricity_squared;
+  F64 m1 = compute_lcc_m(lcc->lcc_first_std_parallel_radian, e2);
+  F64 m2 = compute_lcc_m(lcc->lcc_second_std_parallel_radian, e2);
+  F64 t0 = compute_lcc_t(lcc->lcc_lat_origin_radian, e);
+  F64 t1 = compute_lcc_t(lcc->lcc_first_std_parallel_radian, e);
+  F64 t2 = compute_lcc_t(lcc->lcc_second_std_parallel_radian, e);
+
+  // with one standard parallel the cone touches instead of cutting
+
+  if (fabs(lcc->lcc_first_std_parallel_radian - lcc->lcc_second_std_parallel_radian) > 1e-10)
+  {
+    lcc->lcc_n = (log(m1) - log(m2)) / (log(t1) - log(t2));
+  }
+  else
+  {
+    lcc->lcc_n = sin(lcc->lcc_first_std_parallel_radian);
+  }
+  lcc->lcc_aF = ellipsoid->equatorial_radius * m1 / (lcc->lcc_n * pow(t1, lcc->lcc_n));
+  lcc->lcc_rho0 = lcc->lcc_aF * pow(t0, lcc->lcc_n);
+}
+
+static void compute_utm_parameters(const CRSprojectionParametersUTM* utm, const CRSprojectionEllipsoid* ellipsoid, CRSprojectionParametersTM* tm)
+{
+  tm->type = CRS_PROJECTION_TM;
+  tm->tm_false_easting_meter = 500000.0;
+  tm->tm_false_northing_meter = (utm->utm_northern_hemisphere ? 0.0 : 10000000.0);
+  tm->tm_lat_origin_degree = 0.0;
+  tm->tm_long_meridian_degree = utm->utm_long_origin;
+  tm->tm_scale_factor = 0.9996;
+  tm->tm_lat_origin_radian = 0.0;
+  tm->tm_long_meridian_radian = deg2rad*utm->utm_long_origin;
+  compute_tm_parameters(tm, ellipsoid);
+}
+
+static F64 compute_tm_arc(const CRSprojectionParametersTM* tm, const F64 lat)
+{
+  return tm->tm_ap * lat - tm->tm_bp * sin(2.0 * lat) + tm->tm_cp * sin(4.0 * lat) - tm->tm_dp * sin(6.0 * lat) + tm->tm_ep * sin(8.0 * lat);
+}
+
+// inverse transverse mercator (Snyder, Map Projections - A Working Manual, p. 63)
+// that returns FALSE for northings beyond the poles
+
+static BOOL inverse_tm(const CRSprojectionParametersTM* tm, const CRSprojectionEllipsoid* ellipsoid, const F64 x, const F64 y, F64* lat, F64* lon)
+{
+  F64 e2 = ellipsoid->eccentricity_squared;
+  F64 ep2 = ellipsoid->eccentricity_prime_squared;
+
+  // find the footpoint latitude on the meridian arc
+
+  F64 arc = compute_tm_arc(tm, tm->tm_lat_origin_radian) + (y - tm->tm_false_northing_meter) / tm->tm_scale_factor;
+  if (fabs(arc) > compute_tm_arc(tm, PI_OVER_2))
+  {
+    return FALSE;
+  }
+  F64 lat1 = arc / tm->tm_ap;
+  for (I32 i = 0; i < 8; i++)
+  {
+    lat1 += (arc - compute_tm_arc(tm, lat1)) / tm->tm_ap;
+  }
+
+  F64 sin_lat1 = sin(lat1);
+  F64 cos_lat1 = cos(lat1);
+  F64 tan_lat1 = sin_lat1 / cos_lat1;
+  F64 C1 = ep2 * cos_lat1 * cos_lat1;
+  F64 T1 = tan_lat1 * tan_lat1;
+  F64 w = 1.0 - e2 * sin_lat1 * sin_lat1;
+  F64 N1 = ellipsoid->equatorial_radius / sqrt(w);
+  F64 R1 = ellipsoid->equatorial_radius * (1.0 - e2) / (w * sqrt(w));
+  F64 D = (x - tm->tm_false_easting_meter) / (N1 * tm->tm_scale_factor);
+  F64 D2 = D * D;
+
+  *lat = lat1 - (N1 * tan_lat1 / R1) * D2 * (0.5 - D2 * ((5.0 + 3.0 * T1 + 10.0 * C1 - 4.0 * C1 * C1 - 9.0 * ep2) / 24.0 - D2 * (61.0 + 90.0 * T1 + 298.0 * C1 + 45.0 * T1 * T1 - 252.0 * ep2 - 3.0 * C1 * C1) / 720.0));
+  *lon = tm->tm_long_meridian_radian + D * (1.0 - D2 * ((1.0 + 2.0 * T1 + C1) / 6.0 - D2 * (5.0 - 2.0 * C1 + 28.0 * T1 - 3.0 * C1 * C1 + 8.0 * ep2 + 24.0 * T1 * T1) / 120.0)) / cos_lat1;
+  *lat *= rad2deg;
+  *lon *= rad2deg;
+  return TRUE;
+}
+
+// inverse lambert conformal conic (Snyder, Map Projections - A Working Manual, p. 107)
+
+static BOOL inverse_lcc(const CRSprojectionParametersLCC* lcc, const CRSprojectionEllipsoid* ellipsoid, const F64 x, const F64 y, F64* lat, F64* lon)
+{
+  F64 e = ellipsoid->eccentricity;
+  F64 dx = x - lcc->lcc_false_easting_meter;
+  F64 dy = lcc->lcc_rho0 - (y - lcc->lcc_false_northing_meter);
+  F64 rho = sqrt(dx * dx + dy * dy);
+  F64 theta;
+  if (lcc->lcc_n < 0.0)
+  {
+    rho = -rho;
+    theta = atan2(-dx, -dy);
+  }
+  else
+  {
+    theta = atan2(dx, dy);
+  }
+  if (rho == 0.0)
+  {
+    *lat = (lcc->lcc_n < 0.0 ? -90.0 : 90.0);
+    *lon = lcc->lcc_long_meridian_degree;
+    return TRUE;
+  }
+  F64 t = pow(rho / lcc->lcc_aF, 1.0 / lcc->lcc_n);
+  F64 phi = PI_OVER_2 - 2.0 * atan(t);
+  for (I32 i = 0; i < 16; i++)
+  {
+    F64 e_sin = e * sin(phi);
+    F64 next = PI_OVER_2 - 2.0 * atan(t * pow((1.0 - e_sin) / (1.0 + e_sin), e / 2.0));
+    if (fabs(next - phi) < 1e-12)
+    {
+      phi = next;
+      break;
+    }
+    phi = next;
+  }
+  *lat = rad2deg * phi;
+  *lon = rad2deg * (theta / lcc->lcc_n + lcc->lcc_long_meridian_radian);
+  return TRUE;
+}
+
+BOOL CRSprojector::init(const CRSprojectionParameters* projection, const CRSprojectionEllipsoid* ellipsoid, const F64 meter_per_unit)
+{
+  type = -1;
+  if ((projection == 0) || (meter_per_unit <= 0.0))
+  {
+    return FALSE;
+  }
+  this->meter_per_unit = meter_per_unit;
+
+  if ((projection->type == CRS_PROJECTION_LONG_LAT) || (projection->type == CRS_PROJECTION_LAT_LONG))
+  {
+    type = projection->type;
+    return TRUE;
+  }
+
+  if (ellipsoid == 0)
+  {
+    return FALSE;
+  }
+
+  // conformal to geodetic latitude (Snyder, Map Projections - A Working Manual, p. 15)
+
+  F64 e2 = ellipsoid->eccentricity_squared;
+  F64 e4 = e2 * e2;
+  F64 e6 = e4 * e2;
+  F64 e8 = e6 * e2;
+  chi[0] = e2 / 2.0 + 5.0 * e4 / 24.0 + e6 / 12.0 + 13.0 * e8 / 360.0;
+  chi[1] = 7.0 * e4 / 48.0 + 29.0 * e6 / 240.0 + 811.0 * e8 / 11520.0;
+  chi[2] = 7.0 * e6 / 120.0 + 81.0 * e8 / 1120.0;
+  chi[3] = 4279.0 * e8 / 161280.0;
+
+  if ((projection->type == CRS_PROJECTION_UTM) || (projection->type == CRS_PROJECTION_TM))
+  {
+    CRSprojectionParametersTM tm;
+    if (projection->type == CRS_PROJECTION_UTM)
+    {
+      compute_utm_parameters((const CRSprojectionParametersUTM*)projection, ellipsoid, &tm);
+    }
+    else
+    {
+      tm = *((const CRSprojectionParametersTM*)projection);
+      compute_tm_parameters(&tm, ellipsoid);
+    }
+
+    // Krueger series in the third flattening n
+
+    F64 n = (ellipsoid->equatorial_radius - ellipsoid->polar_radius) / (ellipsoid->equatorial_radius + ellipsoid->polar_radius);
+    F64 n2 = n * n;
+    F64 n3 = n2 * n;
+    F64 n4 = n3 * n;
+    F64 A = ellipsoid->equatorial_radius / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0);
+    beta[0] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0;
+    beta[1] = n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0;
+    beta[2] = 17.0 * n3 / 480.0 - 37.0 * n4 / 840.0;
+    beta[3] = 4397.0 * n4 / 161280.0;
+    tm_k0A = tm.tm_scale_factor * A;
+    tm_xi0 = compute_tm_arc(&tm, tm.tm_lat_origin_radian) / A;
+    false_easting = tm.tm_false_easting_meter;
+    false_northing = tm.tm_false_northing_meter;
+    long_meridian = tm.tm_long_meridian_radian;
+    type = CRS_PROJECTION_TM;
+    return TRUE;
+  }
+  else if (projection->type == CRS_PROJECTION_LCC)
+  {
+    CRSprojectionParametersLCC lcc = *((const CRSprojectionParametersLCC*)projection);
+    compute_lcc_parameters(&lcc, ellipsoid);
+    lcc_n = lcc.lcc_n;
+    lcc_aF = lcc.lcc_aF;
+    lcc_rho0 = lcc.lcc_rho0;
+    lcc_sign = (lcc.lcc_n < 0.0 ? -1.0 : 1.0);
+    false_easting = lcc.lcc_false_easting_meter;
+    false_northing = lcc.lcc_false_northing_meter;
+    long_meridian = lcc.lcc_long_meridian_radian;
+    type = CRS_PROJECTION_LCC;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+// the loops have no branches and evaluate the series with multiple angle
+// recurrences so that only a few transcendental functions per point remain
+
+void CRSprojector::inverse(const U32 number, const F64* x, const F64* y, F64* lat, F64* lon) const
+{
+  U32 i;
+
+  if (type == CRS_PROJECTION_LONG_LAT)
+  {
+    for (i = 0; i < number; i++)
+    {
+      lon[i] = x[i];
+      lat[i] = y[i];
+    }
+  }
+  else if (type == CRS_PROJECTION_LAT_LONG)
+  {
+    for (i = 0; i < number; i++)
+    {
+      lat[i] = x[i];
+      lon[i] = y[i];
+    }
+  }
+  else if (type == CRS_PROJECTION_TM)
+  {
+    // to conformal latitude (Krueger) and then to geodetic latitude
+
+    F64 scale = meter_per_unit / tm_k0A;
+    F64 offset_xi = tm_xi0 - false_northing / tm_k0A;
+    F64 offset_eta = -false_easting / tm_k0A;
+    for (i = 0; i < number; i++)
+    {
+      F64 xi = scale * y[i] + offset_xi;
+      F64 eta = scale * x[i] + offset_eta;
+      F64 s2 = sin(2.0 * xi);
+      F64 c2 = cos(2.0 * xi);
+      F64 ep = exp(2.0 * eta);
+      F64 ch2 = (ep + 1.0 / ep) / 2.0;
+      F64 sh2 = (ep - 1.0 / ep) / 2.0;
+      F64 s4 = 2.0 * s2 * c2;
+      F64 c4 = c2 * c2 - s2 * s2;
+      F64 ch4 = 2.0 * ch2 * ch2 - 1.0;
+      F64 sh4 = 2.0 * sh2 * ch2;
+      F64 s6 = s4 * c2 + c4 * s2;
+      F64 c6 = c4 * c2 - s4 * s2;
+      F64 ch6 = ch4 * ch2 + sh4 * sh2;
+      F64 sh6 = sh4 * ch2 + ch4 * sh2;
+      F64 s8 = 2.0 * s4 * c4;
+      F64 c8 = c4 * c4 - s4 * s4;
+      F64 ch8 = 2.0 * ch4 * ch4 - 1.0;
+      F64 sh8 = 2.0 * sh4 * ch4;
+      F64 xi1 = xi - (beta[0] * s2 * ch2 + beta[1] * s4 * ch4 + beta[2] * s6 * ch6 + beta[3] * s8 * ch8);
+      F64 eta1 = eta - (beta[0] * c2 * sh2 + beta[1] * c4 * sh4 + beta[2] * c6 * sh6 + beta[3] * c8 * sh8);
+      F64 ep1 = exp(eta1);
+      F64 sinh_eta1 = (ep1 - 1.0 / ep1) / 2.0;
+      F64 cosh_eta1 = (ep1 + 1.0 / ep1) / 2.0;
+      F64 conformal = asin(sin(xi1) / cosh_eta1);
+      F64 sc2 = sin(2.0 * conformal);
+      F64 cc2 = cos(2.0 * conformal);
+      F64 sc4 = 2.0 * sc2 * cc2;
+      F64 cc4 = cc2 * cc2 - sc2 * sc2;
+      F64 sc6 = sc4 * cc2 + cc4 * sc2;
+      F64 sc8 = 2.0 * sc4 * cc4;
+      F64 phi = conformal + chi[0] * sc2 + chi[1] * sc4 + chi[2] * sc6 + chi[3] * sc8;
+
+      // northings beyond the poles have no latitude
+
+      lat[i] = (fabs(xi1) <= PI_OVER_2 ? rad2deg * phi : quiet_nan);
+      lon[i] = rad2deg * (long_meridian + atan2(sinh_eta1, cos(xi1)));
+    }
+  }
+  else if (type == CRS_PROJECTION_LCC)
+  {
+    F64 inverse_n = 1.0 / lcc_n;
+    for (i = 0; i < number; i++)
+    {
+      F64 dx = lcc_sign * (meter_per_unit * x[i] - false_easting);
+      F64 dy = lcc_sign * (lcc_rho0 - (meter_per_unit * y[i] - false_northing));
+      F64 rho = sqrt(dx * dx + dy * dy);
+      F64 t = exp(inverse_n * log(lcc_sign * rho / lcc_aF));
+      F64 conformal = PI_OVER_2 - 2.0 * atan(t);
+      F64 sc2 = sin(2.0 * conformal);
+      F64 cc2 = cos(2.0 * conformal);
+      F64 sc4 = 2.0 * sc2 * cc2;
+      F64 cc4 = cc2 * cc2 - sc2 * sc2;
+      F64 sc6 = sc4 * cc2 + cc4 * sc2;
+      F64 sc8 = 2.0 * sc4 * cc4;
+      lat[i] = rad2deg * (conformal + chi[0] * sc2 + chi[1] * sc4 + chi[2] * sc6 + chi[3] * sc8);
+      lon[i] = rad2deg * (long_meridian + inverse_n * atan2(dx, dy));
+    }
+  }
+}
+
+CRSprojector::CRSprojector()
+{
+  type = -1;
+  meter_per_unit = 1.0;
+  false_easting = false_northing = long_meridian = 0.0;
+  tm_k0A = tm_xi0 = 0.0;
+  lcc_n = lcc_aF = lcc_rho0 = lcc_sign = 0.0;
+  beta[0] = beta[1] = beta[2] = beta[3] = 0.0;
+  chi[0] = chi[1] = chi[2] = chi[3] = 0.0;
+}
+
+#define CRS_UTM_ZONE_TOLERANCE   1.0
+#define CRS_TM_MAX_LONGITUDE    15.0
+#define CRS_LCC_MAX_LONGITUDE   60.0
+#define CRS_LCC_MAX_LATITUDE    30.0
+
+void CRScheck::check_bounding_box(LASheader* lasheader, const CRSprojectionParameters* projection, const CRSprojectionEllipsoid* ellipsoid, const U32 units)
+{
+  CHAR note[512];
+
+  if ((lasheader->max_x < lasheader->min_x) || (lasheader->max_y < lasheader->min_y))
+  {
+    return;
+  }
+
+  // geographic coordinates must look like degrees
+
+  if ((projection->type == CRS_PROJECTION_LONG_LAT) || (projection->type == CRS_PROJECTION_LAT_LONG))
+  {
+    F64 min_lon = (projection->type == CRS_PROJECTION_LONG_LAT ? lasheader->min_x : lasheader->min_y);
+    F64 max_lon = (projection->type == CRS_PROJECTION_LONG_LAT ? lasheader->max_x : lasheader->max_y);
+    F64 min_lat = (projection->type == CRS_PROJECTION_LONG_LAT ? lasheader->min_y : lasheader->min_x);
+    F64 max_lat = (projection->type == CRS_PROJECTION_LONG_LAT ? lasheader->max_y : lasheader->max_x);
+    if ((min_lon < -180.0) || (max_lon > 360.0) || (min_lat < -90.0) || (max_lat > 90.0))
+    {
+      sprintf(note, "bounding box with longitude %g to %g and latitude %g to %g is impossible for the geographic CRS", min_lon, max_lon, min_lat, max_lat);
+      lasheader->add_fail("CRS", note);
+    }
+    return;
+  }
+
+  if (ellipsoid == 0)
+  {
+    return;
+  }
+
+  // inverse project the four corners of the bounding box
+
+  F64 meter_per_unit = (units == 3 ? surveyfeet2meter : (units == 2 ? feet2meter : 1.0));
+  F64 x[4], y[4], lat[4], lon[4];
+  x[0] = x[2] = meter_per_unit * lasheader->min_x;
+  x[1] = x[3] = meter_per_unit * lasheader->max_x;
+  y[0] = y[1] = meter_per_unit * lasheader->min_y;
+  y[2] = y[3] = meter_per_unit * lasheader->max_y;
+
+  CRSprojectionParametersTM utm_as_tm;
+  F64 long_meridian;
+  I32 i;
+  BOOL possible = TRUE;
+
+  if (projection->type == CRS_PROJECTION_UTM)
+  {
+    compute_utm_parameters((const CRSprojectionParametersUTM*)projection, ellipsoid, &utm_as_tm);
+    for (i = 0; i < 4; i++) possible = possible && inverse_tm(&utm_as_tm, ellipsoid, x[i], y[i], &lat[i], &lon[i]);
+    long_meridian = utm_as_tm.tm_long_meridian_degree;
+  }
+  else if (projection->type == CRS_PROJECTION_TM)
+  {
+    const CRSprojectionParametersTM* tm = (const CRSprojectionParametersTM*)projection;
+    for (i = 0; i < 4; i++) possible = possible && inverse_tm(tm, ellipsoid, x[i], y[i], &lat[i], &lon[i]);
+    long_meridian = tm->tm_long_meridian_degree;
+  }
+  else if (projection->type == CRS_PROJECTION_LCC)
+  {
+    const CRSprojectionParametersLCC* lcc = (const CRSprojectionParametersLCC*)projection;
+    for (i = 0; i < 4; i++) possible = possible && inverse_lcc(lcc, ellipsoid, x[i], y[i], &lat[i], &lon[i]);
+    long_meridian = lcc->lcc_long_meridian_degree;
+  }
+  else
+  {
+    return;
+  }
+
+  F64 min_lat = 90.0, max_lat = -90.0, max_dlon = 0.0;
+  for (i = 0; possible && (i < 4); i++)
+  {
+    if (!(fabs(lat[i]) <= 90.0) || !(fabs(lon[i]) < 1e6))
+    {
+      possible = FALSE;
       break;
     }
+    F64 dlon = fmod(fabs(lon[i] - long_meridian), 360.0);
+    if (dlon > 180.0) dlon = 360.0 - dlon;
+    if (lat[i] < min_lat) min_lat = lat[i];
+    if (lat[i] > max_lat) max_lat = lat[i];
+    if (dlon > max_dlon) max_dlon = dlon;
   }
 
-  if (ellipsoid != -1)
+  if (!possible)
   {
-    set_ellipsoid(ellipsoid, TRUE);
+    sprintf(note, "bounding box (%g %g) to (%g %g) is beyond the poles of the %s projection", lasheader->min_x, lasheader->min_y, lasheader->max_x, lasheader->max_y, projection->name);
+    lasheader->add_fail("CRS", note);
+    return;
   }
 
-  if (!has_projection)
+  if (projection->type == CRS_PROJECTION_UTM)
   {
-    if (user_defined_projection == 1)
+    const CRSprojectionParametersUTM* utm = (const CRSprojectionParametersUTM*)projection;
+    if (utm->utm_northern_hemisphere && (max_lat < 0.0))
     {
-      if ((offsetProjFalseEastingGeoKey >= 0) &&
-          (offsetProjFalseNorthingGeoKey >= 0) &&
-          (offsetProjNatOriginLatGeoKey >= 0) &&
-          (offsetProjCenterLongGeoKey >= 0) &&
-          (offsetProjScaleAtNatOriginGeoKey >= 0))
-      {
-        F64 falseEasting = geokey_double_params[offsetProjFalseEastingGeoKey];
-        F64 falseNorthing = geokey_double_params[offsetProjFalseNorthingGeoKey];
-        F64 latOriginDeg = geokey_double_params[offsetProjNatOriginLatGeoKey];
-        F64 longMeridianDeg = geokey_double_params[offsetProjCenterLongGeoKey];
-        F64 scaleFactor = geokey_double_params[offsetProjScaleAtNatOriginGeoKey];
-        set_transverse_mercator_projection(falseEasting, falseNorthing, latOriginDeg, longMeridianDeg, scaleFactor, TRUE, description);
-        if (description)
-        {
-          sprintf(description, "generic transverse mercator");
-        }
-        has_projection = TRUE;
-      }
+      sprintf(note, "bounding box with latitude %.3f to %.3f is in the southern hemisphere but CRS is UTM zone %d north", min_lat, max_lat, utm->utm_zone_number);
+      lasheader->add_fail("CRS", note);
     }
-    else if (user_defined_projection == 8)
+    else if (!utm->utm_northern_hemisphere && (min_lat > 0.0))
     {
-      if ((offsetProjFalseEastingGeoKey >= 0) &&
-          (offsetProjFalseNorthingGeoKey >= 0) &&
-          (offsetProjNatOriginLatGeoKey >= 0) &&
-          (offsetProjCenterLongGeoKey >= 0) &&
-          (offsetProjStdParallel1GeoKey >= 0) &&
-          (offsetProjStdParallel2GeoKey >= 0))
+      sprintf(note, "bounding box with latitude %.3f to %.3f is in the northern hemisphere but CRS is UTM zone %d south", min_lat, max_lat, utm->utm_zone_number);
+      lasheader->add_fail("CRS", note);
+    }
+    if (max_dlon > (3.0 + CRS_UTM_ZONE_TOLERANCE))
+    {
+      sprintf(note, "bounding box reaches %.2f degrees from the central meridian %d of UTM zone %d that is only 6 degrees wide", max_dlon, utm->utm_long_origin, utm->utm_zone_number);
+      lasheader->add_fail("CRS", note);
+    }
+    if ((max_lat > 84.0 + CRS_UTM_ZONE_TOLERANCE) || (min_lat < -80.0 - CRS_UTM_ZONE_TOLERANCE))
+    {
+      sprintf(note, "bounding box with latitude %.3f to %.3f is outside the UTM latitudes of 80S to 84N", min_lat, max_lat);
+      lasheader->add_fail("CRS", note);
+    }
+  }
+  else if (projection->type == CRS_PROJECTION_TM)
+  {
+    if (max_dlon > CRS_TM_MAX_LONGITUDE)
+    {
+      sprintf(note, "bounding box reaches %.2f degrees from the central meridian %g of the transverse mercator projection", max_dlon, long_meridian);
+      lasheader->add_fail("CRS", note);
+    }
+  }
+  else
+  {
+    const CRSprojectionParametersLCC* lcc = (const CRSprojectionParametersLCC*)projection;
+    F64 min_parallel = (lcc->lcc_first_std_parallel_degree < lcc->lcc_second_std_parallel_degree ? lcc->lcc_first_std_parallel_degree : lcc->lcc_second_std_parallel_degree);
+    F64 max_parallel = (lcc->lcc_first_std_parallel_degree < lcc->lcc_second_std_parallel_degree ? lcc->lcc_second_std_parallel_degree : lcc->lcc_first_std_parallel_degree);
+    if (max_dlon > CRS_LCC_MAX_LONGITUDE)
+    {
+      sprintf(note, "bounding box reaches %.2f degrees from the central meridian %g of the lambert conformal conic projection", max_dlon, long_meridian);
+      lasheader->add_fail("CRS", note);
+    }
+    if ((min_lat < min_parallel - CRS_LCC_MAX_LATITUDE) || (max_lat > max_parallel + CRS_LCC_MAX_LATITUDE))
+    {
+      sprintf(note, "bounding box with latitude %.3f to %.3f is far from the standard parallels %g and %g of the lambert conformal conic projection", min_lat, max_lat, min_parallel, max_parallel);
+      lasheader->add_fail("CRS", note);
+    }
+  }
+}
+
+#define CRS_SAMPLE_BATCH 1024
+
+BOOL CRScheck::check_sample(LASheader* lasheader, const U32 number, const F64* x, const F64* y, F64* footprint)
+{
+  CHAR note[512];
+
+  if ((checked_projection == 0) || (number == 0))
+  {
+    return FALSE;
+  }
+
+  CRSprojector projector;
+  if (!projector.init(checked_projection, checked_ellipsoid, (checked_units == 3 ? surveyfeet2meter : (checked_units == 2 ? feet2meter : 1.0))))
+  {
+    return FALSE;
+  }
+
+  const CRSprojectionParametersUTM* utm = (checked_projection->type == CRS_PROJECTION_UTM ? (const CRSprojectionParametersUTM*)checked_projection : 0);
+  F64 long_meridian = 0.0;
+  F64 max_dlon = 180.0;
+  if (utm)
+  {
+    long_meridian = utm->utm_long_origin;
+    max_dlon = 3.0 + CRS_UTM_ZONE_TOLERANCE;
+  }
+  else if (checked_projection->type == CRS_PROJECTION_TM)
+  {
+    long_meridian = ((const CRSprojectionParametersTM*)checked_projection)->tm_long_meridian_degree;
+    max_dlon = CRS_TM_MAX_LONGITUDE;
+  }
+  else if (checked_projection->type == CRS_PROJECTION_LCC)
+  {
+    long_meridian = ((const CRSprojectionParametersLCC*)checked_projection)->lcc_long_meridian_degree;
+    max_dlon = CRS_LCC_MAX_LONGITUDE;
+  }
+
+  // inverse project the sample in batches and count the impossible points
+
+  F64 lat[CRS_SAMPLE_BATCH];
+  F64 lon[CRS_SAMPLE_BATCH];
+  U32 impossible = 0, wrong_hemisphere = 0, outside_zone = 0, valid = 0;
+  U32 start, i, batch;
+
+  footprint[0] = footprint[1] = 1e300;
+  footprint[2] = footprint[3] = -1e300;
+
+  for (start = 0; start < number; start += batch)
+  {
+    batch = ((number - start) < CRS_SAMPLE_BATCH ? (number - start) : CRS_SAMPLE_BATCH);
+    projector.inverse(batch, x + start, y + start, lat, lon);
+    for (i = 0; i < batch; i++)
+    {
+      // the negated compare also catches the NaNs beyond the poles
+
+      if (!(fabs(lat[i]) <= 90.0) || !(fabs(lon[i]) <= 360.0))
       {
-        F64 falseEasting = geokey_double_params[offsetProjFalseEastingGeoKey];
-        F64 falseNorthing = geokey_double_params[offsetProjFalseNorthingGeoKey];
-        F64 latOriginDeg = geokey_double_params[offsetProjNatOriginLatGeoKey];
-        F64 longOriginDeg = geokey_double_params[offsetProjCenterLongGeoKey];
-        F64 firstStdParallelDeg = geokey_double_params[offsetProjStdParallel1GeoKey];
-        F64 secondStdParallelDeg = geokey_double_params[offsetProjStdParallel2GeoKey];
-        set_lambert_conformal_conic_projection(falseEasting, falseNorthing, latOriginDeg, longOriginDeg, firstStdParallelDeg, secondStdParallelDeg, TRUE, description);
-        if (description)
-        {
-          sprintf(description, "generic lambert conformal conic");
-        }
-        has_projection = TRUE;
+        impossible++;
+        continue;
+      }
+      if (utm && (utm->utm_northern_hemisphere ? (lat[i] < -CRS_UTM_ZONE_TOLERANCE) : (lat[i] > CRS_UTM_ZONE_TOLERANCE)))
+      {
+        wrong_hemisphere++;
       }
+      F64 dlon = fmod(fabs(lon[i] - long_meridian), 360.0);
+      if (dlon > 180.0) dlon = 360.0 - dlon;
+      if (dlon > max_dlon)
+      {
+        outside_zone++;
+      }
+      if (lon[i] < footprint[0]) footprint[0] = lon[i];
+      if (lat[i] < footprint[1]) footprint[1] = lat[i];
+      if (lon[i] > footprint[2]) footprint[2] = lon[i];
+      if (lat[i] > footprint[3]) footprint[3] = lat[i];
+      valid++;
     }
   }
-  return has_projection;
+
+  if (impossible)
+  {
+    sprintf(note, "%u of %u sampled points have coordinates that are impossible for the %s projection", impossible, number, checked_projection->name);
+    lasheader->add_fail("CRS", note);
+  }
+  if (wrong_hemisphere)
+  {
+    sprintf(note, "%u of %u sampled points are in the %s hemisphere but CRS is UTM zone %d %s", wrong_hemisphere, number, (utm->utm_northern_hemisphere ? "southern" : "northern"), utm->utm_zone_number, (utm->utm_northern_hemisphere ? "north" : "south"));
+    lasheader->add_fail("CRS", note);
+  }
+  if (outside_zone)
+  {
+    sprintf(note, "%u of %u sampled points are more than %g degrees from the central meridian %g of the %s projection", outside_zone, number, max_dlon, long_meridian, checked_projection->name);
+    lasheader->add_fail("CRS", note);
+  }
+
+  return (valid > 0);
 }
 
 void CRScheck::check(LASheader* lasheader, CHAR* description)
 {
   CHAR note[512];
+  const CRSprojectionParameters* projection = 0;
+  const CRSprojectionEllipsoid* ellipsoid = 0;
+  U32 units = 0;
 
-  if (lasheader->geokeys || lasheader->ogc_wkt)
+  // maybe the same CRS VLRs were already checked for an earlier file
+
+  if (!crscache.replay(lasheader, description, &projection, &ellipsoid, &units))
   {
-    if (lasheader->geokeys)
+    U32 fail_start = lasheader->fail_num;
+    U32 warning_start = lasheader->warning_num;
+
+    if (lasheader->geokeys || lasheader->ogc_wkt)
     {
-      if (!check_geokeys(lasheader, description))
+      BOOL described = FALSE;
+      if (lasheader->geokeys)
+      {
+        if (!check_geokeys(lasheader, description))
+        {
+          sprintf(note, "the %u geokeys do not properly specify a Coordinate Reference System", lasheader->geokeys->number_of_keys);
+          lasheader->add_fail("CRS", note);
+        }
+        else
+        {
+          described = TRUE;
+        }
+      }
+      if (lasheader->ogc_wkt)
       {
-        sprintf(note, "the %u geokeys do not properly specify a Coordinate Reference System", lasheader->geokeys->number_of_keys);
-        lasheader->add_fail("CRS", note);
+        if (check_wkt(lasheader, (described ? 0 : description)) && lasheader->geokeys)
+        {
+          // both must describe the same CRS
+
+          check_consistency(lasheader);
+        }
       }
     }
-    if (lasheader->ogc_wkt)
+    else
     {
-      sprintf(note, "there is a OGC WKT string but its check is not yet implemented");
-      lasheader->add_warning("CRS", note);
+      sprintf(note, "neither GEOTIFF tags nor OGC WKT specify Coordinate Reference System");
+      lasheader->add_fail("CRS", note);
+    }
+
+    // the coordinates are checked with the GeoKeys unless only the OGC WKT has a projection
+
+    U32 i = (projections[0] ? 0 : 1);
+    if (projections[i])
+    {
+      if (ellipsoids[i] == 0)
+      {
+        set_ellipsoid(CRS_ELLIPSOID_WGS84, (i == 0));
+      }
+      if (projections[i]->type == CRS_PROJECTION_TM)
+      {
+        compute_tm_parameters((CRSprojectionParametersTM*)projections[i], ellipsoids[i]);
+      }
+      else if (projections[i]->type == CRS_PROJECTION_LCC)
+      {
+        compute_lcc_parameters((CRSprojectionParametersLCC*)projections[i], ellipsoids[i]);
+      }
+      projection = projections[i];
+      ellipsoid = ellipsoids[i];
+      units = coordinate_units[i];
     }
+
+    crscache.add(lasheader, description, fail_start, warning_start, projection, ellipsoid, units);
   }
-  else
+
+  // the bounding box differs from file to file so it is checked every time
+
+  if (projection)
   {
-    sprintf(note, "neither GEOTIFF tags nor OGC WKT specify Coordinate Reference System");
-    lasheader->add_fail("CRS", note);
+    check_bounding_box(lasheader, projection, ellipsoid, units);
   }
+
+  // remember the projection for checking a sample of the points
+
+  checked_projection = projection;
+  checked_ellipsoid = ellipsoid;
+  checked_units = units;
 }
 
 CRScheck::CRScheck()
 {
+  horizontal_epsg[0] = horizontal_epsg[1] = 0;
   coordinate_units[0] = coordinate_units[1] = 0;
   elevation_units[0] = elevation_units[1] = 0;
   vertical_epsg[0] = vertical_epsg[1] = 0;
   ellipsoids[0] = ellipsoids[1] = 0;
   projections[0] = projections[1] = 0;
+  checked_projection = 0;
+  checked_ellipsoid = 0;
+  checked_units = 0;
 };
 
 CRScheck::~CRScheck()
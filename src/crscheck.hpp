@@ -6,7 +6,7 @@
   CONTENTS:
   
     Functions to validate whether the GEOTIFF tags specify a valid geo-coding
-    and (someday) whether they are in agreement to the OGC WKT string.
+    and whether they are in agreement to the OGC WKT string.
   
   PROGRAMMERS:
 
@@ -25,6 +25,11 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- batch inverse projection of a sample of the points
+    18 October 2026 -- inverse project the bounding box to check its geography
+    18 October 2026 -- parse the OGC WKT and compare it with the GeoTIFF tags
+    18 October 2026 -- sorted EPSG tables instead of one giant switch
+    18 October 2026 -- remember the outcome of identical CRS checks
     8 September 2013 -- it started raining on the beach after TREEMAPS meeting
   
 ===============================================================================
@@ -34,6 +39,8 @@
 
 #include "lasheader.hpp"
 
+class CRSwkt;
+
 class CRSprojectionEllipsoid
 {
 public:
@@ -101,19 +108,47 @@ public:
   F64 tm_ep;
 };
 
+class CRSprojector
+{
+public:
+  BOOL init(const CRSprojectionParameters* projection, const CRSprojectionEllipsoid* ellipsoid, const F64 meter_per_unit);
+  void inverse(const U32 number, const F64* x, const F64* y, F64* lat, F64* lon) const;
+  CRSprojector();
+
+private:
+  I32 type;
+  F64 meter_per_unit;
+  F64 false_easting;
+  F64 false_northing;
+  F64 long_meridian;
+  F64 tm_k0A;
+  F64 tm_xi0;
+  F64 lcc_n;
+  F64 lcc_aF;
+  F64 lcc_rho0;
+  F64 lcc_sign;
+  F64 beta[4];
+  F64 chi[4];
+};
+
 class CRScheck
 {
 public:
   void check(LASheader* lasheader, CHAR* description);
+  BOOL check_sample(LASheader* lasheader, const U32 number, const F64* x, const F64* y, F64* footprint);
   CRScheck();
   ~CRScheck();
 
 private:
+  U32 horizontal_epsg[2];
   U32 coordinate_units[2];
   U32 elevation_units[2];
   U32 vertical_epsg[2];
   CRSprojectionEllipsoid* ellipsoids[2];
   CRSprojectionParameters* projections[2];
+  const CRSprojectionParameters* checked_projection;
+  const CRSprojectionEllipsoid* checked_ellipsoid;
+  U32 checked_units;
 
   void set_coordinates_in_survey_feet(const BOOL from_geokeys);
   void set_coordinates_in_feet(const BOOL from_geokeys);
@@ -122,6 +157,7 @@ private:
   void set_elevation_in_feet(const BOOL from_geokeys);
   void set_elevation_in_meter(const BOOL from_geokeys);
   BOOL set_ellipsoid(const I32 ellipsoid_id, const BOOL from_geokeys, char* description=0);
+  BOOL set_ellipsoid(const F64 equatorial_radius, const F64 inverse_flattening, const BOOL from_geokeys, char* description=0);
   void set_projection(CRSprojectionParameters* projection, const BOOL from_geokeys);
   BOOL set_latlong_projection(const BOOL from_geokeys, CHAR* description=0);
   BOOL set_longlat_projection(const BOOL from_geokeys, CHAR* description=0);
@@ -129,16 +165,21 @@ private:
   BOOL set_utm_projection(const I32 zone, const BOOL northern, const BOOL from_geokeys, CHAR* description=0);
   void set_lambert_conformal_conic_projection(const F64 falseEasting, const F64 falseNorthing, const F64 latOriginDegree, const F64 longMeridianDegree, const F64 firstStdParallelDegree, const F64 secondStdParallelDegree, const BOOL from_geokeys, CHAR* description=0);
   void set_transverse_mercator_projection(const F64 falseEasting, const F64 falseNorthing, const F64 latOriginDegree, const F64 longMeridianDegree, const F64 scaleFactor, const BOOL from_geokeys, CHAR* description=0);
-  BOOL set_state_plane_nad27_lcc(const CHAR* zone, const BOOL from_geokeys, CHAR* description=0);
-  BOOL set_state_plane_nad83_lcc(const CHAR* zone, const BOOL from_geokeys, CHAR* description=0);
-  BOOL set_state_plane_nad27_tm(const CHAR* zone, const BOOL from_geokeys, CHAR* description=0);
-  BOOL set_state_plane_nad83_tm(const CHAR* zone, const BOOL from_geokeys, CHAR* description=0);
+  BOOL set_state_plane_nad27_lcc(const U16 epsg, const BOOL from_geokeys, CHAR* description=0);
+  BOOL set_state_plane_nad83_lcc(const U16 epsg, const BOOL from_geokeys, CHAR* description=0);
+  BOOL set_state_plane_nad27_tm(const U16 epsg, const BOOL from_geokeys, CHAR* description=0);
+  BOOL set_state_plane_nad83_tm(const U16 epsg, const BOOL from_geokeys, CHAR* description=0);
   BOOL set_coordinates_from_ProjLinearUnitsGeoKey(U16 value);
   BOOL set_elevation_from_VerticalUnitsGeoKey(U16 value);
   BOOL set_vertical_from_VerticalCSTypeGeoKey(U16 value);
   BOOL set_projection_from_ProjectedCSTypeGeoKey(const U16 value, CHAR* description=0);
 
+  BOOL set_projection_from_wkt(LASheader* lasheader, const CRSwkt* wkt, const I32 crs, CHAR* description);
+
   BOOL check_geokeys(LASheader* lasheader, CHAR* description);
+  BOOL check_wkt(LASheader* lasheader, CHAR* description);
+  void check_consistency(LASheader* lasheader);
+  void check_bounding_box(LASheader* lasheader, const CRSprojectionParameters* projection, const CRSprojectionEllipsoid* ellipsoid, const U32 units);
 };
 
 #endif
@@ -0,0 +1,267 @@
+/*
+===============================================================================
+
+  FILE:  dirwalker.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define DIRWALKER_SEPARATOR '\\'
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#define DIRWALKER_SEPARATOR '/'
+#endif
+
+#include "dirwalker.hpp"
+
+static BOOL is_las_or_laz(const CHAR* name)
+{
+  int len = (int)strlen(name);
+  if (len < 4) return FALSE;
+  const CHAR* ext = name + len - 4;
+  if (ext[0] != '.') return FALSE;
+  if ((ext[1] != 'l') && (ext[1] != 'L')) return FALSE;
+  if ((ext[2] != 'a') && (ext[2] != 'A')) return FALSE;
+  return ((ext[3] == 's') || (ext[3] == 'S') || (ext[3] == 'z') || (ext[3] == 'Z'));
+}
+
+BOOL DIRwalker::add(const CHAR* directory_name)
+{
+  return push(directory_name);
+}
+
+BOOL DIRwalker::push(const CHAR* path)
+{
+  if (number_pending == alloc_pending)
+  {
+    alloc_pending = (alloc_pending ? 2*alloc_pending : 64);
+    pending = (CHAR**)realloc(pending, sizeof(CHAR*)*alloc_pending);
+    if (pending == 0)
+    {
+      fprintf(stderr, "ERROR: cannot allocate %u pending directories\n", alloc_pending);
+      number_pending = alloc_pending = 0;
+      return FALSE;
+    }
+  }
+  pending[number_pending++] = strdup(path);
+  return TRUE;
+}
+
+BOOL DIRwalker::open_next()
+{
+  while (number_pending)
+  {
+    current_path = pending[--number_pending];
+
+    // strip trailing separators so entries are joined with exactly one
+
+    int len = (int)strlen(current_path);
+    while ((len > 1) && ((current_path[len-1] == '/') || (current_path[len-1] == '\\')))
+    {
+      current_path[--len] = '\0';
+    }
+
+#ifdef _WIN32
+    CHAR* pattern = (CHAR*)malloc(len + 3);
+    sprintf(pattern, "%s\\*", current_path);
+    handle = (void*)FindFirstFileA(pattern, (WIN32_FIND_DATAA*)find_data);
+    free(pattern);
+    if ((HANDLE)handle != INVALID_HANDLE_VALUE)
+    {
+      have_entry = TRUE;
+      return TRUE;
+    }
+    handle = 0;
+#else
+    handle = (void*)opendir(current_path);
+    if (handle)
+    {
+      return TRUE;
+    }
+#endif
+    fprintf(stderr, "WARNING: cannot open directory '%s'\n", current_path);
+    free(current_path);
+    current_path = 0;
+  }
+  return FALSE;
+}
+
+BOOL DIRwalker::read_next(CHAR** entry_name, BOOL* is_directory)
+{
+#ifdef _WIN32
+  if (!have_entry)
+  {
+    if (!FindNextFileA((HANDLE)handle, (WIN32_FIND_DATAA*)find_data))
+    {
+      return FALSE;
+    }
+  }
+  have_entry = FALSE;
+  *entry_name = ((WIN32_FIND_DATAA*)find_data)->cFileName;
+  *is_directory = (((WIN32_FIND_DATAA*)find_data)->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ? TRUE : FALSE;
+#else
+  struct dirent* entry = readdir((DIR*)handle);
+  if (entry == 0)
+  {
+    return FALSE;
+  }
+  *entry_name = entry->d_name;
+#ifdef DT_DIR
+  if (entry->d_type != DT_UNKNOWN)
+  {
+    *is_directory = (entry->d_type == DT_DIR);
+    return TRUE;
+  }
+#endif
+  // the file system does not report the type so we have to stat
+
+  *is_directory = FALSE;
+  U32 len = (U32)(strlen(current_path) + strlen(entry->d_name) + 2);
+  if (len > alloc_path)
+  {
+    alloc_path = len;
+    path = (CHAR*)realloc(path, alloc_path);
+  }
+  sprintf(path, "%s%c%s", current_path, DIRWALKER_SEPARATOR, entry->d_name);
+  struct stat status;
+  if (stat(path, &status) == 0)
+  {
+    *is_directory = S_ISDIR(status.st_mode);
+  }
+#endif
+  return TRUE;
+}
+
+void DIRwalker::close_current()
+{
+  if (handle)
+  {
+#ifdef _WIN32
+    FindClose((HANDLE)handle);
+#else
+    closedir((DIR*)handle);
+#endif
+    handle = 0;
+  }
+  if (current_path)
+  {
+    free(current_path);
+    current_path = 0;
+  }
+}
+
+U32 DIRwalker::walk(LASreadOpener& lasreadopener, const U32 number_ahead)
+{
+  U32 number_added = 0;
+  CHAR* entry_name;
+  BOOL is_directory;
+
+  while ((lasreadopener.get_file_name_number() - lasreadopener.get_file_name_current()) < number_ahead)
+  {
+    if (handle == 0)
+    {
+      if (!open_next())
+      {
+        break;
+      }
+    }
+
+    if (!read_next(&entry_name, &is_directory))
+    {
+      close_current();
+      continue;
+    }
+
+    if ((strcmp(entry_name, ".") == 0) || (strcmp(entry_name, "..") == 0))
+    {
+      continue;
+    }
+
+    if (!is_directory && !is_las_or_laz(entry_name))
+    {
+      continue;
+    }
+
+    U32 len = (U32)(strlen(current_path) + strlen(entry_name) + 2);
+    if (len > alloc_path)
+    {
+      alloc_path = len;
+      path = (CHAR*)realloc(path, alloc_path);
+    }
+    sprintf(path, "%s%c%s", current_path, DIRWALKER_SEPARATOR, entry_name);
+
+    if (is_directory)
+    {
+      push(path);
+    }
+    else if (lasreadopener.add_file_name(path))
+    {
+      number_added++;
+    }
+  }
+  return number_added;
+}
+
+BOOL DIRwalker::is_active() const
+{
+  return (handle != 0) || (number_pending != 0);
+}
+
+DIRwalker::DIRwalker()
+{
+  number_pending = 0;
+  alloc_pending = 0;
+  pending = 0;
+  current_path = 0;
+  handle = 0;
+#ifdef _WIN32
+  find_data = malloc(sizeof(WIN32_FIND_DATAA));
+#else
+  find_data = 0;
+#endif
+  have_entry = FALSE;
+  path = 0;
+  alloc_path = 0;
+}
+
+DIRwalker::~DIRwalker()
+{
+  close_current();
+  while (number_pending)
+  {
+    free(pending[--number_pending]);
+  }
+  if (pending) free(pending);
+  if (find_data) free(find_data);
+  if (path) free(path);
+}
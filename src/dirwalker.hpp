@@ -0,0 +1,65 @@
+/*
+===============================================================================
+
+  FILE:  dirwalker.hpp
+
+  CONTENTS:
+
+    Walks directory trees for '-irec' incrementally so that the validation of
+    the first files overlaps with finding the others.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to stream files found by '-irec'
+
+===============================================================================
+*/
+#ifndef DIR_WALKER_HPP
+#define DIR_WALKER_HPP
+
+#include "lasreadopener.hpp"
+
+class DIRwalker
+{
+public:
+
+  BOOL add(const CHAR* directory_name);
+  U32 walk(LASreadOpener& lasreadopener, const U32 number_ahead);
+  BOOL is_active() const;
+
+  DIRwalker();
+  ~DIRwalker();
+
+private:
+  BOOL push(const CHAR* path);
+  BOOL open_next();
+  BOOL read_next(CHAR** entry_name, BOOL* is_directory);
+  void close_current();
+
+  U32 number_pending;
+  U32 alloc_pending;
+  CHAR** pending;
+  CHAR* current_path;
+  void* handle;
+  void* find_data;
+  BOOL have_entry;
+  CHAR* path;
+  U32 alloc_path;
+};
+
+#endif
@@ -0,0 +1,132 @@
+/*
+===============================================================================
+
+  FILE:  lasbitdepth.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "lasbitdepth.hpp"
+
+static const CHAR* const channel_names[3] = { "intensity", "RGB", "NIR" };
+
+void LASbitdepth::init(const LASheader* lasheader)
+{
+  U8 point_data_format = lasheader->point_data_format;
+  has_channel[LASBITDEPTH_INTENSITY] = TRUE;
+  has_channel[LASBITDEPTH_RGB] = ((point_data_format == 2) || (point_data_format == 3) || (point_data_format == 5) || (point_data_format == 7) || (point_data_format == 8) || (point_data_format == 10));
+  has_channel[LASBITDEPTH_NIR] = ((point_data_format == 8) || (point_data_format == 10));
+  version_minor = lasheader->version_minor;
+  bits[0] = bits[1] = bits[2] = 0;
+}
+
+U32 LASbitdepth::get_bit_depth(const U32 channel) const
+{
+  U32 depth = 0;
+  while ((depth < 16) && (bits[channel] >> depth))
+  {
+    depth++;
+  }
+  return depth;
+}
+
+U32 LASbitdepth::get_scaled_bits(const U32 channel) const
+{
+  U32 scaled = 0;
+  if (bits[channel])
+  {
+    while (((bits[channel] >> scaled) & 1) == 0)
+    {
+      scaled++;
+    }
+  }
+  return scaled;
+}
+
+void LASbitdepth::check(LASheader* lasheader) const
+{
+  CHAR note[512];
+
+  // only LAS 1.4 asks for the intensity to be normalized to 16 bits
+
+  if ((version_minor >= 4) && bits[LASBITDEPTH_INTENSITY] && (get_bit_depth(LASBITDEPTH_INTENSITY) <= 8))
+  {
+    sprintf(note, "all intensities are below 256 so they have %u bits and were not normalized to 16 bits", get_bit_depth(LASBITDEPTH_INTENSITY));
+    lasheader->add_warning("intensity", note);
+  }
+
+  // 8 bit colors should be multiplied by 256
+
+  if (has_channel[LASBITDEPTH_RGB] && bits[LASBITDEPTH_RGB] && (get_bit_depth(LASBITDEPTH_RGB) <= 8))
+  {
+    sprintf(note, "all RGB values are below 256 so they have %u bits and were not multiplied by 256 to 16 bits", get_bit_depth(LASBITDEPTH_RGB));
+    lasheader->add_warning("RGB", note);
+  }
+
+  if (has_channel[LASBITDEPTH_NIR] && bits[LASBITDEPTH_NIR] && (get_bit_depth(LASBITDEPTH_NIR) <= 8))
+  {
+    sprintf(note, "all NIR values are below 256 so they have %u bits and were not multiplied by 256 to 16 bits", get_bit_depth(LASBITDEPTH_NIR));
+    lasheader->add_warning("NIR", note);
+  }
+}
+
+BOOL LASbitdepth::get_bit_depth_description(CHAR* description) const
+{
+  U32 c;
+  I32 len = 0;
+
+  for (c = 0; c < 3; c++)
+  {
+    if (!has_channel[c])
+    {
+      continue;
+    }
+    len += sprintf(description + len, "%s%s ", (len ? " " : ""), channel_names[c]);
+    if (bits[c] == 0)
+    {
+      len += sprintf(description + len, "zero");
+    }
+    else if (get_scaled_bits(c))
+    {
+      len += sprintf(description + len, "%u bits scaled by %u", get_bit_depth(c) - get_scaled_bits(c), 1u << get_scaled_bits(c));
+    }
+    else
+    {
+      len += sprintf(description + len, "%u bits", get_bit_depth(c));
+    }
+  }
+  return TRUE;
+}
+
+LASbitdepth::LASbitdepth()
+{
+  has_channel[0] = has_channel[1] = has_channel[2] = FALSE;
+  version_minor = 0;
+  bits[0] = bits[1] = bits[2] = 0;
+}
@@ -0,0 +1,69 @@
+/*
+===============================================================================
+
+  FILE:  lasbitdepth.hpp
+
+  CONTENTS:
+
+    Finds the effective bit depth of the intensity, the RGB colors and the
+    NIR value of the points.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to detect 8 bit intensity and colors
+
+===============================================================================
+*/
+#ifndef LAS_BITDEPTH_HPP
+#define LAS_BITDEPTH_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#define LASBITDEPTH_INTENSITY 0
+#define LASBITDEPTH_RGB       1
+#define LASBITDEPTH_NIR       2
+
+class LASbitdepth
+{
+public:
+
+  void init(const LASheader* lasheader);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    bits[LASBITDEPTH_INTENSITY] |= laspoint->intensity;
+    bits[LASBITDEPTH_RGB] |= (laspoint->rgb[0] | laspoint->rgb[1] | laspoint->rgb[2]);
+    bits[LASBITDEPTH_NIR] |= laspoint->rgb[3];
+  };
+
+  void check(LASheader* lasheader) const;
+  BOOL get_bit_depth_description(CHAR* description) const;
+
+  U32 get_bit_depth(const U32 channel) const;
+  U32 get_scaled_bits(const U32 channel) const;
+
+  LASbitdepth();
+
+private:
+  BOOL has_channel[3];
+  I32 version_minor;
+  U32 bits[3];
+};
+
+#endif
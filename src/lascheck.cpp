@@ -29,12 +29,28 @@
 ===============================================================================
 */
 
+#include <stdio.h>
 #include <time.h>
+#include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "lascheck.hpp"
 
 #include "crscheck.hpp"
+#include "lasdensity.hpp"
+#include "lasvoids.hpp"
+#include "lasflightlines.hpp"
+#include "lasorder.hpp"
+#include "lasstatistics.hpp"
+#include "laswaveforms.hpp"
+#include "lasextrabytes.hpp"
+#include "lasclassification.hpp"
+#include "lasprecision.hpp"
+#include "lasbitdepth.hpp"
+#include "laspulses.hpp"
+#include "lasoffenders.hpp"
+#include "lasexport.hpp"
 
 static I32 lidardouble2string(CHAR* string, F64 value)
 {
@@ -77,21 +93,315 @@ static I32 lidardouble2string(CHAR* string, F64 value, F64 scale)
   return strlen(string)-1;
 };
 
+#ifdef _WIN32
+#define lascheck_fseek _fseeki64
+#define lascheck_ftell _ftelli64
+#else
+#define lascheck_fseek fseeko
+#define lascheck_ftell ftello
+#endif
+
+#define LASCHECK_EVLR_HEADER_SIZE 60
+#define LASCHECK_EVLR_READ_SIZE 65536
+
+// flight lines with fewer points are too short to judge their scan direction
+// and scan lines with fewer points on average mean the flag is random
+
+#define LASCHECK_MIN_SCAN_DIRECTION_POINTS 1000
+#define LASCHECK_MIN_SCAN_LINE_POINTS 10
+
+// reads the EVLR headers at the end of the file with one positioned read
+// that usually covers all of them and only seeks again for EVLR headers
+// that come after large EVLR payloads
+
+static void check_evlrs(LASheader* lasheader, const CHAR* file_name)
+{
+  CHAR note[512];
+
+  FILE* file = fopen(file_name, "rb");
+  if (file == 0)
+  {
+    return;
+  }
+
+  lascheck_fseek(file, 0, SEEK_END);
+  I64 file_size = (I64)lascheck_ftell(file);
+  I64 start = (I64)lasheader->start_of_first_extended_variable_length_record;
+
+  if (lasheader->number_of_extended_variable_length_records == 0)
+  {
+    if ((start != 0) && (start != file_size))
+    {
+#ifdef _WIN32
+      sprintf(note, "should be 0 or %I64d and not %I64d because there are no extended variable length records", file_size, start);
+#else
+      sprintf(note, "should be 0 or %lld and not %lld because there are no extended variable length records", file_size, start);
+#endif
+      lasheader->add_warning("start of first extended variable length record", note);
+    }
+    fclose(file);
+    return;
+  }
+
+  // the EVLRs come after the points whose size is only known when the file is not compressed
+
+  I64 end_of_points = (I64)lasheader->offset_to_point_data;
+  if (lasheader->laszip == 0)
+  {
+    U64 number_of_point_records = (lasheader->number_of_point_records ? lasheader->number_of_point_records : lasheader->legacy_number_of_point_records);
+    end_of_points += (I64)(number_of_point_records * lasheader->point_data_record_length);
+  }
+
+  if (start < end_of_points)
+  {
+#ifdef _WIN32
+    sprintf(note, "should be at least %I64d and not %I64d because the EVLRs must follow the point data", end_of_points, start);
+#else
+    sprintf(note, "should be at least %lld and not %lld because the EVLRs must follow the point data", end_of_points, start);
+#endif
+    lasheader->add_fail("start of first extended variable length record", note);
+    fclose(file);
+    return;
+  }
+
+  if ((start + LASCHECK_EVLR_HEADER_SIZE) > file_size)
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d is beyond the end of the file of %I64d bytes", start, file_size);
+#else
+    sprintf(note, "%lld is beyond the end of the file of %lld bytes", start, file_size);
+#endif
+    lasheader->add_fail("start of first extended variable length record", note);
+    fclose(file);
+    return;
+  }
+
+  // read the end of the file
+
+  I64 buffer_start = start;
+  I64 buffer_size = ((file_size - start) < LASCHECK_EVLR_READ_SIZE ? (file_size - start) : LASCHECK_EVLR_READ_SIZE);
+  U8* buffer = (U8*)malloc((size_t)buffer_size);
+  if ((buffer == 0) || (lascheck_fseek(file, buffer_start, SEEK_SET) != 0) || (fread(buffer, 1, (size_t)buffer_size, file) != (size_t)buffer_size))
+  {
+    if (buffer) free(buffer);
+    fclose(file);
+    return;
+  }
+
+  // walk the EVLR headers
+
+  U32 i;
+  U32 wkt_records = 0;
+  U32 geokey_records = 0;
+  I64 position = start;
+  U8 header[LASCHECK_EVLR_HEADER_SIZE];
+
+  for (i = 0; i < lasheader->number_of_extended_variable_length_records; i++)
+  {
+    if ((position + LASCHECK_EVLR_HEADER_SIZE) > file_size)
+    {
+#ifdef _WIN32
+      sprintf(note, "header of EVLR %u at offset %I64d is beyond the end of the file of %I64d bytes", i, position, file_size);
+#else
+      sprintf(note, "header of EVLR %u at offset %lld is beyond the end of the file of %lld bytes", i, position, file_size);
+#endif
+      lasheader->add_fail("extended variable length records", note);
+      break;
+    }
+
+    if ((position + LASCHECK_EVLR_HEADER_SIZE) <= (buffer_start + buffer_size))
+    {
+      memcpy(header, buffer + (position - buffer_start), LASCHECK_EVLR_HEADER_SIZE);
+    }
+    else if ((lascheck_fseek(file, position, SEEK_SET) != 0) || (fread(header, 1, LASCHECK_EVLR_HEADER_SIZE, file) != LASCHECK_EVLR_HEADER_SIZE))
+    {
+      break;
+    }
+
+    CHAR user_id[17];
+    U16 record_id;
+    I64 record_length_after_header;
+    memcpy(user_id, header + 2, 16);
+    user_id[16] = '\0';
+    memcpy(&record_id, header + 18, 2);
+    memcpy(&record_length_after_header, header + 20, 8);
+
+    if ((record_length_after_header < 0) || (record_length_after_header > (file_size - position - LASCHECK_EVLR_HEADER_SIZE)))
+    {
+#ifdef _WIN32
+      sprintf(note, "EVLR %u ('%s' %d) at offset %I64d with record length %I64d does not fit into the file of %I64d bytes", i, user_id, record_id, position, record_length_after_header, file_size);
+#else
+      sprintf(note, "EVLR %u ('%s' %d) at offset %lld with record length %lld does not fit into the file of %lld bytes", i, user_id, record_id, position, record_length_after_header, file_size);
+#endif
+      lasheader->add_fail("extended variable length records", note);
+      break;
+    }
+
+    if (strcmp(user_id, "LASF_Projection") == 0)
+    {
+      if (record_id == 2112) wkt_records++;
+      else if (record_id == 34735) geokey_records++;
+    }
+
+    position += LASCHECK_EVLR_HEADER_SIZE + record_length_after_header;
+  }
+
+  free(buffer);
+  fclose(file);
+
+  if ((i == lasheader->number_of_extended_variable_length_records) && (position < file_size))
+  {
+#ifdef _WIN32
+    sprintf(note, "there are %I64d bytes after the last of %u EVLRs", file_size - position, i);
+#else
+    sprintf(note, "there are %lld bytes after the last of %u EVLRs", file_size - position, i);
+#endif
+    lasheader->add_warning("extended variable length records", note);
+  }
+
+  // a CRS must not be stored twice
+
+  for (i = 0; i < lasheader->number_of_variable_length_records; i++)
+  {
+    if (strncmp(lasheader->vlrs[i].user_id, "LASF_Projection", 16) == 0)
+    {
+      if (lasheader->vlrs[i].record_id == 2112) wkt_records++;
+      else if (lasheader->vlrs[i].record_id == 34735) geokey_records++;
+    }
+  }
+
+  if (wkt_records > 1)
+  {
+    sprintf(note, "there are %u OGC WKT records in the VLRs and EVLRs but there should only be one", wkt_records);
+    lasheader->add_fail("extended variable length records", note);
+  }
+  if (geokey_records > 1)
+  {
+    sprintf(note, "there are %u GeoKeyDirectoryTag records in the VLRs and EVLRs but there should only be one", geokey_records);
+    lasheader->add_fail("extended variable length records", note);
+  }
+}
+
 void LAScheck::parse(const LASpoint* laspoint)
 {
   // add point to inventory
 
   lasinventory.add(laspoint);
 
+  // count classification and flags
+
+  lasclassification->add(laspoint);
+
+  // reduce the effective resolution of the coordinates
+
+  lasprecision->add(laspoint);
+
+  // accumulate the bits used by intensity and colors
+
+  lasbitdepth->add(laspoint);
+
   // check point against bounding box
 
-  if (!laspoint->inside_bounding_box(min_x, min_y, min_z, max_x, max_y, max_z))
+  BOOL outside_bounding_box = !laspoint->inside_bounding_box(min_x, min_y, min_z, max_x, max_y, max_z);
+  if (outside_bounding_box)
   {
     points_outside_bounding_box++;
   }
+
+  // maybe remember the points that break point level rules
+
+  if (lasoffenders)
+  {
+    U32 rules = lasoffenders->test(laspoint, outside_bounding_box);
+    if (rules)
+    {
+      lasoffenders->add(rules, point_index, laspoint);
+      if (lasexport && !lasexport->write(laspoint, (U8)rules))
+      {
+        // stop exporting after the first failed write
+
+        lasexport->close();
+        delete lasexport;
+        lasexport = 0;
+      }
+    }
+    point_index++;
+  }
+
+  // maybe add point to density grid
+
+  if (lasdensity)
+  {
+    lasdensity->add(laspoint);
+  }
+
+  // maybe add point to occupancy bitmap
+
+  if (lasvoids)
+  {
+    lasvoids->add(laspoint);
+  }
+
+  // maybe add point to its flight line
+
+  if (lasflightlines)
+  {
+    lasflightlines->add(laspoint);
+  }
+
+  // maybe add point to its pulse
+
+  if (laspulses)
+  {
+    laspulses->add(laspoint);
+  }
+
+  // maybe measure coherence of point order
+
+  if (lasorder)
+  {
+    lasorder->add(laspoint);
+  }
+
+  // maybe add point to attribute histograms
+
+  if (lasstatistics)
+  {
+    lasstatistics->add(laspoint);
+  }
+
+  // maybe check range of waveform packet
+
+  if (laswaveforms)
+  {
+    laswaveforms->add(laspoint);
+  }
+
+  // maybe decode extra bytes
+
+  if (lasextrabytes)
+  {
+    lasextrabytes->add(laspoint);
+  }
+
+  // maybe sample point for checking it against the CRS
+
+  if (crs_sample_x)
+  {
+    if (--crs_sample_countdown == 0)
+    {
+      if (crs_sample_number < crs_sample_size)
+      {
+        crs_sample_x[crs_sample_number] = laspoint->get_x();
+        crs_sample_y[crs_sample_number] = laspoint->get_y();
+        crs_sample_number++;
+      }
+      crs_sample_countdown = crs_sample_stride;
+    }
+  }
 }
 
-void LAScheck::check(LASheader* lasheader, CHAR* crsdescription)
+void LAScheck::check(LASheader* lasheader, CHAR* crsdescription, const CHAR* file_name)
 {
   U32 i,j;
   CHAR note[512];
@@ -741,25 +1051,25 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription)
     }
   }
 
+  // check extended variable length records at the end of the file
+
+  if ((lasheader->version_major == 1) && (lasheader->version_minor >= 4) && file_name)
+  {
+    check_evlrs(lasheader, file_name);
+  }
+
   // check for resolution fluff in the coordinates
 
   if (lasinventory.is_active())
   {
-    if (lasinventory.has_fluff())
-    {
-      sprintf(note, "resolution fluff (x10) in %s%s%s\012", (lasinventory.has_fluff(0) ? "X" : ""), (lasinventory.has_fluff(1) ? "Y" : ""), (lasinventory.has_fluff(2) ? "Z" : ""));
-      lasheader->add_warning("coordinate values", note);
-      if (lasinventory.has_serious_fluff())
-      {
-        sprintf(note, "serious resolution fluff (x100) in %s%s%s\012", (lasinventory.has_serious_fluff(0) ? "X" : ""), (lasinventory.has_serious_fluff(1) ? "Y" : ""), (lasinventory.has_serious_fluff(2) ? "Z" : ""));
-        lasheader->add_warning("coordinate values", note);
-        if (lasinventory.has_very_serious_fluff())
-        {
-          sprintf(note, "very serious resolution fluff (x1000) in %s%s%s\012", (lasinventory.has_very_serious_fluff(0) ? "X" : ""), (lasinventory.has_very_serious_fluff(1) ? "Y" : ""), (lasinventory.has_very_serious_fluff(2) ? "Z" : ""));
-          lasheader->add_warning("coordinate values", note);
-        }
-      }
-    }
+    lasprecision->check(lasheader);
+  }
+
+  // check for intensities and colors that were not scaled to 16 bits
+
+  if (lasinventory.is_active())
+  {
+    lasbitdepth->check(lasheader);
   }
 
   // check bounding box x y z
@@ -968,6 +1278,214 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription)
     }
   }
 
+  // check the aggregate nominal pulse density of the first returns
+
+  if (lasdensity && lasinventory.is_active())
+  {
+    F64 mean_density, lowest_density, highest_density, fraction_below;
+    if (lasdensity->get_statistics(min_density, &mean_density, &lowest_density, &highest_density, &fraction_below))
+    {
+      if (mean_density < min_density)
+      {
+        sprintf(note, "aggregate nominal pulse density is %.2f and not at least %g first returns per square unit", mean_density, min_density);
+        lasheader->add_fail("point density", note);
+      }
+      if (fraction_below > 0.0)
+      {
+        sprintf(note, "%.1f%% of the %g by %g cells have a first return density below %g", 100.0*fraction_below, lasdensity->get_cell_size(), lasdensity->get_cell_size(), min_density);
+        lasheader->add_warning("point density", note);
+      }
+    }
+  }
+
+  // check for data voids larger than a multiple of the nominal point spacing
+
+  if (lasvoids && lasinventory.is_active())
+  {
+    F64 min_void_size = void_multiple * nominal_point_spacing;
+    U32 number_voids = lasvoids->find(min_void_size * min_void_size);
+    for (i = 0; (i < number_voids) && (i < 10); i++)
+    {
+      const LASvoid* v = lasvoids->get_void(i);
+      sprintf(note, "void of %.1f square units from (%.2f/%.2f) to (%.2f/%.2f) is larger than %g times the nominal point spacing of %.2f", v->area, v->min_x, v->min_y, v->max_x, v->max_y, void_multiple, nominal_point_spacing);
+      lasheader->add_warning("data void", note);
+    }
+    if (number_voids > 10)
+    {
+      sprintf(note, "there are %u more voids larger than %g times the nominal point spacing of %.2f", number_voids - 10, void_multiple, nominal_point_spacing);
+      lasheader->add_warning("data void", note);
+    }
+  }
+
+  // check the GPS time order and the GPS time gaps of every flight line
+
+  if (lasflightlines && lasflightlines->is_gps_time_analysis() && lasinventory.is_active())
+  {
+    U32 number_of_flightlines = lasflightlines->get_number_of_flightlines();
+    for (i = 0; i < number_of_flightlines; i++)
+    {
+      const LASflightline* line = lasflightlines->get_flightline(i);
+      if (line->out_of_order_runs)
+      {
+#ifdef _WIN32
+        sprintf(note, "GPS time of the %I64d points with point source ID %u steps backwards %I64d times", line->number_of_points, (U32)line->point_source_ID, line->out_of_order_runs);
+#else
+        sprintf(note, "GPS time of the %lld points with point source ID %u steps backwards %lld times", line->number_of_points, (U32)line->point_source_ID, line->out_of_order_runs);
+#endif
+        lasheader->add_warning("GPS time order", note);
+      }
+      if (line->number_of_gaps)
+      {
+#ifdef _WIN32
+        sprintf(note, "GPS time of the points with point source ID %u has %I64d gaps larger than %g seconds. largest is %.3f seconds after %.6f", (U32)line->point_source_ID, line->number_of_gaps, lasflightlines->get_max_gps_time_gap(), line->largest_gap, line->largest_gap_start);
+#else
+        sprintf(note, "GPS time of the points with point source ID %u has %lld gaps larger than %g seconds. largest is %.3f seconds after %.6f", (U32)line->point_source_ID, line->number_of_gaps, lasflightlines->get_max_gps_time_gap(), line->largest_gap, line->largest_gap_start);
+#endif
+        lasheader->add_warning("GPS time gap", note);
+      }
+    }
+  }
+
+  // check the scan direction and edge of flight line flags of every flight line
+
+  if (lasflightlines && lasflightlines->is_scan_direction_analysis() && lasinventory.is_active())
+  {
+    U32 number_of_flightlines = lasflightlines->get_number_of_flightlines();
+    for (i = 0; i < number_of_flightlines; i++)
+    {
+      const LASflightline* line = lasflightlines->get_flightline(i);
+      if (line->number_of_points < LASCHECK_MIN_SCAN_DIRECTION_POINTS)
+      {
+        continue;
+      }
+      if (line->scan_direction_reversals == 0)
+      {
+#ifdef _WIN32
+        sprintf(note, "scan direction flag of the %I64d points with point source ID %u never changes", line->number_of_points, (U32)line->point_source_ID);
+#else
+        sprintf(note, "scan direction flag of the %lld points with point source ID %u never changes", line->number_of_points, (U32)line->point_source_ID);
+#endif
+        lasheader->add_warning("scan direction", note);
+      }
+      else if (line->scan_direction_reversals * LASCHECK_MIN_SCAN_LINE_POINTS > line->number_of_points)
+      {
+#ifdef _WIN32
+        sprintf(note, "scan direction flag of the points with point source ID %u changes %I64d times or every %.1f points which looks random", (U32)line->point_source_ID, line->scan_direction_reversals, (F64)line->number_of_points / line->scan_direction_reversals);
+#else
+        sprintf(note, "scan direction flag of the points with point source ID %u changes %lld times or every %.1f points which looks random", (U32)line->point_source_ID, line->scan_direction_reversals, (F64)line->number_of_points / line->scan_direction_reversals);
+#endif
+        lasheader->add_warning("scan direction", note);
+      }
+      if (line->edges_of_flight_line == line->number_of_points)
+      {
+#ifdef _WIN32
+        sprintf(note, "edge of flight line flag is set for all %I64d points with point source ID %u", line->number_of_points, (U32)line->point_source_ID);
+#else
+        sprintf(note, "edge of flight line flag is set for all %lld points with point source ID %u", line->number_of_points, (U32)line->point_source_ID);
+#endif
+        lasheader->add_warning("edge of flight line", note);
+      }
+      else if (line->scan_direction_reversals && (line->edges_of_flight_line == 0))
+      {
+#ifdef _WIN32
+        sprintf(note, "edge of flight line flag is never set although the scan direction of the points with point source ID %u reverses %I64d times", (U32)line->point_source_ID, line->scan_direction_reversals);
+#else
+        sprintf(note, "edge of flight line flag is never set although the scan direction of the points with point source ID %u reverses %lld times", (U32)line->point_source_ID, line->scan_direction_reversals);
+#endif
+        lasheader->add_warning("edge of flight line", note);
+      }
+      else if (2*line->edges_at_reversals < line->scan_direction_reversals)
+      {
+#ifdef _WIN32
+        sprintf(note, "only %I64d of %I64d scan direction reversals of the points with point source ID %u have the edge of flight line flag set before them. %I64d flags are elsewhere", line->edges_at_reversals, line->scan_direction_reversals, (U32)line->point_source_ID, line->edges_of_flight_line - line->edges_at_reversals);
+#else
+        sprintf(note, "only %lld of %lld scan direction reversals of the points with point source ID %u have the edge of flight line flag set before them. %lld flags are elsewhere", line->edges_at_reversals, line->scan_direction_reversals, (U32)line->point_source_ID, line->edges_of_flight_line - line->edges_at_reversals);
+#endif
+        lasheader->add_warning("edge of flight line", note);
+      }
+    }
+  }
+
+  // put the sampled offenders in the order of the points
+
+  if (lasoffenders)
+  {
+    lasoffenders->done();
+  }
+
+  // finish the file with the offending points
+
+  if (lasexport)
+  {
+    lasexport->close();
+  }
+
+  // check whether the pulses have all their returns
+
+  if (laspulses && lasinventory.is_active())
+  {
+    laspulses->done();
+    if (!laspulses->is_unordered())
+    {
+      if (laspulses->get_number_incomplete())
+      {
+#ifdef _WIN32
+        sprintf(note, "%I64d of %I64d pulses are missing some of their returns", laspulses->get_number_incomplete(), laspulses->get_number_of_pulses());
+#else
+        sprintf(note, "%lld of %lld pulses are missing some of their returns", laspulses->get_number_incomplete(), laspulses->get_number_of_pulses());
+#endif
+        lasheader->add_warning("pulses", note);
+      }
+      if (laspulses->get_number_duplicate())
+      {
+#ifdef _WIN32
+        sprintf(note, "%I64d of %I64d pulses have the same return number more than once", laspulses->get_number_duplicate(), laspulses->get_number_of_pulses());
+#else
+        sprintf(note, "%lld of %lld pulses have the same return number more than once", laspulses->get_number_duplicate(), laspulses->get_number_of_pulses());
+#endif
+
+        // without a scanner channel the returns of several channels can end up in one pulse
+
+        if (laspulses->has_scanner_channel())
+        {
+          lasheader->add_fail("pulses", note);
+        }
+        else
+        {
+          lasheader->add_warning("pulses", note);
+        }
+      }
+      if (laspulses->get_number_inconsistent())
+      {
+#ifdef _WIN32
+        sprintf(note, "%I64d of %I64d pulses have returns that disagree on their number of returns", laspulses->get_number_inconsistent(), laspulses->get_number_of_pulses());
+#else
+        sprintf(note, "%lld of %lld pulses have returns that disagree on their number of returns", laspulses->get_number_inconsistent(), laspulses->get_number_of_pulses());
+#endif
+        if (laspulses->has_scanner_channel())
+        {
+          lasheader->add_fail("pulses", note);
+        }
+        else
+        {
+          lasheader->add_warning("pulses", note);
+        }
+      }
+    }
+  }
+
+  // check whether the points are stored in a coherent order
+
+  if (lasorder && lasinventory.is_active())
+  {
+    F64 average_morton_distance, fraction_same_coarse_cell, fraction_gps_time_not_decreasing;
+    if (lasorder->classify(&average_morton_distance, &fraction_same_coarse_cell, &fraction_gps_time_not_decreasing) == LASORDER_UNORDERED)
+    {
+      sprintf(note, "points are neither GPS time sorted nor spatially sorted. only %.1f%% of consecutive points share one of 64 by 64 cells and their Morton codes are on average %.3f apart", 100.0*fraction_same_coarse_cell, average_morton_distance);
+      lasheader->add_warning("point order", note);
+    }
+  }
+
   // check for zero point source IDs
 
   if (lasinventory.is_active())
@@ -1061,11 +1579,448 @@ void LAScheck::check(LASheader* lasheader, CHAR* crsdescription)
     }
   }
 
+  // check byte ranges of waveform packets
+
+  if (laswaveforms && lasinventory.is_active())
+  {
+    if (laswaveforms->is_missing())
+    {
+      sprintf(note, "global encoding bit 2 is set but the external waveform data file '%s' does not exist", laswaveforms->get_file_name());
+      lasheader->add_fail("waveform data packets", note);
+    }
+    else
+    {
+      if (laswaveforms->get_number_outside())
+      {
+#ifdef _WIN32
+        sprintf(note, "%I64d of %I64d packets are outside of the %I64d bytes of %s waveform data (first at offset %I64d with size %u)", laswaveforms->get_number_outside(), laswaveforms->get_number_of_packets(), (I64)laswaveforms->get_data_size(), (laswaveforms->is_external() ? "external" : "internal"), (I64)laswaveforms->get_first_outside_start(), laswaveforms->get_first_outside_size());
+#else
+        sprintf(note, "%lld of %lld packets are outside of the %lld bytes of %s waveform data (first at offset %lld with size %u)", laswaveforms->get_number_outside(), laswaveforms->get_number_of_packets(), (I64)laswaveforms->get_data_size(), (laswaveforms->is_external() ? "external" : "internal"), (I64)laswaveforms->get_first_outside_start(), laswaveforms->get_first_outside_size());
+#endif
+        lasheader->add_fail("waveform data packets", note);
+      }
+      if (laswaveforms->get_number_wrong_size())
+      {
+#ifdef _WIN32
+        sprintf(note, "%I64d of %I64d packets have a size that does not match their wave packet descriptor", laswaveforms->get_number_wrong_size(), laswaveforms->get_number_of_packets());
+#else
+        sprintf(note, "%lld of %lld packets have a size that does not match their wave packet descriptor", laswaveforms->get_number_wrong_size(), laswaveforms->get_number_of_packets());
+#endif
+        lasheader->add_warning("waveform data packets", note);
+      }
+      I64 overlaps = laswaveforms->find_overlaps();
+      if (overlaps)
+      {
+#ifdef _WIN32
+        sprintf(note, "%I64d runs of packets overlap other packets in the waveform data", overlaps);
+#else
+        sprintf(note, "%lld runs of packets overlap other packets in the waveform data", overlaps);
+#endif
+        lasheader->add_warning("waveform data packets", note);
+      }
+    }
+  }
+
+  // check for reserved classifications and flagged points
+
+  if (lasinventory.is_active())
+  {
+    lasclassification->check(lasheader);
+  }
+
+  // check extra bytes and their Extra Bytes VLR
+
+  if (lasextrabytes)
+  {
+    lasextrabytes->check(lasheader, lasinventory.is_active());
+  }
+
   if (lasheader->geokeys || lasheader->ogc_wkt)
   {
     CRScheck crscheck;
     crscheck.check(lasheader, crsdescription);
+
+    // maybe inverse project the sampled points
+
+    if (crs_sample_number)
+    {
+      has_footprint = crscheck.check_sample(lasheader, crs_sample_number, crs_sample_x, crs_sample_y, footprint);
+    }
+  }
+}
+
+BOOL LAScheck::set_density(const LASheader* lasheader, F64 cell_size, F64 min_density)
+{
+  if (lasdensity == 0)
+  {
+    lasdensity = new LASdensity();
+  }
+  if (!lasdensity->init(lasheader, cell_size))
+  {
+    delete lasdensity;
+    lasdensity = 0;
+    return FALSE;
+  }
+  this->min_density = min_density;
+  return TRUE;
+}
+
+BOOL LAScheck::get_density_description(CHAR* description) const
+{
+  F64 mean_density, lowest_density, highest_density, fraction_below;
+  if ((lasdensity == 0) || !lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  if (!lasdensity->get_statistics(min_density, &mean_density, &lowest_density, &highest_density, &fraction_below))
+  {
+    return FALSE;
+  }
+  sprintf(description, "%.2f first returns per square unit (lowest %.2f highest %.2f) with %.1f%% of %g by %g cells below %g", mean_density, lowest_density, highest_density, 100.0*fraction_below, lasdensity->get_cell_size(), lasdensity->get_cell_size(), min_density);
+  return TRUE;
+}
+
+BOOL LAScheck::set_voids(const LASheader* lasheader, F64 multiple, F64 nominal_point_spacing)
+{
+  if (nominal_point_spacing <= 0.0)
+  {
+    // estimate the nominal point spacing from the first returns in the header
+
+    F64 number_of_first_returns;
+    if ((lasheader->version_major == 1) && (lasheader->version_minor >= 4))
+    {
+      number_of_first_returns = (F64)(lasheader->number_of_points_by_return[0] ? lasheader->number_of_points_by_return[0] : lasheader->number_of_point_records);
+    }
+    else
+    {
+      number_of_first_returns = (F64)(lasheader->legacy_number_of_points_by_return[0] ? lasheader->legacy_number_of_points_by_return[0] : lasheader->legacy_number_of_point_records);
+    }
+    F64 area = (lasheader->max_x - lasheader->min_x) * (lasheader->max_y - lasheader->min_y);
+    if ((number_of_first_returns <= 0.0) || (area <= 0.0))
+    {
+      return FALSE;
+    }
+    nominal_point_spacing = sqrt(area / number_of_first_returns);
+  }
+
+  // cells of twice the spacing are rarely empty unless there is a void
+
+  if (lasvoids == 0)
+  {
+    lasvoids = new LASvoids();
+  }
+  if (!lasvoids->init(lasheader, 2.0 * nominal_point_spacing))
+  {
+    delete lasvoids;
+    lasvoids = 0;
+    return FALSE;
+  }
+  this->void_multiple = multiple;
+  this->nominal_point_spacing = nominal_point_spacing;
+  return TRUE;
+}
+
+BOOL LAScheck::set_gps_time_analysis(const LASheader* lasheader, F64 max_gps_time_gap)
+{
+  // point data formats 0 and 2 have no GPS time
+
+  if ((lasheader->point_data_format == 0) || (lasheader->point_data_format == 2))
+  {
+    return FALSE;
+  }
+  if (lasflightlines == 0)
+  {
+    lasflightlines = new LASflightlines();
+    lasflightlines->init(lasheader);
+  }
+  lasflightlines->set_max_gps_time_gap(max_gps_time_gap);
+  return TRUE;
+}
+
+BOOL LAScheck::set_scan_direction_check(const LASheader* lasheader)
+{
+  // reversals can only be found with the GPS time order of the points
+
+  if ((lasheader->point_data_format == 0) || (lasheader->point_data_format == 2))
+  {
+    return FALSE;
+  }
+  if (lasflightlines == 0)
+  {
+    lasflightlines = new LASflightlines();
+    lasflightlines->init(lasheader);
+  }
+  lasflightlines->set_scan_direction_analysis(TRUE);
+  return TRUE;
+}
+
+BOOL LAScheck::set_flightline_summary(const LASheader* lasheader)
+{
+  if (lasflightlines == 0)
+  {
+    lasflightlines = new LASflightlines();
+    lasflightlines->init(lasheader);
+  }
+  lasflightlines->set_summary(TRUE);
+  return TRUE;
+}
+
+BOOL LAScheck::write_flightlines(XMLwriter& xmlwriter) const
+{
+  if ((lasflightlines == 0) || !lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  return lasflightlines->write(xmlwriter);
+}
+
+BOOL LAScheck::set_point_order(const LASheader* lasheader)
+{
+  if (lasorder == 0)
+  {
+    lasorder = new LASorder();
+  }
+  if (!lasorder->init(lasheader))
+  {
+    delete lasorder;
+    lasorder = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LAScheck::get_point_order_description(CHAR* description) const
+{
+  F64 average_morton_distance, fraction_same_coarse_cell, fraction_gps_time_not_decreasing;
+  if ((lasorder == 0) || !lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  I32 order = lasorder->classify(&average_morton_distance, &fraction_same_coarse_cell, &fraction_gps_time_not_decreasing);
+  if (order == LASORDER_UNKNOWN)
+  {
+    return FALSE;
+  }
+  sprintf(description, "%s (%.1f%% in same cell, %.1f%% in GPS time order, Morton distance %.4f)", (order == LASORDER_GPS_TIME_SORTED ? "GPS time sorted" : (order == LASORDER_SPATIALLY_SORTED ? "spatially sorted" : "unordered")), 100.0*fraction_same_coarse_cell, 100.0*fraction_gps_time_not_decreasing, average_morton_distance);
+  return TRUE;
+}
+
+BOOL LAScheck::set_statistics(const LASheader* lasheader)
+{
+  if (lasstatistics == 0)
+  {
+    lasstatistics = new LASstatistics();
+  }
+  if (!lasstatistics->init(lasheader))
+  {
+    delete lasstatistics;
+    lasstatistics = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LAScheck::write_statistics(XMLwriter& xmlwriter) const
+{
+  if ((lasstatistics == 0) || !lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  return lasstatistics->write(xmlwriter);
+}
+
+BOOL LAScheck::set_crs_sample(const LASheader* lasheader, U32 size)
+{
+  if (size == 0)
+  {
+    return FALSE;
+  }
+
+  // spread the sample evenly over the points announced in the header
+
+  U64 number_of_point_records = (lasheader->number_of_point_records ? lasheader->number_of_point_records : lasheader->legacy_number_of_point_records);
+  U64 stride = number_of_point_records / size;
+  if (crs_sample_x) free(crs_sample_x);
+  if (crs_sample_y) free(crs_sample_y);
+  crs_sample_x = (F64*)malloc(sizeof(F64)*size);
+  crs_sample_y = (F64*)malloc(sizeof(F64)*size);
+  if ((crs_sample_x == 0) || (crs_sample_y == 0))
+  {
+    fprintf(stderr, "ERROR: cannot allocate sample of %u points\n", size);
+    if (crs_sample_x) free(crs_sample_x);
+    if (crs_sample_y) free(crs_sample_y);
+    crs_sample_x = crs_sample_y = 0;
+    return FALSE;
+  }
+  crs_sample_size = size;
+  crs_sample_number = 0;
+  crs_sample_stride = (stride > 1 ? (stride < U32_MAX ? (U32)stride : U32_MAX) : 1);
+  crs_sample_countdown = 1;
+  return TRUE;
+}
+
+BOOL LAScheck::get_footprint_description(CHAR* description) const
+{
+  if (!has_footprint || !lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  sprintf(description, "longitude %.6f to %.6f and latitude %.6f to %.6f from %u sampled points", footprint[0], footprint[2], footprint[1], footprint[3], crs_sample_number);
+  return TRUE;
+}
+
+BOOL LAScheck::set_waveform_check(const LASheader* lasheader, const CHAR* file_name)
+{
+  if (laswaveforms == 0)
+  {
+    laswaveforms = new LASwaveforms();
+  }
+  if (!laswaveforms->init(lasheader, file_name))
+  {
+    delete laswaveforms;
+    laswaveforms = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LAScheck::set_extra_bytes(const LASheader* lasheader)
+{
+  if (lasextrabytes == 0)
+  {
+    lasextrabytes = new LASextrabytes();
+  }
+  if (!lasextrabytes->init(lasheader))
+  {
+    delete lasextrabytes;
+    lasextrabytes = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LAScheck::write_extra_bytes(XMLwriter& xmlwriter) const
+{
+  if ((lasextrabytes == 0) || !lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  return lasextrabytes->write(xmlwriter);
+}
+
+BOOL LAScheck::get_flags_description(CHAR* description) const
+{
+  if (!lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  return lasclassification->get_flags_description(description);
+}
+
+BOOL LAScheck::get_precision_description(CHAR* description) const
+{
+  if (!lasinventory.is_active())
+  {
+    return FALSE;
   }
+  return lasprecision->get_precision_description(description);
+}
+
+BOOL LAScheck::get_bit_depth_description(CHAR* description) const
+{
+  if (!lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  return lasbitdepth->get_bit_depth_description(description);
+}
+
+BOOL LAScheck::set_offenders(const LASheader* lasheader, U32 capture)
+{
+  if (lasoffenders == 0)
+  {
+    lasoffenders = new LASoffenders();
+  }
+  if (!lasoffenders->init(lasheader, capture))
+  {
+    delete lasoffenders;
+    lasoffenders = 0;
+    return FALSE;
+  }
+  point_index = 0;
+  return TRUE;
+}
+
+BOOL LAScheck::set_export_offenders(const LASheader* lasheader, const CHAR* directory, const CHAR* file_name)
+{
+  if ((directory == 0) || (file_name == 0))
+  {
+    return FALSE;
+  }
+
+  // the rules are tested by the offenders even when none are captured
+
+  if (lasoffenders == 0)
+  {
+    if (!set_offenders(lasheader, 0))
+    {
+      return FALSE;
+    }
+  }
+  if (lasexport == 0)
+  {
+    lasexport = new LASexport();
+  }
+  if (!lasexport->open(lasheader, directory, file_name))
+  {
+    delete lasexport;
+    lasexport = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LAScheck::write_offenders(XMLwriter& xmlwriter) const
+{
+  if ((lasoffenders == 0) || !lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  return lasoffenders->write(xmlwriter);
+}
+
+BOOL LAScheck::set_pulse_check(const LASheader* lasheader)
+{
+  if (laspulses == 0)
+  {
+    laspulses = new LASpulses();
+  }
+  if (!laspulses->init(lasheader))
+  {
+    delete laspulses;
+    laspulses = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LAScheck::get_pulse_description(CHAR* description) const
+{
+  if ((laspulses == 0) || !lasinventory.is_active())
+  {
+    return FALSE;
+  }
+  if (laspulses->is_unordered())
+  {
+    sprintf(description, "not reconstructed because the points are not in GPS time order");
+    return TRUE;
+  }
+#ifdef _WIN32
+  sprintf(description, "%I64d pulses with %I64d incomplete %I64d with duplicate returns %I64d with inconsistent number of returns", laspulses->get_number_of_pulses(), laspulses->get_number_incomplete(), laspulses->get_number_duplicate(), laspulses->get_number_inconsistent());
+#else
+  sprintf(description, "%lld pulses with %lld incomplete %lld with duplicate returns %lld with inconsistent number of returns", laspulses->get_number_of_pulses(), laspulses->get_number_incomplete(), laspulses->get_number_duplicate(), laspulses->get_number_inconsistent());
+#endif
+  return TRUE;
 }
 
 LAScheck::LAScheck(const LASheader* lasheader)
@@ -1077,8 +2032,50 @@ LAScheck::LAScheck(const LASheader* lasheader)
   max_y = lasheader->max_y + 2.0*lasheader->y_scale_factor;
   max_z = lasheader->max_z + 2.0*lasheader->z_scale_factor;
   points_outside_bounding_box = 0;
+  lasclassification = new LASclassification();
+  lasclassification->init(lasheader);
+  lasprecision = new LASprecision();
+  lasprecision->init(lasheader);
+  lasbitdepth = new LASbitdepth();
+  lasbitdepth->init(lasheader);
+  lasdensity = 0;
+  min_density = 0.0;
+  lasvoids = 0;
+  void_multiple = 0.0;
+  nominal_point_spacing = 0.0;
+  lasflightlines = 0;
+  laspulses = 0;
+  lasoffenders = 0;
+  lasexport = 0;
+  point_index = 0;
+  lasorder = 0;
+  lasstatistics = 0;
+  laswaveforms = 0;
+  lasextrabytes = 0;
+  crs_sample_size = 0;
+  crs_sample_number = 0;
+  crs_sample_stride = 1;
+  crs_sample_countdown = 1;
+  crs_sample_x = 0;
+  crs_sample_y = 0;
+  has_footprint = FALSE;
 }
 
 LAScheck::~LAScheck()
 {
+  delete lasclassification;
+  delete lasprecision;
+  delete lasbitdepth;
+  if (lasdensity) delete lasdensity;
+  if (lasvoids) delete lasvoids;
+  if (lasflightlines) delete lasflightlines;
+  if (laspulses) delete laspulses;
+  if (lasoffenders) delete lasoffenders;
+  if (lasexport) delete lasexport;
+  if (lasorder) delete lasorder;
+  if (lasstatistics) delete lasstatistics;
+  if (laswaveforms) delete laswaveforms;
+  if (lasextrabytes) delete lasextrabytes;
+  if (crs_sample_x) free(crs_sample_x);
+  if (crs_sample_y) free(crs_sample_y);
 }
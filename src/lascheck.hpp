@@ -25,6 +25,18 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- export the offending points to a LAS file in the same pass
+    18 October 2026 -- capture the first and a sample of the offending points
+    18 October 2026 -- detect 8 bit intensity, RGB and NIR in 16 bit fields
+    18 October 2026 -- measure the exact coordinate resolution instead of fluff tiers
+    18 October 2026 -- check scan direction and edge of flight line flags
+    18 October 2026 -- optional per flight line summary keyed by point source ID
+    18 October 2026 -- reconstruct pulses to check that no returns are missing
+    18 October 2026 -- count classifications and point flags
+    18 October 2026 -- decode and check the extra bytes of the points
+    18 October 2026 -- check the waveform packets that the points reference
+    18 October 2026 -- validate the EVLRs at the end of LAS 1.4 files
+    18 October 2026 -- optional point pass analytics for acceptance QA
     1 April 2013 -- on Easter Monday all-nighting in Perth airport for PER->SYD
   
 ===============================================================================
@@ -36,6 +48,21 @@
 #include "laspoint.hpp"
 #include "lasutility.hpp"
 
+class LASdensity;
+class LASvoids;
+class LASflightlines;
+class LASorder;
+class LASstatistics;
+class LASwaveforms;
+class LASextrabytes;
+class LASclassification;
+class LASprecision;
+class LASbitdepth;
+class LASpulses;
+class LASoffenders;
+class LASexport;
+class XMLwriter;
+
 #define LASCHECK_VERSION_MAJOR 0
 #define LASCHECK_VERSION_MINOR 0
 #define LASCHECK_BUILD_DATE  140513
@@ -45,7 +72,32 @@ class LAScheck
 public:
 
   void parse(const LASpoint* laspoint);
-  void check(LASheader* lasheader, CHAR* crsdescription=0);
+  void check(LASheader* lasheader, CHAR* crsdescription=0, const CHAR* file_name=0);
+
+  BOOL set_density(const LASheader* lasheader, F64 cell_size, F64 min_density);
+  BOOL get_density_description(CHAR* description) const;
+  BOOL set_voids(const LASheader* lasheader, F64 multiple, F64 nominal_point_spacing=0.0);
+  BOOL set_gps_time_analysis(const LASheader* lasheader, F64 max_gps_time_gap);
+  BOOL set_flightline_summary(const LASheader* lasheader);
+  BOOL set_scan_direction_check(const LASheader* lasheader);
+  BOOL write_flightlines(XMLwriter& xmlwriter) const;
+  BOOL set_point_order(const LASheader* lasheader);
+  BOOL get_point_order_description(CHAR* description) const;
+  BOOL set_statistics(const LASheader* lasheader);
+  BOOL write_statistics(XMLwriter& xmlwriter) const;
+  BOOL set_crs_sample(const LASheader* lasheader, U32 size);
+  BOOL set_waveform_check(const LASheader* lasheader, const CHAR* file_name);
+  BOOL set_extra_bytes(const LASheader* lasheader);
+  BOOL write_extra_bytes(XMLwriter& xmlwriter) const;
+  BOOL get_flags_description(CHAR* description) const;
+  BOOL get_precision_description(CHAR* description) const;
+  BOOL get_bit_depth_description(CHAR* description) const;
+  BOOL set_pulse_check(const LASheader* lasheader);
+  BOOL get_pulse_description(CHAR* description) const;
+  BOOL set_offenders(const LASheader* lasheader, U32 capture);
+  BOOL write_offenders(XMLwriter& xmlwriter) const;
+  BOOL set_export_offenders(const LASheader* lasheader, const CHAR* directory, const CHAR* file_name);
+  BOOL get_footprint_description(CHAR* description) const;
 
   LAScheck(const LASheader* lasheader);
   ~LAScheck();
@@ -55,6 +107,31 @@ private:
   F64 max_x, max_y, max_z;
   I64 points_outside_bounding_box;
   LASinventory lasinventory;
+  LASclassification* lasclassification;
+  LASprecision* lasprecision;
+  LASbitdepth* lasbitdepth;
+  LASdensity* lasdensity;
+  F64 min_density;
+  LASvoids* lasvoids;
+  F64 void_multiple;
+  F64 nominal_point_spacing;
+  LASflightlines* lasflightlines;
+  LASpulses* laspulses;
+  LASoffenders* lasoffenders;
+  LASexport* lasexport;
+  I64 point_index;
+  LASorder* lasorder;
+  LASstatistics* lasstatistics;
+  LASwaveforms* laswaveforms;
+  LASextrabytes* lasextrabytes;
+  U32 crs_sample_size;
+  U32 crs_sample_number;
+  U32 crs_sample_stride;
+  U32 crs_sample_countdown;
+  F64* crs_sample_x;
+  F64* crs_sample_y;
+  BOOL has_footprint;
+  F64 footprint[4];
 };
 
 #endif
@@ -0,0 +1,193 @@
+/*
+===============================================================================
+
+  FILE:  lasclassification.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "lasclassification.hpp"
+
+// the ASPRS classes defined for point data formats 0 to 5 and 6 to 10
+
+#define LASCLASSIFICATION_LAST_LEGACY        12
+#define LASCLASSIFICATION_LAST_EXTENDED      22
+#define LASCLASSIFICATION_LAST_RESERVED      63
+#define LASCLASSIFICATION_OVERLAP_CLASS      12
+#define LASCLASSIFICATION_MAX_LISTED         16
+
+void LASclassification::init(const LASheader* lasheader)
+{
+  extended = (lasheader->point_data_format >= 6);
+  version_minor = lasheader->version_minor;
+  point_data_format = lasheader->point_data_format;
+  memset(counts, 0, sizeof(counts));
+}
+
+void LASclassification::count(I64* classes, I64* flags) const
+{
+  U32 index;
+  memset(classes, 0, sizeof(I64)*256);
+  memset(flags, 0, sizeof(I64)*16);
+  for (index = 0; index < 4096; index++)
+  {
+    classes[index & 255] += counts[index];
+    flags[index >> 8] += counts[index];
+  }
+}
+
+void LASclassification::check(LASheader* lasheader) const
+{
+  I64 classes[256];
+  I64 flags[16];
+  CHAR note[512];
+  U32 c, f;
+
+  // LAS 1.0 neither reserves classes nor has point flags
+
+  if (version_minor == 0)
+  {
+    return;
+  }
+
+  count(classes, flags);
+
+  I64 withheld = 0, overlap = 0;
+  for (f = 0; f < 16; f++)
+  {
+    if (f & LASCLASSIFICATION_WITHHELD) withheld += flags[f];
+    if (f & LASCLASSIFICATION_OVERLAP) overlap += flags[f];
+  }
+
+  // classes that are reserved for the point data format
+
+  U32 first_reserved = (extended ? LASCLASSIFICATION_LAST_EXTENDED + 1 : LASCLASSIFICATION_LAST_LEGACY + 1);
+  U32 last_reserved = (extended ? LASCLASSIFICATION_LAST_RESERVED : 31);
+  U32 listed = 0;
+  I64 reserved = 0;
+  CHAR list[256];
+  list[0] = '\0';
+  for (c = first_reserved; c <= last_reserved; c++)
+  {
+    if (classes[c])
+    {
+      if (listed < LASCLASSIFICATION_MAX_LISTED)
+      {
+        sprintf(list + strlen(list), "%s%u", (listed ? "," : ""), c);
+      }
+      else if (listed == LASCLASSIFICATION_MAX_LISTED)
+      {
+        strcat(list, ",...");
+      }
+      listed++;
+      reserved += classes[c];
+    }
+  }
+  if (reserved)
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d points have classifications %s that are reserved for point data format %d", reserved, list, point_data_format);
+#else
+    sprintf(note, "%lld points have classifications %s that are reserved for point data format %d", reserved, list, point_data_format);
+#endif
+    if (extended)
+    {
+      lasheader->add_fail("classification", note);
+    }
+    else
+    {
+      lasheader->add_warning("classification", note);
+    }
+  }
+
+  // the overlap flag replaces class 12 for the new point data formats
+
+  if (extended && classes[LASCLASSIFICATION_OVERLAP_CLASS])
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d points have classification 12 that is reserved for point data format %d which marks overlap with the overlap flag (set for %I64d points)", classes[LASCLASSIFICATION_OVERLAP_CLASS], point_data_format, overlap);
+#else
+    sprintf(note, "%lld points have classification 12 that is reserved for point data format %d which marks overlap with the overlap flag (set for %lld points)", classes[LASCLASSIFICATION_OVERLAP_CLASS], point_data_format, overlap);
+#endif
+    lasheader->add_warning("classification", note);
+  }
+
+  if (withheld)
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d points are flagged as withheld and should have been deleted", withheld);
+#else
+    sprintf(note, "%lld points are flagged as withheld and should have been deleted", withheld);
+#endif
+    lasheader->add_warning("withheld flag", note);
+  }
+}
+
+BOOL LASclassification::get_flags_description(CHAR* description) const
+{
+  I64 classes[256];
+  I64 flags[16];
+  I64 synthetic = 0, keypoint = 0, withheld = 0, overlap = 0;
+  U32 f;
+
+  if (version_minor == 0)
+  {
+    return FALSE;
+  }
+
+  count(classes, flags);
+
+  for (f = 1; f < 16; f++)
+  {
+    if (f & LASCLASSIFICATION_SYNTHETIC) synthetic += flags[f];
+    if (f & LASCLASSIFICATION_KEYPOINT) keypoint += flags[f];
+    if (f & LASCLASSIFICATION_WITHHELD) withheld += flags[f];
+    if (f & LASCLASSIFICATION_OVERLAP) overlap += flags[f];
+  }
+
+  if ((synthetic | keypoint | withheld | overlap) == 0)
+  {
+    return FALSE;
+  }
+
+#ifdef _WIN32
+  sprintf(description, "%I64d synthetic %I64d key-point %I64d withheld %I64d overlap", synthetic, keypoint, withheld, overlap);
+#else
+  sprintf(description, "%lld synthetic %lld key-point %lld withheld %lld overlap", synthetic, keypoint, withheld, overlap);
+#endif
+  return TRUE;
+}
+
+LASclassification::LASclassification()
+{
+  extended = FALSE;
+  version_minor = 0;
+  point_data_format = 0;
+  memset(counts, 0, sizeof(counts));
+}
@@ -0,0 +1,75 @@
+/*
+===============================================================================
+
+  FILE:  lasclassification.hpp
+
+  CONTENTS:
+
+    Counts the points for every combination of classification and the
+    synthetic, key-point, withheld and overlap flags.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to check classifications and point flags
+
+===============================================================================
+*/
+#ifndef LAS_CLASSIFICATION_HPP
+#define LAS_CLASSIFICATION_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#define LASCLASSIFICATION_SYNTHETIC 1
+#define LASCLASSIFICATION_KEYPOINT  2
+#define LASCLASSIFICATION_WITHHELD  4
+#define LASCLASSIFICATION_OVERLAP   8
+
+class LASclassification
+{
+public:
+
+  void init(const LASheader* lasheader);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    if (extended)
+    {
+      counts[(laspoint->extended_classification_flags << 8) | laspoint->extended_classification]++;
+    }
+    else
+    {
+      counts[(laspoint->withheld_flag << 10) | (laspoint->keypoint_flag << 9) | (laspoint->synthetic_flag << 8) | laspoint->classification]++;
+    }
+  };
+
+  void check(LASheader* lasheader) const;
+  BOOL get_flags_description(CHAR* description) const;
+
+  LASclassification();
+
+private:
+  void count(I64* classes, I64* flags) const;
+
+  BOOL extended;
+  I32 version_minor;
+  I32 point_data_format;
+  I64 counts[4096];
+};
+
+#endif
@@ -0,0 +1,606 @@
+/*
+===============================================================================
+
+  FILE:  lasdataset.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "lasdataset.hpp"
+
+class LASdatasetEntry
+{
+public:
+  F64 min_x, min_y, max_x, max_y;
+  F64 center_x, center_y;
+  U32 index;
+};
+
+static int compare_center_x(const void* a, const void* b)
+{
+  F64 center_a = ((const LASdatasetEntry*)a)->center_x;
+  F64 center_b = ((const LASdatasetEntry*)b)->center_x;
+  if (center_a < center_b) return -1;
+  if (center_a > center_b) return 1;
+  return 0;
+}
+
+static int compare_center_y(const void* a, const void* b)
+{
+  F64 center_a = ((const LASdatasetEntry*)a)->center_y;
+  F64 center_b = ((const LASdatasetEntry*)b)->center_y;
+  if (center_a < center_b) return -1;
+  if (center_a > center_b) return 1;
+  return 0;
+}
+
+static int compare_hashes(const void* a, const void* b)
+{
+  U64 hash_a = *((const U64*)a);
+  U64 hash_b = *((const U64*)b);
+  if (hash_a < hash_b) return -1;
+  if (hash_a > hash_b) return 1;
+  return 0;
+}
+
+static inline U64 mix_hash(U64 hash)
+{
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+static I32 clamp_I32(const I64 value)
+{
+  if (value < (I64)I32_MIN) return I32_MIN;
+  if (value > (I64)I32_MAX) return I32_MAX;
+  return (I32)value;
+}
+
+BOOL LASdataset::add(const CHAR* file_name, const LASheader* lasheader)
+{
+  // no band of the previous tile is collected any further
+
+  west_X = I32_MIN;
+  east_X = I32_MAX;
+  south_Y = I32_MIN;
+  north_Y = I32_MAX;
+
+  if ((lasheader->max_x < lasheader->min_x) || (lasheader->max_y < lasheader->min_y))
+  {
+    return FALSE;
+  }
+  if (number_tiles == alloc_tiles)
+  {
+    alloc_tiles = (alloc_tiles ? 2*alloc_tiles : 1024);
+    tiles = (LASdatasetTile*)realloc(tiles, sizeof(LASdatasetTile)*alloc_tiles);
+    if (tiles == 0)
+    {
+      fprintf(stderr, "ERROR: cannot allocate %u tiles\n", alloc_tiles);
+      return FALSE;
+    }
+  }
+  LASdatasetTile* tile = &tiles[number_tiles];
+  tile->file_name = strdup(file_name ? file_name : "");
+  tile->min_x = lasheader->min_x;
+  tile->min_y = lasheader->min_y;
+  tile->max_x = lasheader->max_x;
+  tile->max_y = lasheader->max_y;
+  U32 edge;
+  for (edge = 0; edge < 4; edge++)
+  {
+    tile->band_number[edge] = 0;
+    tile->band[edge] = 0;
+    band_alloc[edge] = 0;
+  }
+  number_tiles++;
+
+  // the bands along the edges are tested with the integer coordinates
+
+  if ((band_width > 0.0) && (lasheader->x_scale_factor > 0.0) && (lasheader->y_scale_factor > 0.0))
+  {
+    west_X = clamp_I32(I64_QUANTIZE((lasheader->min_x + band_width - lasheader->x_offset) / lasheader->x_scale_factor));
+    east_X = clamp_I32(I64_QUANTIZE((lasheader->max_x - band_width - lasheader->x_offset) / lasheader->x_scale_factor));
+    south_Y = clamp_I32(I64_QUANTIZE((lasheader->min_y + band_width - lasheader->y_offset) / lasheader->y_scale_factor));
+    north_Y = clamp_I32(I64_QUANTIZE((lasheader->max_y - band_width - lasheader->y_offset) / lasheader->y_scale_factor));
+    x_scale_factor = lasheader->x_scale_factor;
+    y_scale_factor = lasheader->y_scale_factor;
+    z_scale_factor = lasheader->z_scale_factor;
+    x_offset = lasheader->x_offset;
+    y_offset = lasheader->y_offset;
+    z_offset = lasheader->z_offset;
+  }
+  return TRUE;
+}
+
+void LASdataset::add(const U32 edge, const LASpoint* laspoint)
+{
+  LASdatasetTile* tile = &tiles[number_tiles-1];
+
+  if (tile->band_number[edge] == band_alloc[edge])
+  {
+    band_alloc[edge] = (band_alloc[edge] ? 2*band_alloc[edge] : 1024);
+    tile->band[edge] = (U64*)realloc(tile->band[edge], sizeof(U64)*band_alloc[edge]);
+    if (tile->band[edge] == 0)
+    {
+      fprintf(stderr, "ERROR: cannot allocate edge band of %u points\n", band_alloc[edge]);
+      tile->band_number[edge] = band_alloc[edge] = 0;
+      return;
+    }
+  }
+
+  // world coordinates on a millimeter grid so tiles with different offsets match
+
+  I64 x = I64_QUANTIZE(1000.0 * (x_scale_factor * laspoint->X + x_offset));
+  I64 y = I64_QUANTIZE(1000.0 * (y_scale_factor * laspoint->Y + y_offset));
+  I64 z = I64_QUANTIZE(1000.0 * (z_scale_factor * laspoint->Z + z_offset));
+  U64 t;
+  memcpy(&t, &laspoint->gps_time, sizeof(U64));
+
+  U64 hash = mix_hash((U64)x);
+  hash = mix_hash(hash ^ (U64)y);
+  hash = mix_hash(hash ^ (U64)z);
+  hash = mix_hash(hash ^ t);
+
+  tile->band[edge][tile->band_number[edge]++] = hash;
+}
+
+BOOL LASdataset::done()
+{
+  if (number_tiles == 0)
+  {
+    return FALSE;
+  }
+
+  // sort each band, drop duplicates within the tile and trim the memory
+
+  LASdatasetTile* tile = &tiles[number_tiles-1];
+  U32 edge, i, n;
+
+  for (edge = 0; edge < 4; edge++)
+  {
+    if (tile->band_number[edge] == 0)
+    {
+      continue;
+    }
+    qsort(tile->band[edge], tile->band_number[edge], sizeof(U64), compare_hashes);
+    for (i = 1, n = 1; i < tile->band_number[edge]; i++)
+    {
+      if (tile->band[edge][i] != tile->band[edge][n-1])
+      {
+        tile->band[edge][n++] = tile->band[edge][i];
+      }
+    }
+    tile->band_number[edge] = n;
+    tile->band[edge] = (U64*)realloc(tile->band[edge], sizeof(U64)*n);
+    band_alloc[edge] = n;
+  }
+
+  west_X = I32_MIN;
+  east_X = I32_MAX;
+  south_Y = I32_MIN;
+  north_Y = I32_MAX;
+
+  return TRUE;
+}
+
+U32 LASdataset::intersect(const LASdatasetTile* tile, const U32 edge, const LASdatasetTile* other, const U32 other_edge) const
+{
+  const U64* a = tile->band[edge];
+  const U64* b = other->band[other_edge];
+  U32 i = 0, j = 0, number = 0;
+  while ((i < tile->band_number[edge]) && (j < other->band_number[other_edge]))
+  {
+    if (a[i] < b[j])
+    {
+      i++;
+    }
+    else if (b[j] < a[i])
+    {
+      j++;
+    }
+    else
+    {
+      number++;
+      i++;
+      j++;
+    }
+  }
+  return number;
+}
+
+BOOL LASdataset::build()
+{
+  if (nodes)
+  {
+    free(nodes);
+    nodes = 0;
+  }
+  if (children)
+  {
+    free(children);
+    children = 0;
+  }
+  if (stack)
+  {
+    free(stack);
+    stack = 0;
+  }
+  number_nodes = 0;
+
+  if (number_tiles == 0)
+  {
+    return FALSE;
+  }
+
+  // a tree with fanout M has fewer than n/(M-1) + levels nodes
+
+  U32 alloc_nodes = number_tiles / (LASDATASET_FANOUT - 1) + 32;
+  nodes = (LASdatasetNode*)malloc(sizeof(LASdatasetNode)*alloc_nodes);
+  children = (U32*)malloc(sizeof(U32)*(number_tiles + alloc_nodes));
+  LASdatasetEntry* entries = (LASdatasetEntry*)malloc(sizeof(LASdatasetEntry)*number_tiles);
+  if ((nodes == 0) || (children == 0) || (entries == 0))
+  {
+    fprintf(stderr, "ERROR: cannot allocate R-tree for %u tiles\n", number_tiles);
+    if (entries) free(entries);
+    return FALSE;
+  }
+
+  U32 i, j, k;
+  U32 number_entries = number_tiles;
+
+  for (i = 0; i < number_tiles; i++)
+  {
+    entries[i].min_x = tiles[i].min_x;
+    entries[i].min_y = tiles[i].min_y;
+    entries[i].max_x = tiles[i].max_x;
+    entries[i].max_y = tiles[i].max_y;
+    entries[i].index = i;
+  }
+
+  // pack one level at a time bottom up until only the root is left
+
+  U32 number_children = 0;
+  BOOL leaf = TRUE;
+
+  while (TRUE)
+  {
+    for (i = 0; i < number_entries; i++)
+    {
+      entries[i].center_x = 0.5*(entries[i].min_x + entries[i].max_x);
+      entries[i].center_y = 0.5*(entries[i].min_y + entries[i].max_y);
+    }
+
+    // sort by x into vertical slices and then each slice by y
+
+    U32 number_packs = (number_entries + LASDATASET_FANOUT - 1) / LASDATASET_FANOUT;
+    U32 number_slices = (U32)ceil(sqrt((F64)number_packs));
+    U32 slice_size = ((number_packs + number_slices - 1) / number_slices) * LASDATASET_FANOUT;
+
+    qsort(entries, number_entries, sizeof(LASdatasetEntry), compare_center_x);
+    for (i = 0; i < number_entries; i += slice_size)
+    {
+      qsort(entries + i, (number_entries - i < slice_size ? number_entries - i : slice_size), sizeof(LASdatasetEntry), compare_center_y);
+    }
+
+    // consecutive runs of entries become the nodes of this level
+
+    U32 level_begin = number_nodes;
+
+    for (i = 0; i < number_entries; i += LASDATASET_FANOUT)
+    {
+      LASdatasetNode* node = &nodes[number_nodes];
+      node->min_x = entries[i].min_x;
+      node->min_y = entries[i].min_y;
+      node->max_x = entries[i].max_x;
+      node->max_y = entries[i].max_y;
+      node->first = number_children;
+      node->count = 0;
+      node->leaf = leaf;
+      for (j = i; (j < number_entries) && (j < i + LASDATASET_FANOUT); j++)
+      {
+        if (entries[j].min_x < node->min_x) node->min_x = entries[j].min_x;
+        if (entries[j].min_y < node->min_y) node->min_y = entries[j].min_y;
+        if (entries[j].max_x > node->max_x) node->max_x = entries[j].max_x;
+        if (entries[j].max_y > node->max_y) node->max_y = entries[j].max_y;
+        children[number_children++] = entries[j].index;
+        node->count++;
+      }
+      number_nodes++;
+    }
+
+    if ((number_nodes - level_begin) == 1)
+    {
+      break;
+    }
+
+    // the nodes of this level are the entries of the next
+
+    number_entries = number_nodes - level_begin;
+    for (i = 0, k = level_begin; i < number_entries; i++, k++)
+    {
+      entries[i].min_x = nodes[k].min_x;
+      entries[i].min_y = nodes[k].min_y;
+      entries[i].max_x = nodes[k].max_x;
+      entries[i].max_y = nodes[k].max_y;
+      entries[i].index = k;
+    }
+    leaf = FALSE;
+  }
+
+  free(entries);
+
+  // the traversal stack never holds more than all nodes
+
+  stack = (U32*)malloc(sizeof(U32)*number_nodes);
+
+  return TRUE;
+}
+
+U32 LASdataset::query(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y, const U32** hits)
+{
+  number_hits = 0;
+  *hits = this->hits;
+
+  if (number_nodes == 0)
+  {
+    return 0;
+  }
+
+  U32 i, n;
+  U32 stack_size = 0;
+
+  // the root is the last node that was created
+
+  stack[stack_size++] = number_nodes - 1;
+
+  while (stack_size)
+  {
+    const LASdatasetNode* node = &nodes[stack[--stack_size]];
+    for (i = 0; i < node->count; i++)
+    {
+      n = children[node->first + i];
+      if (node->leaf)
+      {
+        const LASdatasetTile* tile = &tiles[n];
+        if ((tile->min_x > max_x) || (tile->max_x < min_x) || (tile->min_y > max_y) || (tile->max_y < min_y)) continue;
+        if (number_hits == alloc_hits)
+        {
+          alloc_hits = (alloc_hits ? 2*alloc_hits : 64);
+          this->hits = (U32*)realloc(this->hits, sizeof(U32)*alloc_hits);
+        }
+        this->hits[number_hits++] = n;
+      }
+      else
+      {
+        const LASdatasetNode* child = &nodes[n];
+        if ((child->min_x > max_x) || (child->max_x < min_x) || (child->min_y > max_y) || (child->max_y < min_y)) continue;
+        stack[stack_size++] = n;
+      }
+    }
+  }
+
+  *hits = this->hits;
+  return number_hits;
+}
+
+U32 LASdataset::check(XMLwriter& xmlwriter, const F64 tolerance)
+{
+  U32 i, h, number, number_overlaps = 0, number_gaps = 0, number_seams = 0;
+  I64 number_duplicates = 0;
+  const U32* hits;
+  CHAR note[1024];
+
+  if (!build())
+  {
+    return 0;
+  }
+
+  xmlwriter.begin("dataset");
+  xmlwriter.write("tiles", (I32)number_tiles);
+  xmlwriter.beginsub("details");
+
+  for (i = 0; i < number_tiles; i++)
+  {
+    const LASdatasetTile* tile = &tiles[i];
+
+    // tiles that overlap by more than the tolerance in both directions
+
+    number = query(tile->min_x, tile->min_y, tile->max_x, tile->max_y, &hits);
+    for (h = 0; h < number; h++)
+    {
+      if (hits[h] <= i) continue;
+      const LASdatasetTile* other = &tiles[hits[h]];
+      F64 overlap_x = (tile->max_x < other->max_x ? tile->max_x : other->max_x) - (tile->min_x > other->min_x ? tile->min_x : other->min_x);
+      F64 overlap_y = (tile->max_y < other->max_y ? tile->max_y : other->max_y) - (tile->min_y > other->min_y ? tile->min_y : other->min_y);
+      if ((overlap_x > tolerance) && (overlap_y > tolerance))
+      {
+        if (number_overlaps < LASDATASET_MAX_NOTES)
+        {
+          sprintf(note, "'%s' and '%s' overlap by %g by %g", tile->file_name, other->file_name, overlap_x, overlap_y);
+          xmlwriter.write("tile overlap", "warning", note);
+        }
+        number_overlaps++;
+      }
+    }
+
+    // duplicated points in the bands of facing edges of neighboring tiles
+
+    if (band_width > 0.0)
+    {
+      number = query(tile->min_x - band_width, tile->min_y - band_width, tile->max_x + band_width, tile->max_y + band_width, &hits);
+      for (h = 0; h < number; h++)
+      {
+        if (hits[h] <= i) continue;
+        const LASdatasetTile* other = &tiles[hits[h]];
+        U32 duplicates = 0;
+        if (fabs(tile->max_x - other->min_x) <= band_width) duplicates += intersect(tile, LASDATASET_EAST, other, LASDATASET_WEST);
+        if (fabs(tile->min_x - other->max_x) <= band_width) duplicates += intersect(tile, LASDATASET_WEST, other, LASDATASET_EAST);
+        if (fabs(tile->max_y - other->min_y) <= band_width) duplicates += intersect(tile, LASDATASET_NORTH, other, LASDATASET_SOUTH);
+        if (fabs(tile->min_y - other->max_y) <= band_width) duplicates += intersect(tile, LASDATASET_SOUTH, other, LASDATASET_NORTH);
+        if (duplicates)
+        {
+          if (number_seams < LASDATASET_MAX_NOTES)
+          {
+            sprintf(note, "'%s' and '%s' share %u duplicate points along their common edge", tile->file_name, other->file_name, duplicates);
+            xmlwriter.write("duplicate points", "warning", note);
+          }
+          number_seams++;
+          number_duplicates += duplicates;
+        }
+      }
+    }
+
+    // the nearest tile east of the east edge within one tile width. only
+    // the east and the north edges are probed so each gap is seen once
+
+    F64 width = tile->max_x - tile->min_x;
+    F64 height = tile->max_y - tile->min_y;
+    F64 nearest = width + tolerance;
+
+    number = query(tile->max_x - tolerance, tile->min_y + tolerance, tile->max_x + width, tile->max_y - tolerance, &hits);
+    for (h = 0; h < number; h++)
+    {
+      if (hits[h] == i) continue;
+      const LASdatasetTile* other = &tiles[hits[h]];
+      if (other->max_x <= tile->max_x) continue;
+      if ((other->min_x - tile->max_x) < nearest) nearest = other->min_x - tile->max_x;
+    }
+    if ((nearest > tolerance) && (nearest <= width))
+    {
+      if (number_gaps < LASDATASET_MAX_NOTES)
+      {
+        sprintf(note, "gap of %g east of '%s'", nearest, tile->file_name);
+        xmlwriter.write("tile gap", "warning", note);
+      }
+      number_gaps++;
+    }
+
+    // the nearest tile north of the north edge within one tile height
+
+    nearest = height + tolerance;
+
+    number = query(tile->min_x + tolerance, tile->max_y - tolerance, tile->max_x - tolerance, tile->max_y + height, &hits);
+    for (h = 0; h < number; h++)
+    {
+      if (hits[h] == i) continue;
+      const LASdatasetTile* other = &tiles[hits[h]];
+      if (other->max_y <= tile->max_y) continue;
+      if ((other->min_y - tile->max_y) < nearest) nearest = other->min_y - tile->max_y;
+    }
+    if ((nearest > tolerance) && (nearest <= height))
+    {
+      if (number_gaps < LASDATASET_MAX_NOTES)
+      {
+        sprintf(note, "gap of %g north of '%s'", nearest, tile->file_name);
+        xmlwriter.write("tile gap", "warning", note);
+      }
+      number_gaps++;
+    }
+  }
+
+  if (number_overlaps > LASDATASET_MAX_NOTES)
+  {
+    sprintf(note, "%u more overlapping tile pairs not listed", number_overlaps - LASDATASET_MAX_NOTES);
+    xmlwriter.write("tile overlap", "warning", note);
+  }
+  if (number_gaps > LASDATASET_MAX_NOTES)
+  {
+    sprintf(note, "%u more gaps between tiles not listed", number_gaps - LASDATASET_MAX_NOTES);
+    xmlwriter.write("tile gap", "warning", note);
+  }
+
+  if (number_seams > LASDATASET_MAX_NOTES)
+  {
+    sprintf(note, "%u more tile pairs with duplicate points not listed", number_seams - LASDATASET_MAX_NOTES);
+    xmlwriter.write("duplicate points", "warning", note);
+  }
+
+  xmlwriter.endsub("details");
+  xmlwriter.write("overlaps", (I32)number_overlaps);
+  xmlwriter.write("gaps", (I32)number_gaps);
+  if (band_width > 0.0)
+  {
+#ifdef _WIN32
+    sprintf(note, "%I64d", number_duplicates);
+#else
+    sprintf(note, "%lld", number_duplicates);
+#endif
+    xmlwriter.write("duplicate_points", note);
+  }
+  xmlwriter.end("dataset");
+
+  return number_overlaps + number_gaps + number_seams;
+}
+
+LASdataset::LASdataset()
+{
+  band_width = 0.0;
+  west_X = I32_MIN;
+  east_X = I32_MAX;
+  south_Y = I32_MIN;
+  north_Y = I32_MAX;
+  x_scale_factor = y_scale_factor = z_scale_factor = 0.01;
+  x_offset = y_offset = z_offset = 0.0;
+  band_alloc[0] = band_alloc[1] = band_alloc[2] = band_alloc[3] = 0;
+  number_tiles = 0;
+  alloc_tiles = 0;
+  tiles = 0;
+  number_nodes = 0;
+  nodes = 0;
+  children = 0;
+  stack = 0;
+  number_hits = 0;
+  alloc_hits = 0;
+  hits = 0;
+}
+
+LASdataset::~LASdataset()
+{
+  U32 i;
+  U32 edge;
+  for (i = 0; i < number_tiles; i++)
+  {
+    free(tiles[i].file_name);
+    for (edge = 0; edge < 4; edge++)
+    {
+      if (tiles[i].band[edge]) free(tiles[i].band[edge]);
+    }
+  }
+  if (tiles) free(tiles);
+  if (nodes) free(nodes);
+  if (children) free(children);
+  if (stack) free(stack);
+  if (hits) free(hits);
+}
@@ -0,0 +1,115 @@
+/*
+===============================================================================
+
+  FILE:  lasdataset.hpp
+
+  CONTENTS:
+
+    Checks the tiles of a delivery against each other for overlaps, gaps and
+    points duplicated along shared edges once all files were read.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- duplicate points along the edges of neighboring tiles
+    18 October 2026 -- created for dataset level overlap and gap checks
+
+===============================================================================
+*/
+#ifndef LAS_DATASET_HPP
+#define LAS_DATASET_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define LASDATASET_FANOUT 16
+#define LASDATASET_MAX_NOTES 1000
+
+#define LASDATASET_WEST  0
+#define LASDATASET_EAST  1
+#define LASDATASET_SOUTH 2
+#define LASDATASET_NORTH 3
+
+class LASdatasetTile
+{
+public:
+  CHAR* file_name;
+  F64 min_x, min_y, max_x, max_y;
+  U32 band_number[4];
+  U64* band[4];
+};
+
+class LASdatasetNode
+{
+public:
+  F64 min_x, min_y, max_x, max_y;
+  U32 first;
+  U32 count;
+  BOOL leaf;
+};
+
+class LASdataset
+{
+public:
+
+  void set_band_width(const F64 band_width) { this->band_width = band_width; };
+  BOOL add(const CHAR* file_name, const LASheader* lasheader);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    if (laspoint->X < west_X) add(LASDATASET_WEST, laspoint);
+    else if (laspoint->X > east_X) add(LASDATASET_EAST, laspoint);
+    if (laspoint->Y < south_Y) add(LASDATASET_SOUTH, laspoint);
+    else if (laspoint->Y > north_Y) add(LASDATASET_NORTH, laspoint);
+  };
+
+  BOOL done();
+  BOOL build();
+  U32 query(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y, const U32** hits);
+  U32 check(XMLwriter& xmlwriter, const F64 tolerance);
+
+  U32 get_number_of_tiles() const { return number_tiles; };
+  const LASdatasetTile* get_tile(const U32 index) const { return (index < number_tiles ? &tiles[index] : 0); };
+
+  LASdataset();
+  ~LASdataset();
+
+private:
+  void add(const U32 edge, const LASpoint* laspoint);
+  U32 intersect(const LASdatasetTile* tile, const U32 edge, const LASdatasetTile* other, const U32 other_edge) const;
+
+  F64 band_width;
+  I32 west_X, east_X, south_Y, north_Y;
+  F64 x_scale_factor, y_scale_factor, z_scale_factor;
+  F64 x_offset, y_offset, z_offset;
+  U32 band_alloc[4];
+
+  U32 number_tiles;
+  U32 alloc_tiles;
+  LASdatasetTile* tiles;
+  U32 number_nodes;
+  LASdatasetNode* nodes;
+  U32* children;
+  U32* stack;
+  U32 number_hits;
+  U32 alloc_hits;
+  U32* hits;
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*
+===============================================================================
+
+  FILE:  lasdensity.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "lasdensity.hpp"
+
+BOOL LASdensity::init(const LASheader* lasheader, const F64 cell_size)
+{
+  if (counts)
+  {
+    free(counts);
+    counts = 0;
+  }
+
+  if ((cell_size <= 0.0) || (lasheader->x_scale_factor <= 0.0) || (lasheader->y_scale_factor <= 0.0))
+  {
+    return FALSE;
+  }
+
+  if ((lasheader->max_x < lasheader->min_x) || (lasheader->max_y < lasheader->min_y))
+  {
+    return FALSE;
+  }
+
+  // the grid lives in the integer coordinates of the points. a bounding box
+  // that is not finite or far outside of the integer range cannot be used
+
+  F64 min_X = (lasheader->min_x - lasheader->x_offset) / lasheader->x_scale_factor;
+  F64 min_Y = (lasheader->min_y - lasheader->y_offset) / lasheader->y_scale_factor;
+  F64 max_X = (lasheader->max_x - lasheader->x_offset) / lasheader->x_scale_factor;
+  F64 max_Y = (lasheader->max_y - lasheader->y_offset) / lasheader->y_scale_factor;
+  if (!(fabs(min_X) <= LASDENSITY_MAX_QUANTIZED) || !(fabs(min_Y) <= LASDENSITY_MAX_QUANTIZED) || !(fabs(max_X) <= LASDENSITY_MAX_QUANTIZED) || !(fabs(max_Y) <= LASDENSITY_MAX_QUANTIZED))
+  {
+    return FALSE;
+  }
+
+  origin_X = I64_QUANTIZE(min_X);
+  origin_Y = I64_QUANTIZE(min_Y);
+  I64 extent_X = I64_QUANTIZE(max_X) - origin_X;
+  I64 extent_Y = I64_QUANTIZE(max_Y) - origin_Y;
+  if (extent_X < 0) extent_X = 0;
+  if (extent_Y < 0) extent_Y = 0;
+
+  // double the cell size until the grid is small enough
+
+  this->cell_size = cell_size;
+
+  while (TRUE)
+  {
+    I64 quantized_cell_X = I64_QUANTIZE(this->cell_size / lasheader->x_scale_factor);
+    I64 quantized_cell_Y = I64_QUANTIZE(this->cell_size / lasheader->y_scale_factor);
+    cell_X = (quantized_cell_X < 1 ? 1 : (U64)quantized_cell_X);
+    cell_Y = (quantized_cell_Y < 1 ? 1 : (U64)quantized_cell_Y);
+    U64 ncols = extent_X / cell_X + 1;
+    U64 nrows = extent_Y / cell_Y + 1;
+    if ((ncols <= LASDENSITY_MAX_CELLS) && (nrows <= LASDENSITY_MAX_CELLS) && ((ncols * nrows) <= LASDENSITY_MAX_CELLS))
+    {
+      this->ncols = (U32)ncols;
+      this->nrows = (U32)nrows;
+      break;
+    }
+    this->cell_size *= 2.0;
+  }
+
+  // only cells that lie completely inside the bounding box are used for the statistics
+
+  full_ncols = (U32)(extent_X / cell_X);
+  full_nrows = (U32)(extent_Y / cell_Y);
+
+  counts = (U32*)calloc(ncols*nrows, sizeof(U32));
+  if (counts == 0)
+  {
+    fprintf(stderr, "ERROR: cannot allocate density grid of %u by %u cells\n", ncols, nrows);
+    return FALSE;
+  }
+
+  x_cell_size = cell_X * lasheader->x_scale_factor;
+  y_cell_size = cell_Y * lasheader->y_scale_factor;
+
+  return TRUE;
+}
+
+BOOL LASdensity::get_statistics(F64 min_density, F64* mean_density, F64* lowest_density, F64* highest_density, F64* fraction_below) const
+{
+  if (counts == 0)
+  {
+    return FALSE;
+  }
+
+  // use all cells if not even one cell lies completely inside the bounding box
+
+  U32 use_ncols = (full_ncols && full_nrows ? full_ncols : ncols);
+  U32 use_nrows = (full_ncols && full_nrows ? full_nrows : nrows);
+
+  U32 row, col;
+  U32 count, lowest = U32_MAX, highest = 0;
+  U64 total = 0, below = 0;
+  F64 cell_area = x_cell_size * y_cell_size;
+  F64 min_count = min_density * cell_area;
+
+  for (row = 0; row < use_nrows; row++)
+  {
+    const U32* counts_row = counts + row*ncols;
+    for (col = 0; col < use_ncols; col++)
+    {
+      count = counts_row[col];
+      total += count;
+      if (count < lowest) lowest = count;
+      if (count > highest) highest = count;
+      if (count < min_count) below++;
+    }
+  }
+
+  F64 number_cells = (F64)use_ncols * (F64)use_nrows;
+
+  *mean_density = total / (number_cells * cell_area);
+  *lowest_density = lowest / cell_area;
+  *highest_density = highest / cell_area;
+  *fraction_below = below / number_cells;
+
+  return TRUE;
+}
+
+LASdensity::LASdensity()
+{
+  origin_X = origin_Y = 0;
+  cell_X = cell_Y = 1;
+  ncols = nrows = 0;
+  full_ncols = full_nrows = 0;
+  cell_size = 0.0;
+  x_cell_size = y_cell_size = 0.0;
+  counts = 0;
+}
+
+LASdensity::~LASdensity()
+{
+  if (counts) free(counts);
+}
@@ -0,0 +1,78 @@
+/*
+===============================================================================
+
+  FILE:  lasdensity.hpp
+
+  CONTENTS:
+
+    A compact 2D grid that counts the first returns per cell over the bounding
+    box of the LAS header to check the nominal pulse density.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to check the aggregate nominal pulse density
+
+===============================================================================
+*/
+#ifndef LAS_DENSITY_HPP
+#define LAS_DENSITY_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#define LASDENSITY_MAX_QUANTIZED 4294967296.0
+#define LASDENSITY_MAX_CELLS (1 << 22)
+
+class LASdensity
+{
+public:
+
+  BOOL init(const LASheader* lasheader, const F64 cell_size);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    // only first returns count as pulses
+
+    if ((laspoint->extended_point_type ? laspoint->extended_return_number : laspoint->return_number) != 1) return;
+
+    // unsigned compare also rejects points left of or below the grid
+
+    U64 col = (U64)((I64)laspoint->X - origin_X) / cell_X;
+    if (col >= ncols) return;
+    U64 row = (U64)((I64)laspoint->Y - origin_Y) / cell_Y;
+    if (row >= nrows) return;
+    counts[row*ncols + col]++;
+  };
+
+  BOOL get_statistics(F64 min_density, F64* mean_density, F64* lowest_density, F64* highest_density, F64* fraction_below) const;
+  F64 get_cell_size() const { return cell_size; };
+
+  LASdensity();
+  ~LASdensity();
+
+private:
+  I64 origin_X, origin_Y;
+  U64 cell_X, cell_Y;
+  U32 ncols, nrows;
+  U32 full_ncols, full_nrows;
+  F64 cell_size;
+  F64 x_cell_size, y_cell_size;
+  U32* counts;
+};
+
+#endif
@@ -0,0 +1,407 @@
+/*
+===============================================================================
+
+  FILE:  lasexport.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lasexport.hpp"
+
+#define LASEXPORT_VLR_HEADER_SIZE 54
+#define LASEXPORT_DESCRIPTOR_SIZE 192
+
+// the point data formats with waveforms are exported without the wave packet
+
+static const U8 export_point_data_format[11] = { 0, 1, 2, 3, 1, 3, 6, 7, 8, 6, 8 };
+
+static const U16 point_data_format_size[11] = { 20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67 };
+
+static void put_U16(U8* buffer, const U16 value) { memcpy(buffer, &value, 2); }
+static void put_U32(U8* buffer, const U32 value) { memcpy(buffer, &value, 4); }
+static void put_I32(U8* buffer, const I32 value) { memcpy(buffer, &value, 4); }
+static void put_U64(U8* buffer, const U64 value) { memcpy(buffer, &value, 8); }
+static void put_F64(U8* buffer, const F64 value) { memcpy(buffer, &value, 8); }
+
+BOOL LASexport::open(const LASheader* lasheader, const CHAR* directory, const CHAR* file_name)
+{
+  U32 i;
+
+  if (lasheader->point_data_format > 10)
+  {
+    return FALSE;
+  }
+
+  // the export is called like the input with '_offenders.las' in the directory
+
+  const CHAR* base_name = file_name;
+  for (i = 0; file_name[i]; i++)
+  {
+    if ((file_name[i] == '/') || (file_name[i] == '\\') || (file_name[i] == ':'))
+    {
+      base_name = file_name + i + 1;
+    }
+  }
+  U32 base_length = (U32)strlen(base_name);
+  const CHAR* dot = strrchr(base_name, '.');
+  if (dot)
+  {
+    base_length = (U32)(dot - base_name);
+  }
+  U32 directory_length = (U32)strlen(directory);
+  if (export_file_name) free(export_file_name);
+  export_file_name = (CHAR*)malloc(directory_length + base_length + 16);
+  if (export_file_name == 0)
+  {
+    return FALSE;
+  }
+  memcpy(export_file_name, directory, directory_length);
+  if (directory_length && (directory[directory_length-1] != '/') && (directory[directory_length-1] != '\\'))
+  {
+    export_file_name[directory_length++] = '/';
+  }
+  memcpy(export_file_name + directory_length, base_name, base_length);
+  strcpy(export_file_name + directory_length + base_length, "_offenders.las");
+
+  file = fopen(export_file_name, "wb");
+  if (file == 0)
+  {
+    fprintf(stderr, "ERROR: cannot open '%s' for exporting offending points\n", export_file_name);
+    return FALSE;
+  }
+
+  file_source_ID = lasheader->file_source_id;
+  global_encoding = (lasheader->global_encoding & 1);
+  file_creation_day = lasheader->file_creation_day;
+  file_creation_year = lasheader->file_creation_year;
+  scale_factor[0] = lasheader->x_scale_factor;
+  scale_factor[1] = lasheader->y_scale_factor;
+  scale_factor[2] = lasheader->z_scale_factor;
+  offset[0] = lasheader->x_offset;
+  offset[1] = lasheader->y_offset;
+  offset[2] = lasheader->z_offset;
+  point_data_format = export_point_data_format[lasheader->point_data_format];
+  point_data_record_length = point_data_format_size[point_data_format] + 1;
+
+  // the new point data formats need a LAS 1.4 header
+
+  if (point_data_format >= 6)
+  {
+    version_minor = 4;
+    header_size = 375;
+    if (lasheader->global_encoding & 16) global_encoding |= 16;
+  }
+  else
+  {
+    version_minor = 2;
+    header_size = 227;
+  }
+
+  // the projection VLRs of the input are copied
+
+  number_of_vlrs = 1;
+  offset_to_point_data = header_size + LASEXPORT_VLR_HEADER_SIZE + LASEXPORT_DESCRIPTOR_SIZE;
+  for (i = 0; i < lasheader->number_of_variable_length_records; i++)
+  {
+    if (strncmp(lasheader->vlrs[i].user_id, "LASF_Projection", 16) == 0)
+    {
+      number_of_vlrs++;
+      offset_to_point_data += LASEXPORT_VLR_HEADER_SIZE + lasheader->vlrs[i].record_length_after_header;
+    }
+  }
+
+  write_error = FALSE;
+  number_of_points = 0;
+  memset(number_of_points_by_return, 0, sizeof(number_of_points_by_return));
+  min_X = min_Y = min_Z = 0;
+  max_X = max_Y = max_Z = 0;
+
+  if (!write_header())
+  {
+    write_error = TRUE;
+    close();
+    return FALSE;
+  }
+
+  // the Extra Bytes VLR describes the rule mask
+
+  U8 vlr_header[LASEXPORT_VLR_HEADER_SIZE];
+  U8 descriptor[LASEXPORT_DESCRIPTOR_SIZE];
+  memset(vlr_header, 0, LASEXPORT_VLR_HEADER_SIZE);
+  strncpy((CHAR*)vlr_header + 2, "LASF_Spec", 16);
+  put_U16(vlr_header + 18, 4);
+  put_U16(vlr_header + 20, LASEXPORT_DESCRIPTOR_SIZE);
+  strncpy((CHAR*)vlr_header + 22, "offending rules", 32);
+  memset(descriptor, 0, LASEXPORT_DESCRIPTOR_SIZE);
+  descriptor[2] = 1;
+  strncpy((CHAR*)descriptor + 4, "rules", 32);
+  strncpy((CHAR*)descriptor + 160, "1 bbox 2 rn 4 nor 8 rn > nor", 32);
+  fwrite(vlr_header, 1, LASEXPORT_VLR_HEADER_SIZE, file);
+  fwrite(descriptor, 1, LASEXPORT_DESCRIPTOR_SIZE, file);
+
+  for (i = 0; i < lasheader->number_of_variable_length_records; i++)
+  {
+    const LASvlr* vlr = &lasheader->vlrs[i];
+    if (strncmp(vlr->user_id, "LASF_Projection", 16) == 0)
+    {
+      memset(vlr_header, 0, LASEXPORT_VLR_HEADER_SIZE);
+      memcpy(vlr_header + 2, vlr->user_id, 16);
+      put_U16(vlr_header + 18, vlr->record_id);
+      put_U16(vlr_header + 20, vlr->record_length_after_header);
+      memcpy(vlr_header + 22, vlr->description, 32);
+      fwrite(vlr_header, 1, LASEXPORT_VLR_HEADER_SIZE, file);
+      if (vlr->record_length_after_header)
+      {
+        fwrite(vlr->data, 1, vlr->record_length_after_header, file);
+      }
+    }
+  }
+
+  if (ferror(file))
+  {
+    write_error = TRUE;
+    close();
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LASexport::write_header()
+{
+  U32 i;
+  U8 header[375];
+  memset(header, 0, 375);
+
+  memcpy(header, "LASF", 4);
+  put_U16(header + 4, file_source_ID);
+  put_U16(header + 6, global_encoding);
+  header[24] = 1;
+  header[25] = version_minor;
+  strncpy((CHAR*)header + 26, "lasvalidate offending points", 32);
+  strncpy((CHAR*)header + 58, "lasvalidate", 32);
+  put_U16(header + 90, file_creation_day);
+  put_U16(header + 92, file_creation_year);
+  put_U16(header + 94, header_size);
+  put_U32(header + 96, offset_to_point_data);
+  put_U32(header + 100, number_of_vlrs);
+  header[104] = point_data_format;
+  put_U16(header + 105, point_data_record_length);
+
+  // the legacy counters are zero when the new point data formats do not fit them
+
+  if ((point_data_format < 6) && (number_of_points <= U32_MAX))
+  {
+    put_U32(header + 107, (U32)number_of_points);
+    for (i = 0; i < 5; i++)
+    {
+      put_U32(header + 111 + 4*i, (U32)number_of_points_by_return[i]);
+    }
+  }
+  for (i = 0; i < 3; i++)
+  {
+    put_F64(header + 131 + 8*i, scale_factor[i]);
+    put_F64(header + 155 + 8*i, offset[i]);
+  }
+  put_F64(header + 179, scale_factor[0]*max_X + offset[0]);
+  put_F64(header + 187, scale_factor[0]*min_X + offset[0]);
+  put_F64(header + 195, scale_factor[1]*max_Y + offset[1]);
+  put_F64(header + 203, scale_factor[1]*min_Y + offset[1]);
+  put_F64(header + 211, scale_factor[2]*max_Z + offset[2]);
+  put_F64(header + 219, scale_factor[2]*min_Z + offset[2]);
+  if (header_size == 375)
+  {
+    put_U64(header + 247, (U64)number_of_points);
+    for (i = 0; i < 15; i++)
+    {
+      put_U64(header + 255 + 8*i, (U64)number_of_points_by_return[i]);
+    }
+  }
+
+  if (fseek(file, 0, SEEK_SET) != 0)
+  {
+    return FALSE;
+  }
+  return (fwrite(header, 1, header_size, file) == header_size);
+}
+
+BOOL LASexport::write(const LASpoint* laspoint, const U8 rules)
+{
+  U8 record[40];
+  U32 return_number;
+  U32 size;
+
+  if (write_error)
+  {
+    return FALSE;
+  }
+
+  put_I32(record + 0, laspoint->X);
+  put_I32(record + 4, laspoint->Y);
+  put_I32(record + 8, laspoint->Z);
+  put_U16(record + 12, laspoint->intensity);
+  if (point_data_format >= 6)
+  {
+    return_number = laspoint->extended_return_number;
+    record[14] = (U8)((laspoint->extended_number_of_returns_of_given_pulse << 4) | laspoint->extended_return_number);
+    record[15] = (U8)((laspoint->edge_of_flight_line << 7) | (laspoint->scan_direction_flag << 6) | (laspoint->extended_scanner_channel << 4) | laspoint->extended_classification_flags);
+    record[16] = laspoint->extended_classification;
+    record[17] = laspoint->user_data;
+    memcpy(record + 18, &laspoint->extended_scan_angle, 2);
+    put_U16(record + 20, laspoint->point_source_ID);
+    put_F64(record + 22, laspoint->gps_time);
+    size = 30;
+    if (point_data_format >= 7)
+    {
+      memcpy(record + 30, laspoint->rgb, 6);
+      size = 36;
+      if (point_data_format == 8)
+      {
+        put_U16(record + 36, laspoint->rgb[3]);
+        size = 38;
+      }
+    }
+  }
+  else
+  {
+    return_number = laspoint->return_number;
+    record[14] = (U8)((laspoint->edge_of_flight_line << 7) | (laspoint->scan_direction_flag << 6) | (laspoint->number_of_returns_of_given_pulse << 3) | laspoint->return_number);
+    record[15] = (U8)((laspoint->withheld_flag << 7) | (laspoint->keypoint_flag << 6) | (laspoint->synthetic_flag << 5) | laspoint->classification);
+    record[16] = (U8)laspoint->scan_angle_rank;
+    record[17] = laspoint->user_data;
+    put_U16(record + 18, laspoint->point_source_ID);
+    size = 20;
+    if ((point_data_format == 1) || (point_data_format == 3))
+    {
+      put_F64(record + size, laspoint->gps_time);
+      size += 8;
+    }
+    if (point_data_format >= 2)
+    {
+      memcpy(record + size, laspoint->rgb, 6);
+      size += 6;
+    }
+  }
+  record[size++] = rules;
+
+  if (fwrite(record, 1, size, file) != size)
+  {
+    write_error = TRUE;
+    return FALSE;
+  }
+
+  // update bounding box and return counts for the final header
+
+  if (number_of_points)
+  {
+    if (laspoint->X < min_X) min_X = laspoint->X; else if (laspoint->X > max_X) max_X = laspoint->X;
+    if (laspoint->Y < min_Y) min_Y = laspoint->Y; else if (laspoint->Y > max_Y) max_Y = laspoint->Y;
+    if (laspoint->Z < min_Z) min_Z = laspoint->Z; else if (laspoint->Z > max_Z) max_Z = laspoint->Z;
+  }
+  else
+  {
+    min_X = max_X = laspoint->X;
+    min_Y = max_Y = laspoint->Y;
+    min_Z = max_Z = laspoint->Z;
+  }
+  if ((return_number >= 1) && (return_number <= 15))
+  {
+    number_of_points_by_return[return_number-1]++;
+  }
+  number_of_points++;
+  return TRUE;
+}
+
+BOOL LASexport::close()
+{
+  BOOL success = TRUE;
+
+  if (file == 0)
+  {
+    return FALSE;
+  }
+
+  // a file without offending points is not kept
+
+  if ((number_of_points == 0) && !write_error)
+  {
+    fclose(file);
+    file = 0;
+    remove(export_file_name);
+    return TRUE;
+  }
+
+  // a file that failed to write any of its parts is not kept either
+
+  if (write_error || ferror(file) || !write_header())
+  {
+    success = FALSE;
+  }
+  if (fclose(file) != 0)
+  {
+    success = FALSE;
+  }
+  file = 0;
+  if (!success)
+  {
+    fprintf(stderr, "ERROR: cannot write offending points to '%s'\n", export_file_name);
+    remove(export_file_name);
+  }
+  return success;
+}
+
+LASexport::LASexport()
+{
+  file = 0;
+  export_file_name = 0;
+  write_error = FALSE;
+  file_source_ID = 0;
+  global_encoding = 0;
+  file_creation_day = 0;
+  file_creation_year = 0;
+  version_minor = 2;
+  scale_factor[0] = scale_factor[1] = scale_factor[2] = 1.0;
+  offset[0] = offset[1] = offset[2] = 0.0;
+  point_data_format = 0;
+  point_data_record_length = 0;
+  header_size = 0;
+  offset_to_point_data = 0;
+  number_of_vlrs = 0;
+  number_of_points = 0;
+  memset(number_of_points_by_return, 0, sizeof(number_of_points_by_return));
+  min_X = max_X = 0;
+  min_Y = max_Y = 0;
+  min_Z = max_Z = 0;
+}
+
+LASexport::~LASexport()
+{
+  if (file) close();
+  if (export_file_name) free(export_file_name);
+}
@@ -0,0 +1,79 @@
+/*
+===============================================================================
+
+  FILE:  lasexport.hpp
+
+  CONTENTS:
+
+    Writes the points that break point level rules into a LAS file with one
+    extra byte that holds the bit mask of the rules they break.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to export offending points for inspection
+
+===============================================================================
+*/
+#ifndef LAS_EXPORT_HPP
+#define LAS_EXPORT_HPP
+
+#include <stdio.h>
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+class LASexport
+{
+public:
+
+  BOOL open(const LASheader* lasheader, const CHAR* directory, const CHAR* file_name);
+  BOOL write(const LASpoint* laspoint, const U8 rules);
+  BOOL close();
+
+  I64 get_number_of_points() const { return number_of_points; };
+  const CHAR* get_file_name() const { return export_file_name; };
+
+  LASexport();
+  ~LASexport();
+
+private:
+  BOOL write_header();
+
+  FILE* file;
+  CHAR* export_file_name;
+  BOOL write_error;
+  U16 file_source_ID;
+  U16 global_encoding;
+  U16 file_creation_day;
+  U16 file_creation_year;
+  U8 version_minor;
+  F64 scale_factor[3];
+  F64 offset[3];
+  U8 point_data_format;
+  U16 point_data_record_length;
+  U16 header_size;
+  U32 offset_to_point_data;
+  U32 number_of_vlrs;
+  I64 number_of_points;
+  I64 number_of_points_by_return[15];
+  I32 min_X, max_X;
+  I32 min_Y, max_Y;
+  I32 min_Z, max_Z;
+};
+
+#endif
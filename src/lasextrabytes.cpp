@@ -0,0 +1,312 @@
+/*
+===============================================================================
+
+  FILE:  lasextrabytes.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lasextrabytes.hpp"
+
+static const U16 point_data_format_size[11] = { 20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67 };
+
+static const U8 data_type_size[11] = { 1, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+
+static const CHAR* const data_type_names[11] = { "undocumented", "U8", "I8", "U16", "I16", "U32", "I32", "U64", "I64", "F32", "F64" };
+
+// the no_data, min and max of a descriptor are stored in 8 bytes as U64 for
+// unsigned types, as I64 for signed types and as F64 for floating point types.
+// those of F32 attributes are rounded to F32 to compare exactly with the values
+
+static F64 decode_anytype(const U8* anytype, const U8 type)
+{
+  if ((type == LASEXTRABYTES_U8) || (type == LASEXTRABYTES_U16) || (type == LASEXTRABYTES_U32) || (type == LASEXTRABYTES_U64))
+  {
+    U64 value;
+    memcpy(&value, anytype, 8);
+    return (F64)value;
+  }
+  else if ((type == LASEXTRABYTES_I8) || (type == LASEXTRABYTES_I16) || (type == LASEXTRABYTES_I32) || (type == LASEXTRABYTES_I64))
+  {
+    I64 value;
+    memcpy(&value, anytype, 8);
+    return (F64)value;
+  }
+  F64 value;
+  memcpy(&value, anytype, 8);
+  if (type == LASEXTRABYTES_F32)
+  {
+    return (F64)((F32)value);
+  }
+  return value;
+}
+
+BOOL LASextrabytes::init(const LASheader* lasheader)
+{
+  U32 i, e;
+
+  if (attributes)
+  {
+    free(attributes);
+    attributes = 0;
+  }
+  number_of_attributes = 0;
+  has_descriptors = FALSE;
+  record_length = 0;
+  declared_bytes = 0;
+  invalid_descriptor = -1;
+  invalid_data_type = 0;
+
+  if (lasheader->point_data_format > 10)
+  {
+    return FALSE;
+  }
+
+  available_bytes = (lasheader->point_data_record_length > point_data_format_size[lasheader->point_data_format] ? lasheader->point_data_record_length - point_data_format_size[lasheader->point_data_format] : 0);
+
+  // find the Extra Bytes VLR
+
+  const U8* data = 0;
+  for (i = 0; i < lasheader->number_of_variable_length_records; i++)
+  {
+    if ((strncmp(lasheader->vlrs[i].user_id, "LASF_Spec", 16) == 0) && (lasheader->vlrs[i].record_id == 4))
+    {
+      has_descriptors = TRUE;
+      record_length = lasheader->vlrs[i].record_length_after_header;
+      data = lasheader->vlrs[i].data;
+      break;
+    }
+  }
+
+  if ((available_bytes == 0) && !has_descriptors)
+  {
+    return FALSE;
+  }
+
+  if (data && (record_length >= LASEXTRABYTES_DESCRIPTOR_SIZE))
+  {
+    number_of_attributes = record_length / LASEXTRABYTES_DESCRIPTOR_SIZE;
+    attributes = (LASattribute*)calloc(number_of_attributes, sizeof(LASattribute));
+    if (attributes == 0)
+    {
+      fprintf(stderr, "ERROR: cannot allocate %u extra bytes attributes\n", number_of_attributes);
+      number_of_attributes = 0;
+      return FALSE;
+    }
+
+    // the attributes follow each other in the order of their descriptors
+
+    U32 start = 0;
+    for (i = 0; i < number_of_attributes; i++)
+    {
+      const U8* descriptor = data + i*LASEXTRABYTES_DESCRIPTOR_SIZE;
+      LASattribute* attribute = &attributes[i];
+      attribute->data_type = descriptor[2];
+      attribute->options = descriptor[3];
+      memcpy(attribute->name, descriptor + 4, 32);
+      attribute->name[32] = '\0';
+      attribute->start = start;
+
+      if (attribute->data_type == LASEXTRABYTES_UNDOCUMENTED)
+      {
+        // the options hold the number of undocumented bytes
+
+        attribute->element_type = LASEXTRABYTES_UNDOCUMENTED;
+        attribute->number_of_elements = 0;
+        attribute->size = attribute->options;
+      }
+      else if (attribute->data_type <= 30)
+      {
+        // types 11 to 30 are the deprecated arrays of two and three elements
+
+        attribute->element_type = (attribute->data_type - 1) % 10 + 1;
+        attribute->number_of_elements = (attribute->data_type - 1) / 10 + 1;
+        attribute->size = attribute->number_of_elements * data_type_size[attribute->element_type];
+        for (e = 0; e < attribute->number_of_elements; e++)
+        {
+          attribute->no_data[e] = decode_anytype(descriptor + 40 + 8*e, attribute->element_type);
+          attribute->min[e] = decode_anytype(descriptor + 64 + 8*e, attribute->element_type);
+          attribute->max[e] = decode_anytype(descriptor + 88 + 8*e, attribute->element_type);
+        }
+      }
+      else
+      {
+        if (invalid_descriptor == -1)
+        {
+          invalid_descriptor = (I32)i;
+          invalid_data_type = attribute->data_type;
+        }
+        number_of_attributes = i;
+        break;
+      }
+      start += attribute->size;
+
+      // attributes that do not fit into the point are not decoded
+
+      if (start > available_bytes)
+      {
+        attribute->number_of_elements = 0;
+      }
+    }
+    declared_bytes = start;
+  }
+
+  return TRUE;
+}
+
+void LASextrabytes::check(LASheader* lasheader, const BOOL points_were_parsed) const
+{
+  U32 i;
+  CHAR note[512];
+
+  if (has_descriptors)
+  {
+    if ((record_length % LASEXTRABYTES_DESCRIPTOR_SIZE) != 0)
+    {
+      sprintf(note, "record length %u of the Extra Bytes VLR is not a multiple of %d", record_length, LASEXTRABYTES_DESCRIPTOR_SIZE);
+      lasheader->add_fail("extra bytes", note);
+    }
+    if (invalid_descriptor != -1)
+    {
+      sprintf(note, "descriptor %d of the Extra Bytes VLR has invalid data type %d", invalid_descriptor, invalid_data_type);
+      lasheader->add_fail("extra bytes", note);
+    }
+    if (declared_bytes > available_bytes)
+    {
+      sprintf(note, "the Extra Bytes VLR describes %u bytes but point data record length %u leaves only %u bytes after point data format %d", declared_bytes, lasheader->point_data_record_length, available_bytes, lasheader->point_data_format);
+      lasheader->add_fail("extra bytes", note);
+    }
+    else if (declared_bytes < available_bytes)
+    {
+      sprintf(note, "%u of the %u extra bytes per point are not described by the Extra Bytes VLR", available_bytes - declared_bytes, available_bytes);
+      lasheader->add_warning("extra bytes", note);
+    }
+    for (i = 0; i < number_of_attributes; i++)
+    {
+      if ((attributes[i].data_type != LASEXTRABYTES_UNDOCUMENTED) && (attributes[i].name[0] == '\0'))
+      {
+        sprintf(note, "attribute %u of the Extra Bytes VLR has no name", i);
+        lasheader->add_warning("extra bytes", note);
+      }
+    }
+  }
+  else if (available_bytes)
+  {
+    sprintf(note, "point data record length %u has %u extra bytes per point but there is no Extra Bytes VLR describing them", lasheader->point_data_record_length, available_bytes);
+    lasheader->add_warning("extra bytes", note);
+  }
+
+  if (!points_were_parsed)
+  {
+    return;
+  }
+
+  // report the values of the attributes that are not plausible
+
+  for (i = 0; i < number_of_attributes; i++)
+  {
+    const LASattribute* attribute = &attributes[i];
+    if (attribute->number_nan)
+    {
+#ifdef _WIN32
+      sprintf(note, "attribute '%s' has %I64d NaN values", attribute->name, attribute->number_nan);
+#else
+      sprintf(note, "attribute '%s' has %lld NaN values", attribute->name, attribute->number_nan);
+#endif
+      lasheader->add_fail("extra bytes", note);
+    }
+    if (attribute->number_below_min || attribute->number_above_max)
+    {
+#ifdef _WIN32
+      sprintf(note, "attribute '%s' has %I64d values below min %g and %I64d values above max %g of its descriptor", attribute->name, attribute->number_below_min, attribute->min[0], attribute->number_above_max, attribute->max[0]);
+#else
+      sprintf(note, "attribute '%s' has %lld values below min %g and %lld values above max %g of its descriptor", attribute->name, attribute->number_below_min, attribute->min[0], attribute->number_above_max, attribute->max[0]);
+#endif
+      lasheader->add_fail("extra bytes", note);
+    }
+  }
+}
+
+BOOL LASextrabytes::write(XMLwriter& xmlwriter) const
+{
+  U32 i;
+  CHAR description[512];
+
+  if (number_of_attributes == 0)
+  {
+    return FALSE;
+  }
+
+  xmlwriter.beginsub("extra_bytes");
+  for (i = 0; i < number_of_attributes; i++)
+  {
+    const LASattribute* attribute = &attributes[i];
+    if (attribute->number_of_elements == 0)
+    {
+      continue;
+    }
+    if (attribute->number_of_values)
+    {
+#ifdef _WIN32
+      sprintf(description, "'%s' %s%s from %g to %g with %I64d no_data and %I64d NaN", attribute->name, data_type_names[attribute->element_type], (attribute->number_of_elements > 1 ? " array" : ""), attribute->lowest, attribute->highest, attribute->number_no_data, attribute->number_nan);
+#else
+      sprintf(description, "'%s' %s%s from %g to %g with %lld no_data and %lld NaN", attribute->name, data_type_names[attribute->element_type], (attribute->number_of_elements > 1 ? " array" : ""), attribute->lowest, attribute->highest, attribute->number_no_data, attribute->number_nan);
+#endif
+    }
+    else
+    {
+#ifdef _WIN32
+      sprintf(description, "'%s' %s%s without values but %I64d no_data and %I64d NaN", attribute->name, data_type_names[attribute->element_type], (attribute->number_of_elements > 1 ? " array" : ""), attribute->number_no_data, attribute->number_nan);
+#else
+      sprintf(description, "'%s' %s%s without values but %lld no_data and %lld NaN", attribute->name, data_type_names[attribute->element_type], (attribute->number_of_elements > 1 ? " array" : ""), attribute->number_no_data, attribute->number_nan);
+#endif
+    }
+    xmlwriter.write("attribute", description);
+  }
+  xmlwriter.endsub("extra_bytes");
+  return TRUE;
+}
+
+LASextrabytes::LASextrabytes()
+{
+  available_bytes = 0;
+  declared_bytes = 0;
+  has_descriptors = FALSE;
+  record_length = 0;
+  invalid_descriptor = -1;
+  invalid_data_type = 0;
+  number_of_attributes = 0;
+  attributes = 0;
+}
+
+LASextrabytes::~LASextrabytes()
+{
+  if (attributes) free(attributes);
+}
@@ -0,0 +1,208 @@
+/*
+===============================================================================
+
+  FILE:  lasextrabytes.hpp
+
+  CONTENTS:
+
+    Checks the Extra Bytes VLR against the point data record length and the
+    values of every attribute against the min, max and no_data it describes.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to decode and check the extra bytes of points
+
+===============================================================================
+*/
+#ifndef LAS_EXTRA_BYTES_HPP
+#define LAS_EXTRA_BYTES_HPP
+
+#include <string.h>
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define LASEXTRABYTES_DESCRIPTOR_SIZE 192
+
+#define LASEXTRABYTES_UNDOCUMENTED 0
+#define LASEXTRABYTES_U8           1
+#define LASEXTRABYTES_I8           2
+#define LASEXTRABYTES_U16          3
+#define LASEXTRABYTES_I16          4
+#define LASEXTRABYTES_U32          5
+#define LASEXTRABYTES_I32          6
+#define LASEXTRABYTES_U64          7
+#define LASEXTRABYTES_I64          8
+#define LASEXTRABYTES_F32          9
+#define LASEXTRABYTES_F64         10
+
+#define LASEXTRABYTES_NO_DATA_BIT  1
+#define LASEXTRABYTES_MIN_BIT      2
+#define LASEXTRABYTES_MAX_BIT      4
+
+class LASattribute
+{
+public:
+  CHAR name[33];
+  U8 data_type;
+  U8 options;
+  U8 element_type;
+  U8 number_of_elements;
+  U32 start;
+  U32 size;
+  F64 no_data[3];
+  F64 min[3];
+  F64 max[3];
+  I64 number_of_values;
+  I64 number_no_data;
+  I64 number_nan;
+  I64 number_below_min;
+  I64 number_above_max;
+  F64 lowest;
+  F64 highest;
+};
+
+class LASextrabytes
+{
+public:
+
+  BOOL init(const LASheader* lasheader);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    U32 a, e;
+    for (a = 0; a < number_of_attributes; a++)
+    {
+      LASattribute* attribute = &attributes[a];
+      if (attribute->number_of_elements == 0) continue;
+      const U8* item = laspoint->extra_bytes + attribute->start;
+      U32 element_size = attribute->size / attribute->number_of_elements;
+      for (e = 0; e < attribute->number_of_elements; e++, item += element_size)
+      {
+        F64 value = decode(item, attribute->element_type);
+        if (value != value)
+        {
+          // a NaN is no_data when the descriptor uses NaN as its no_data
+
+          if ((attribute->options & LASEXTRABYTES_NO_DATA_BIT) && (attribute->no_data[e] != attribute->no_data[e]))
+          {
+            attribute->number_no_data++;
+          }
+          else
+          {
+            attribute->number_nan++;
+          }
+          continue;
+        }
+        if ((attribute->options & LASEXTRABYTES_NO_DATA_BIT) && (value == attribute->no_data[e]))
+        {
+          attribute->number_no_data++;
+          continue;
+        }
+        if ((attribute->options & LASEXTRABYTES_MIN_BIT) && (value < attribute->min[e])) attribute->number_below_min++;
+        if ((attribute->options & LASEXTRABYTES_MAX_BIT) && (value > attribute->max[e])) attribute->number_above_max++;
+        if (attribute->number_of_values)
+        {
+          if (value < attribute->lowest) attribute->lowest = value;
+          else if (value > attribute->highest) attribute->highest = value;
+        }
+        else
+        {
+          attribute->lowest = attribute->highest = value;
+        }
+        attribute->number_of_values++;
+      }
+    }
+  };
+
+  void check(LASheader* lasheader, const BOOL points_were_parsed) const;
+  BOOL write(XMLwriter& xmlwriter) const;
+
+  LASextrabytes();
+  ~LASextrabytes();
+
+private:
+  static inline F64 decode(const U8* item, const U8 type)
+  {
+    switch (type)
+    {
+    case LASEXTRABYTES_U8:
+      return (F64)item[0];
+    case LASEXTRABYTES_I8:
+      return (F64)((I8)item[0]);
+    case LASEXTRABYTES_U16:
+      {
+        U16 value;
+        memcpy(&value, item, 2);
+        return (F64)value;
+      }
+    case LASEXTRABYTES_I16:
+      {
+        I16 value;
+        memcpy(&value, item, 2);
+        return (F64)value;
+      }
+    case LASEXTRABYTES_U32:
+      {
+        U32 value;
+        memcpy(&value, item, 4);
+        return (F64)value;
+      }
+    case LASEXTRABYTES_I32:
+      {
+        I32 value;
+        memcpy(&value, item, 4);
+        return (F64)value;
+      }
+    case LASEXTRABYTES_U64:
+      {
+        U64 value;
+        memcpy(&value, item, 8);
+        return (F64)value;
+      }
+    case LASEXTRABYTES_I64:
+      {
+        I64 value;
+        memcpy(&value, item, 8);
+        return (F64)value;
+      }
+    case LASEXTRABYTES_F32:
+      {
+        F32 value;
+        memcpy(&value, item, 4);
+        return (F64)value;
+      }
+    }
+    F64 value;
+    memcpy(&value, item, 8);
+    return value;
+  };
+
+  U32 available_bytes;
+  U32 declared_bytes;
+  BOOL has_descriptors;
+  U32 record_length;
+  I32 invalid_descriptor;
+  U8 invalid_data_type;
+  U32 number_of_attributes;
+  LASattribute* attributes;
+};
+
+#endif
@@ -0,0 +1,232 @@
+/*
+===============================================================================
+
+  FILE:  lasflightlines.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lasflightlines.hpp"
+
+static inline U32 hash_point_source_ID(const U16 point_source_ID, const U32 size)
+{
+  return (((U32)point_source_ID * 2654435761u) >> 16) & (size - 1);
+}
+
+static int compare_flightlines(const void* a, const void* b)
+{
+  U16 id_a = (*((const LASflightline**)a))->point_source_ID;
+  U16 id_b = (*((const LASflightline**)b))->point_source_ID;
+  return (I32)id_a - (I32)id_b;
+}
+
+static I32 decimals_of_scale_factor(F64 scale_factor)
+{
+  I32 decimals = 0;
+  while ((decimals < 8) && (scale_factor < 0.99))
+  {
+    scale_factor *= 10.0;
+    decimals++;
+  }
+  return decimals;
+}
+
+void LASflightlines::init(const LASheader* lasheader)
+{
+  // point data formats 0 and 2 have no GPS time
+
+  has_gps_time = ((lasheader->point_data_format != 0) && (lasheader->point_data_format != 2));
+  gps_time_analysis = FALSE;
+  summary = FALSE;
+  scan_direction_analysis = FALSE;
+  max_gps_time_gap = F64_MAX;
+  x_scale_factor = lasheader->x_scale_factor;
+  y_scale_factor = lasheader->y_scale_factor;
+  z_scale_factor = lasheader->z_scale_factor;
+  x_offset = lasheader->x_offset;
+  y_offset = lasheader->y_offset;
+  z_offset = lasheader->z_offset;
+  xy_decimals = decimals_of_scale_factor(x_scale_factor < y_scale_factor ? x_scale_factor : y_scale_factor);
+  z_decimals = decimals_of_scale_factor(z_scale_factor);
+  if (entries) free(entries);
+  if (sorted) free(sorted);
+  size = 16;
+  number = 0;
+  entries = (LASflightline*)calloc(size, sizeof(LASflightline));
+  last = 0;
+  sorted = 0;
+}
+
+void LASflightlines::set_max_gps_time_gap(const F64 max_gps_time_gap)
+{
+  this->max_gps_time_gap = max_gps_time_gap;
+  gps_time_analysis = TRUE;
+}
+
+LASflightline* LASflightlines::lookup(const U16 point_source_ID)
+{
+  U32 slot = hash_point_source_ID(point_source_ID, size);
+  while (entries[slot].used)
+  {
+    if (entries[slot].point_source_ID == point_source_ID)
+    {
+      return &entries[slot];
+    }
+    slot = (slot + 1) & (size - 1);
+  }
+
+  // a new flight line. keep the table at most half full
+
+  if (2*(number + 1) > size)
+  {
+    grow();
+    slot = hash_point_source_ID(point_source_ID, size);
+    while (entries[slot].used)
+    {
+      slot = (slot + 1) & (size - 1);
+    }
+  }
+
+  memset(&entries[slot], 0, sizeof(LASflightline));
+  entries[slot].point_source_ID = point_source_ID;
+  entries[slot].used = TRUE;
+  number++;
+
+  if (sorted)
+  {
+    free(sorted);
+    sorted = 0;
+  }
+
+  return &entries[slot];
+}
+
+void LASflightlines::grow()
+{
+  U32 i, slot;
+  U32 old_size = size;
+  LASflightline* old_entries = entries;
+  size = 2*size;
+  entries = (LASflightline*)calloc(size, sizeof(LASflightline));
+  for (i = 0; i < old_size; i++)
+  {
+    if (old_entries[i].used)
+    {
+      slot = hash_point_source_ID(old_entries[i].point_source_ID, size);
+      while (entries[slot].used)
+      {
+        slot = (slot + 1) & (size - 1);
+      }
+      entries[slot] = old_entries[i];
+    }
+  }
+  free(old_entries);
+  last = 0;
+}
+
+const LASflightline* LASflightlines::get_flightline(const U32 index)
+{
+  if (index >= number)
+  {
+    return 0;
+  }
+  if (sorted == 0)
+  {
+    U32 i, j = 0;
+    sorted = (LASflightline**)malloc(sizeof(LASflightline*)*number);
+    for (i = 0; i < size; i++)
+    {
+      if (entries[i].used)
+      {
+        sorted[j++] = &entries[i];
+      }
+    }
+    qsort(sorted, number, sizeof(LASflightline*), compare_flightlines);
+  }
+  return sorted[index];
+}
+
+BOOL LASflightlines::write(XMLwriter& xmlwriter)
+{
+  U32 i;
+  CHAR description[512];
+
+  if (!summary || (number == 0))
+  {
+    return FALSE;
+  }
+
+  xmlwriter.beginsub("flightlines");
+  for (i = 0; i < number; i++)
+  {
+    const LASflightline* line = get_flightline(i);
+    I32 len;
+#ifdef _WIN32
+    len = sprintf(description, "point source ID %u with %I64d points", (U32)line->point_source_ID, line->number_of_points);
+#else
+    len = sprintf(description, "point source ID %u with %lld points", (U32)line->point_source_ID, line->number_of_points);
+#endif
+    if (has_gps_time)
+    {
+      len += sprintf(description + len, " GPS time %.6f to %.6f", line->min_gps_time, line->max_gps_time);
+    }
+    len += sprintf(description + len, " x %.*f to %.*f y %.*f to %.*f z %.*f to %.*f",
+      xy_decimals, x_scale_factor*line->min_X + x_offset, xy_decimals, x_scale_factor*line->max_X + x_offset,
+      xy_decimals, y_scale_factor*line->min_Y + y_offset, xy_decimals, y_scale_factor*line->max_Y + y_offset,
+      z_decimals, z_scale_factor*line->min_Z + z_offset, z_decimals, z_scale_factor*line->max_Z + z_offset);
+    sprintf(description + len, " mean intensity %.1f", (F64)line->intensity_sum / line->number_of_points);
+    xmlwriter.write("flightline", description);
+  }
+  xmlwriter.endsub("flightlines");
+  return TRUE;
+}
+
+LASflightlines::LASflightlines()
+{
+  has_gps_time = FALSE;
+  gps_time_analysis = FALSE;
+  summary = FALSE;
+  scan_direction_analysis = FALSE;
+  max_gps_time_gap = 0.0;
+  x_scale_factor = y_scale_factor = z_scale_factor = 1.0;
+  x_offset = y_offset = z_offset = 0.0;
+  xy_decimals = z_decimals = 0;
+  size = 0;
+  number = 0;
+  entries = 0;
+  last = 0;
+  sorted = 0;
+}
+
+LASflightlines::~LASflightlines()
+{
+  if (entries) free(entries);
+  if (sorted) free(sorted);
+}
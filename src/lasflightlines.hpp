@@ -0,0 +1,151 @@
+/*
+===============================================================================
+
+  FILE:  lasflightlines.hpp
+
+  CONTENTS:
+
+    Keeps the GPS time, scan direction and summary state of every flight line
+    during the point pass, keyed by the point source ID of the points.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- scan direction and edge of flight line consistency
+    18 October 2026 -- per flight line point counts, extents and intensity
+    18 October 2026 -- created for GPS time order and gap analysis
+
+===============================================================================
+*/
+#ifndef LAS_FLIGHTLINES_HPP
+#define LAS_FLIGHTLINES_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+#include "xmlwriter.hpp"
+
+class LASflightline
+{
+public:
+  U16 point_source_ID;
+  BOOL used;
+  I64 number_of_points;
+  F64 last_gps_time;
+  I64 out_of_order_runs;
+  I64 number_of_gaps;
+  F64 largest_gap;
+  F64 largest_gap_start;
+  F64 min_gps_time;
+  F64 max_gps_time;
+  I32 min_X, max_X;
+  I32 min_Y, max_Y;
+  I32 min_Z, max_Z;
+  I64 intensity_sum;
+  U8 last_scan_direction;
+  U8 last_edge_of_flight_line;
+  I64 scan_direction_reversals;
+  I64 edges_of_flight_line;
+  I64 edges_at_reversals;
+};
+
+class LASflightlines
+{
+public:
+
+  void init(const LASheader* lasheader);
+  void set_max_gps_time_gap(const F64 max_gps_time_gap);
+  void set_summary(const BOOL summary) { this->summary = summary; };
+  void set_scan_direction_analysis(const BOOL scan_direction_analysis) { this->scan_direction_analysis = scan_direction_analysis; };
+
+  inline void add(const LASpoint* laspoint)
+  {
+    LASflightline* line = ((last && (last->point_source_ID == laspoint->point_source_ID)) ? last : lookup(laspoint->point_source_ID));
+    if (line->number_of_points)
+    {
+      if (laspoint->X < line->min_X) line->min_X = laspoint->X; else if (laspoint->X > line->max_X) line->max_X = laspoint->X;
+      if (laspoint->Y < line->min_Y) line->min_Y = laspoint->Y; else if (laspoint->Y > line->max_Y) line->max_Y = laspoint->Y;
+      if (laspoint->Z < line->min_Z) line->min_Z = laspoint->Z; else if (laspoint->Z > line->max_Z) line->max_Z = laspoint->Z;
+      if (laspoint->gps_time < line->min_gps_time) line->min_gps_time = laspoint->gps_time; else if (laspoint->gps_time > line->max_gps_time) line->max_gps_time = laspoint->gps_time;
+      F64 delta = laspoint->gps_time - line->last_gps_time;
+      if (delta < 0.0)
+      {
+        line->out_of_order_runs++;
+      }
+      else
+      {
+        if (laspoint->scan_direction_flag != line->last_scan_direction)
+        {
+          line->scan_direction_reversals++;
+          line->edges_at_reversals += line->last_edge_of_flight_line;
+        }
+        if (delta > max_gps_time_gap)
+        {
+          line->number_of_gaps++;
+          if (delta > line->largest_gap)
+          {
+            line->largest_gap = delta;
+            line->largest_gap_start = line->last_gps_time;
+          }
+        }
+      }
+    }
+    else
+    {
+      line->min_X = line->max_X = laspoint->X;
+      line->min_Y = line->max_Y = laspoint->Y;
+      line->min_Z = line->max_Z = laspoint->Z;
+      line->min_gps_time = line->max_gps_time = laspoint->gps_time;
+    }
+    line->intensity_sum += laspoint->intensity;
+    line->edges_of_flight_line += laspoint->edge_of_flight_line;
+    line->last_scan_direction = laspoint->scan_direction_flag;
+    line->last_edge_of_flight_line = laspoint->edge_of_flight_line;
+    line->last_gps_time = laspoint->gps_time;
+    line->number_of_points++;
+    last = line;
+  };
+
+  U32 get_number_of_flightlines() const { return number; };
+  const LASflightline* get_flightline(const U32 index);
+  F64 get_max_gps_time_gap() const { return max_gps_time_gap; };
+  BOOL is_gps_time_analysis() const { return gps_time_analysis; };
+  BOOL is_scan_direction_analysis() const { return scan_direction_analysis; };
+  BOOL write(XMLwriter& xmlwriter);
+
+  LASflightlines();
+  ~LASflightlines();
+
+private:
+  LASflightline* lookup(const U16 point_source_ID);
+  void grow();
+
+  BOOL has_gps_time;
+  BOOL gps_time_analysis;
+  BOOL summary;
+  BOOL scan_direction_analysis;
+  F64 max_gps_time_gap;
+  F64 x_scale_factor, y_scale_factor, z_scale_factor;
+  F64 x_offset, y_offset, z_offset;
+  I32 xy_decimals, z_decimals;
+  U32 size;
+  U32 number;
+  LASflightline* entries;
+  LASflightline* last;
+  LASflightline** sorted;
+};
+
+#endif
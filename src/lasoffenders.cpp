@@ -0,0 +1,252 @@
+/*
+===============================================================================
+
+  FILE:  lasoffenders.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lasoffenders.hpp"
+
+// the variables under which lascheck reports the rules. it reports a number
+// of returns that is too large under the variable of the return number
+
+static const CHAR* const rule_variables[LASOFFENDERS_RULES] = { "bounding box", "return number", "number of returns of given pulse", "return number" };
+
+static const CHAR* const rule_names[LASOFFENDERS_RULES] = { "outside of bounding box", "invalid return number", "invalid number of returns", "return number larger than number of returns" };
+
+static I32 decimals_of_scale_factor(F64 scale_factor)
+{
+  I32 decimals = 0;
+  while ((decimals < 8) && (scale_factor < 0.99))
+  {
+    scale_factor *= 10.0;
+    decimals++;
+  }
+  return decimals;
+}
+
+BOOL LASoffenders::init(const LASheader* lasheader, const U32 capture)
+{
+  U32 r;
+
+  extended = (lasheader->point_data_format >= 6);
+
+  // the return numbers 6 and 7 only became valid with LAS 1.4
+
+  if ((lasheader->version_major == 1) && (lasheader->version_minor < 4))
+  {
+    max_return_number = 5;
+  }
+  else
+  {
+    max_return_number = (extended ? 15 : 7);
+  }
+
+  number_first = capture;
+  number_sample = capture;
+  x_scale_factor = lasheader->x_scale_factor;
+  y_scale_factor = lasheader->y_scale_factor;
+  z_scale_factor = lasheader->z_scale_factor;
+  x_offset = lasheader->x_offset;
+  y_offset = lasheader->y_offset;
+  z_offset = lasheader->z_offset;
+  xy_decimals = decimals_of_scale_factor(x_scale_factor < y_scale_factor ? x_scale_factor : y_scale_factor);
+  z_decimals = decimals_of_scale_factor(z_scale_factor);
+  random = 0x2545F4914F6CDD1DULL;
+
+  // without capture the offenders are only tested and counted
+
+  for (r = 0; r < LASOFFENDERS_RULES; r++)
+  {
+    number_of_offenders[r] = 0;
+    if (first[r]) free(first[r]);
+    first[r] = sample[r] = 0;
+    if (capture == 0)
+    {
+      continue;
+    }
+    first[r] = (LASoffender*)malloc(sizeof(LASoffender)*(number_first + number_sample));
+    if (first[r] == 0)
+    {
+      fprintf(stderr, "ERROR: cannot allocate %u offenders\n", number_first + number_sample);
+      return FALSE;
+    }
+    sample[r] = first[r] + number_first;
+  }
+  return TRUE;
+}
+
+void LASoffenders::capture(LASoffender* offender, const I64 index, const LASpoint* laspoint) const
+{
+  offender->index = index;
+  offender->X = laspoint->X;
+  offender->Y = laspoint->Y;
+  offender->Z = laspoint->Z;
+  offender->number_of_returns = (U8)(extended ? laspoint->extended_number_of_returns_of_given_pulse : laspoint->number_of_returns_of_given_pulse);
+}
+
+void LASoffenders::add(const U32 rules, const I64 index, const LASpoint* laspoint)
+{
+  U32 r;
+  for (r = 0; r < LASOFFENDERS_RULES; r++)
+  {
+    if (rules & (1u << r))
+    {
+      I64 n = number_of_offenders[r]++;
+      if (n < number_first)
+      {
+        capture(&first[r][n], index, laspoint);
+      }
+      else if (number_sample)
+      {
+        // reservoir sampling of the offenders that come after the first ones
+
+        n -= number_first;
+        if (n < number_sample)
+        {
+          capture(&sample[r][n], index, laspoint);
+        }
+        else
+        {
+          random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+          U64 slot = (random >> 11) % (U64)(n + 1);
+          if (slot < number_sample)
+          {
+            capture(&sample[r][slot], index, laspoint);
+          }
+        }
+      }
+    }
+  }
+}
+
+static int compare_offenders(const void* a, const void* b)
+{
+  I64 index_a = ((const LASoffender*)a)->index;
+  I64 index_b = ((const LASoffender*)b)->index;
+  return (index_a < index_b ? -1 : (index_a > index_b ? 1 : 0));
+}
+
+void LASoffenders::done()
+{
+  U32 r;
+  I64 number;
+
+  // the sample is listed in the order of the points
+
+  for (r = 0; r < LASOFFENDERS_RULES; r++)
+  {
+    number = number_of_offenders[r] - number_first;
+    if (number > number_sample)
+    {
+      number = number_sample;
+    }
+    if (number > 1)
+    {
+      qsort(sample[r], (size_t)number, sizeof(LASoffender), compare_offenders);
+    }
+  }
+}
+
+BOOL LASoffenders::write(XMLwriter& xmlwriter) const
+{
+  U32 r, i, number;
+  CHAR note[512];
+  BOOL written = FALSE;
+  BOOL sampled;
+
+  for (r = 0; r < LASOFFENDERS_RULES; r++)
+  {
+    if (number_of_offenders[r] == 0)
+    {
+      continue;
+    }
+
+    number = (number_of_offenders[r] < number_first + number_sample ? (U32)number_of_offenders[r] : number_first + number_sample);
+    if (number == 0)
+    {
+      continue;
+    }
+
+    // only a reservoir that had to drop offenders holds a sample
+
+    sampled = (number_of_offenders[r] > number_first + number_sample);
+    for (i = 0; i < number; i++)
+    {
+      const LASoffender* offender = &first[r][i];
+#ifdef _WIN32
+      sprintf(note, "%s point %I64d at %.*f %.*f %.*f%s", rule_names[r], offender->index,
+#else
+      sprintf(note, "%s point %lld at %.*f %.*f %.*f%s", rule_names[r], offender->index,
+#endif
+        xy_decimals, x_scale_factor*offender->X + x_offset, xy_decimals, y_scale_factor*offender->Y + y_offset, z_decimals, z_scale_factor*offender->Z + z_offset,
+        ((sampled && (i >= number_first)) ? " (sampled)" : ""));
+      if ((r == LASOFFENDERS_NUMBER_OF_RETURNS) && offender->number_of_returns)
+      {
+        xmlwriter.write("return number", "offender", note);
+      }
+      else
+      {
+        xmlwriter.write(rule_variables[r], "offender", note);
+      }
+    }
+    written = TRUE;
+  }
+  return written;
+}
+
+LASoffenders::LASoffenders()
+{
+  U32 r;
+  extended = FALSE;
+  max_return_number = 5;
+  number_first = 0;
+  number_sample = 0;
+  x_scale_factor = y_scale_factor = z_scale_factor = 1.0;
+  x_offset = y_offset = z_offset = 0.0;
+  xy_decimals = z_decimals = 0;
+  random = 0;
+  for (r = 0; r < LASOFFENDERS_RULES; r++)
+  {
+    number_of_offenders[r] = 0;
+    first[r] = 0;
+    sample[r] = 0;
+  }
+}
+
+LASoffenders::~LASoffenders()
+{
+  U32 r;
+  for (r = 0; r < LASOFFENDERS_RULES; r++)
+  {
+    if (first[r]) free(first[r]);
+  }
+}
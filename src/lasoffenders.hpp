@@ -0,0 +1,108 @@
+/*
+===============================================================================
+
+  FILE:  lasoffenders.hpp
+
+  CONTENTS:
+
+    Remembers which points broke the point level rules so that the report can
+    say where they are and not only how many there are.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- test and count without capturing for the export
+    18 October 2026 -- created to list the points that break the rules
+
+===============================================================================
+*/
+#ifndef LAS_OFFENDERS_HPP
+#define LAS_OFFENDERS_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+#include "xmlwriter.hpp"
+
+#define LASOFFENDERS_OUTSIDE_BOUNDING_BOX   0
+#define LASOFFENDERS_RETURN_NUMBER          1
+#define LASOFFENDERS_NUMBER_OF_RETURNS      2
+#define LASOFFENDERS_RETURN_ABOVE_NUMBER    3
+#define LASOFFENDERS_RULES                  4
+
+class LASoffender
+{
+public:
+  I64 index;
+  I32 X;
+  I32 Y;
+  I32 Z;
+  U8 number_of_returns;
+};
+
+class LASoffenders
+{
+public:
+
+  BOOL init(const LASheader* lasheader, const U32 capture);
+
+  // returns a bit mask with one bit for every rule that the point breaks
+
+  inline U32 test(const LASpoint* laspoint, const BOOL outside_bounding_box) const
+  {
+    U32 return_number, number_of_returns;
+    if (extended)
+    {
+      return_number = laspoint->extended_return_number;
+      number_of_returns = laspoint->extended_number_of_returns_of_given_pulse;
+    }
+    else
+    {
+      return_number = laspoint->return_number;
+      number_of_returns = laspoint->number_of_returns_of_given_pulse;
+    }
+    return ((U32)(outside_bounding_box != FALSE) << LASOFFENDERS_OUTSIDE_BOUNDING_BOX) |
+           ((U32)((return_number == 0) || (return_number > max_return_number)) << LASOFFENDERS_RETURN_NUMBER) |
+           ((U32)((number_of_returns == 0) || (number_of_returns > max_return_number)) << LASOFFENDERS_NUMBER_OF_RETURNS) |
+           ((U32)(return_number > number_of_returns) << LASOFFENDERS_RETURN_ABOVE_NUMBER);
+  };
+
+  void add(const U32 rules, const I64 index, const LASpoint* laspoint);
+  void done();
+
+  I64 get_number_of_offenders(const U32 rule) const { return number_of_offenders[rule]; };
+  BOOL write(XMLwriter& xmlwriter) const;
+
+  LASoffenders();
+  ~LASoffenders();
+
+private:
+  void capture(LASoffender* offender, const I64 index, const LASpoint* laspoint) const;
+
+  BOOL extended;
+  U32 max_return_number;
+  U32 number_first;
+  U32 number_sample;
+  F64 x_scale_factor, y_scale_factor, z_scale_factor;
+  F64 x_offset, y_offset, z_offset;
+  I32 xy_decimals, z_decimals;
+  U64 random;
+  I64 number_of_offenders[LASOFFENDERS_RULES];
+  LASoffender* first[LASOFFENDERS_RULES];
+  LASoffender* sample[LASOFFENDERS_RULES];
+};
+
+#endif
@@ -0,0 +1,126 @@
+/*
+===============================================================================
+
+  FILE:  lasorder.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <math.h>
+
+#include "lasorder.hpp"
+
+BOOL LASorder::init(const LASheader* lasheader)
+{
+  if ((lasheader->x_scale_factor <= 0.0) || (lasheader->y_scale_factor <= 0.0))
+  {
+    return FALSE;
+  }
+
+  if ((lasheader->max_x < lasheader->min_x) || (lasheader->max_y < lasheader->min_y))
+  {
+    return FALSE;
+  }
+
+  // the grid lives in the integer coordinates of the points. a bounding box
+  // that is not finite or far outside of the integer range cannot be used
+
+  F64 min_X = (lasheader->min_x - lasheader->x_offset) / lasheader->x_scale_factor;
+  F64 min_Y = (lasheader->min_y - lasheader->y_offset) / lasheader->y_scale_factor;
+  F64 max_X = (lasheader->max_x - lasheader->x_offset) / lasheader->x_scale_factor;
+  F64 max_Y = (lasheader->max_y - lasheader->y_offset) / lasheader->y_scale_factor;
+  if (!(fabs(min_X) <= LASORDER_MAX_QUANTIZED) || !(fabs(min_Y) <= LASORDER_MAX_QUANTIZED) || !(fabs(max_X) <= LASORDER_MAX_QUANTIZED) || !(fabs(max_Y) <= LASORDER_MAX_QUANTIZED))
+  {
+    return FALSE;
+  }
+
+  // square grid cells in integer coordinates with at most 2^16 cells per axis
+
+  origin_X = I64_QUANTIZE(min_X);
+  origin_Y = I64_QUANTIZE(min_Y);
+  I64 extent_X = I64_QUANTIZE(max_X) - origin_X;
+  I64 extent_Y = I64_QUANTIZE(max_Y) - origin_Y;
+  I64 extent = (extent_X > extent_Y ? extent_X : extent_Y);
+
+  shift = 0;
+  while ((extent >> shift) > 0xFFFF)
+  {
+    shift++;
+  }
+
+  has_gps_time = ((lasheader->point_data_format != 0) && (lasheader->point_data_format != 2));
+  number_of_points = 0;
+  last_code = 0;
+  last_gps_time = 0.0;
+  sum_morton_distance = 0.0;
+  same_coarse_cell = 0;
+  gps_time_not_decreasing = 0;
+
+  return TRUE;
+}
+
+I32 LASorder::classify(F64* average_morton_distance, F64* fraction_same_coarse_cell, F64* fraction_gps_time_not_decreasing) const
+{
+  if (number_of_points < 2)
+  {
+    return LASORDER_UNKNOWN;
+  }
+
+  F64 number_of_pairs = (F64)(number_of_points - 1);
+
+  // the morton distance is normalized by the number of cells so random order averages about 1/3
+
+  *average_morton_distance = sum_morton_distance / number_of_pairs / 4294967296.0;
+  *fraction_same_coarse_cell = same_coarse_cell / number_of_pairs;
+  *fraction_gps_time_not_decreasing = (has_gps_time ? gps_time_not_decreasing / number_of_pairs : 0.0);
+
+  if (*fraction_gps_time_not_decreasing >= 0.99)
+  {
+    return LASORDER_GPS_TIME_SORTED;
+  }
+  if ((*fraction_same_coarse_cell >= 0.9) || (*average_morton_distance <= 0.001))
+  {
+    return LASORDER_SPATIALLY_SORTED;
+  }
+  return LASORDER_UNORDERED;
+}
+
+LASorder::LASorder()
+{
+  origin_X = origin_Y = 0;
+  shift = 0;
+  has_gps_time = FALSE;
+  number_of_points = 0;
+  last_code = 0;
+  last_gps_time = 0.0;
+  sum_morton_distance = 0.0;
+  same_coarse_cell = 0;
+  gps_time_not_decreasing = 0;
+}
+
+LASorder::~LASorder()
+{
+}
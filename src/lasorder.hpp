@@ -0,0 +1,93 @@
+/*
+===============================================================================
+
+  FILE:  lasorder.hpp
+
+  CONTENTS:
+
+    Measures how coherent the order of the points in a LAS file is and classes
+    it as GPS time sorted, spatially sorted, or unordered.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to flag files with poor spatial coherence
+
+===============================================================================
+*/
+#ifndef LAS_ORDER_HPP
+#define LAS_ORDER_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#define LASORDER_MAX_QUANTIZED 4294967296.0
+
+#define LASORDER_UNKNOWN          0
+#define LASORDER_GPS_TIME_SORTED  1
+#define LASORDER_SPATIALLY_SORTED 2
+#define LASORDER_UNORDERED        3
+
+class LASorder
+{
+public:
+
+  BOOL init(const LASheader* lasheader);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    I64 dx = ((I64)laspoint->X - origin_X) >> shift;
+    I64 dy = ((I64)laspoint->Y - origin_Y) >> shift;
+    U32 code = spread((U32)(dx < 0 ? 0 : (dx > 0xFFFF ? 0xFFFF : dx))) | (spread((U32)(dy < 0 ? 0 : (dy > 0xFFFF ? 0xFFFF : dy))) << 1);
+    if (number_of_points)
+    {
+      sum_morton_distance += (code > last_code ? code - last_code : last_code - code);
+      if ((code >> 20) == (last_code >> 20)) same_coarse_cell++;
+      if (laspoint->gps_time >= last_gps_time) gps_time_not_decreasing++;
+    }
+    last_code = code;
+    last_gps_time = laspoint->gps_time;
+    number_of_points++;
+  };
+
+  I32 classify(F64* average_morton_distance, F64* fraction_same_coarse_cell, F64* fraction_gps_time_not_decreasing) const;
+
+  LASorder();
+  ~LASorder();
+
+private:
+  static inline U32 spread(U32 v)
+  {
+    v = (v | (v << 8)) & 0x00FF00FF;
+    v = (v | (v << 4)) & 0x0F0F0F0F;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+  };
+
+  I64 origin_X, origin_Y;
+  U32 shift;
+  BOOL has_gps_time;
+  I64 number_of_points;
+  U32 last_code;
+  F64 last_gps_time;
+  F64 sum_morton_distance;
+  I64 same_coarse_cell;
+  I64 gps_time_not_decreasing;
+};
+
+#endif
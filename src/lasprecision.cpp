@@ -0,0 +1,117 @@
+/*
+===============================================================================
+
+  FILE:  lasprecision.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "lasprecision.hpp"
+
+static const CHAR* const coordinate_names[3] = { "X", "Y", "Z" };
+
+void LASprecision::init(const LASheader* lasheader)
+{
+  number_of_points = 0;
+  first[0] = first[1] = first[2] = 0;
+  resolution[0] = resolution[1] = resolution[2] = 0;
+  scale_factor[0] = lasheader->x_scale_factor;
+  scale_factor[1] = lasheader->y_scale_factor;
+  scale_factor[2] = lasheader->z_scale_factor;
+}
+
+U32 LASprecision::greatest_common_divisor(U32 a, U32 b)
+{
+  while (b)
+  {
+    U32 r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+F64 LASprecision::get_wasted_bits(const U32 coordinate) const
+{
+  if (resolution[coordinate] <= 1)
+  {
+    return 0.0;
+  }
+  return log((F64)resolution[coordinate]) / log(2.0);
+}
+
+void LASprecision::check(LASheader* lasheader) const
+{
+  U32 c;
+  CHAR note[512];
+
+  // coordinates that are all on a coarser grid than the scale factor waste bits
+
+  for (c = 0; c < 3; c++)
+  {
+    if (resolution[c] > 1)
+    {
+      sprintf(note, "resolution fluff in %s: stored at %g but effective %g (x%u) wasting %.1f bits per coordinate", coordinate_names[c], scale_factor[c], scale_factor[c]*resolution[c], resolution[c], get_wasted_bits(c));
+      lasheader->add_warning("coordinate values", note);
+    }
+  }
+}
+
+BOOL LASprecision::get_precision_description(CHAR* description) const
+{
+  U32 c;
+  I32 len = 0;
+
+  if (number_of_points == 0)
+  {
+    return FALSE;
+  }
+
+  for (c = 0; c < 3; c++)
+  {
+    if (resolution[c] == 0)
+    {
+      len += sprintf(description + len, "%s%s constant", (c ? " " : ""), coordinate_names[c]);
+    }
+    else
+    {
+      len += sprintf(description + len, "%s%s %g", (c ? " " : ""), coordinate_names[c], scale_factor[c]*resolution[c]);
+    }
+  }
+  return TRUE;
+}
+
+LASprecision::LASprecision()
+{
+  number_of_points = 0;
+  first[0] = first[1] = first[2] = 0;
+  resolution[0] = resolution[1] = resolution[2] = 0;
+  scale_factor[0] = scale_factor[1] = scale_factor[2] = 1.0;
+}
@@ -0,0 +1,91 @@
+/*
+===============================================================================
+
+  FILE:  lasprecision.hpp
+
+  CONTENTS:
+
+    Measures the effective resolution of the X, Y and Z coordinates as the
+    greatest common divisor of the integer coordinates of the points.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to replace the x10, x100 and x1000 fluff tests
+
+===============================================================================
+*/
+#ifndef LAS_PRECISION_HPP
+#define LAS_PRECISION_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+class LASprecision
+{
+public:
+
+  void init(const LASheader* lasheader);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    if (number_of_points)
+    {
+      if (resolution[0] != 1) reduce(0, laspoint->X);
+      if (resolution[1] != 1) reduce(1, laspoint->Y);
+      if (resolution[2] != 1) reduce(2, laspoint->Z);
+    }
+    else
+    {
+      first[0] = laspoint->X;
+      first[1] = laspoint->Y;
+      first[2] = laspoint->Z;
+    }
+    number_of_points++;
+  };
+
+  void check(LASheader* lasheader) const;
+  BOOL get_precision_description(CHAR* description) const;
+
+  U32 get_resolution(const U32 coordinate) const { return resolution[coordinate]; };
+  F64 get_wasted_bits(const U32 coordinate) const;
+
+  LASprecision();
+
+private:
+  inline void reduce(const U32 coordinate, const I32 value)
+  {
+    I64 delta = (I64)value - (I64)first[coordinate];
+    U32 difference = (U32)(delta < 0 ? -delta : delta);
+    if (resolution[coordinate] == 0)
+    {
+      resolution[coordinate] = difference;
+    }
+    else if (difference % resolution[coordinate])
+    {
+      resolution[coordinate] = greatest_common_divisor(resolution[coordinate], difference);
+    }
+  };
+  static U32 greatest_common_divisor(U32 a, U32 b);
+
+  I64 number_of_points;
+  I32 first[3];
+  U32 resolution[3];
+  F64 scale_factor[3];
+};
+
+#endif
@@ -0,0 +1,156 @@
+/*
+===============================================================================
+
+  FILE:  laspulses.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "laspulses.hpp"
+
+BOOL LASpulses::init(const LASheader* lasheader)
+{
+  // point data formats 0 and 2 have no GPS time
+
+  if ((lasheader->point_data_format == 0) || (lasheader->point_data_format == 2))
+  {
+    return FALSE;
+  }
+  extended = (lasheader->point_data_format >= 6);
+  unordered = FALSE;
+  number_of_points = 0;
+  number_late = 0;
+  open = 0;
+  newest = LASPULSES_WINDOW - 1;
+  latest_gps_time = -F64_MAX;
+  closed_gps_time = 0.0;
+  closed_any = FALSE;
+  number_of_pulses = 0;
+  number_incomplete = 0;
+  number_duplicate = 0;
+  number_inconsistent = 0;
+  return TRUE;
+}
+
+LASpulse* LASpulses::open_pulse(const F64 gps_time, const U16 point_source_ID, const U8 channel, const U8 number_of_returns)
+{
+  // a new pulse earlier than a closed one may have lost returns to that window
+
+  if (closed_any && (gps_time < closed_gps_time))
+  {
+    number_late++;
+    if ((number_of_points >= LASPULSES_MIN_POINTS) && (number_late > LASPULSES_MAX_LATE_FRACTION * number_of_points))
+    {
+      unordered = TRUE;
+      return 0;
+    }
+  }
+
+  // close the oldest pulse when the window is full
+
+  if (open == LASPULSES_WINDOW)
+  {
+    close_pulse(&window[(newest + 1) % LASPULSES_WINDOW]);
+    open--;
+  }
+
+  newest = (newest + 1) % LASPULSES_WINDOW;
+  open++;
+
+  LASpulse* pulse = &window[newest];
+  pulse->gps_time = gps_time;
+  pulse->point_source_ID = point_source_ID;
+  pulse->channel = channel;
+  pulse->number_of_returns = number_of_returns;
+  pulse->returns = 0;
+  pulse->duplicate = FALSE;
+  pulse->inconsistent = FALSE;
+
+  if (gps_time > latest_gps_time)
+  {
+    latest_gps_time = gps_time;
+  }
+  return pulse;
+}
+
+void LASpulses::close_pulse(const LASpulse* pulse)
+{
+  // return numbers 1 to number of returns must all be there
+
+  U16 expected = (U16)(((1u << pulse->number_of_returns) - 1) << 1);
+  if ((pulse->returns & expected) != expected)
+  {
+    number_incomplete++;
+  }
+  if (pulse->duplicate)
+  {
+    number_duplicate++;
+  }
+  if (pulse->inconsistent)
+  {
+    number_inconsistent++;
+  }
+  if (!closed_any || (pulse->gps_time > closed_gps_time))
+  {
+    closed_gps_time = pulse->gps_time;
+    closed_any = TRUE;
+  }
+  number_of_pulses++;
+}
+
+void LASpulses::done()
+{
+  if (unordered)
+  {
+    return;
+  }
+  while (open)
+  {
+    close_pulse(&window[(newest + LASPULSES_WINDOW + 1 - open) % LASPULSES_WINDOW]);
+    open--;
+  }
+}
+
+LASpulses::LASpulses()
+{
+  extended = FALSE;
+  unordered = FALSE;
+  number_of_points = 0;
+  number_late = 0;
+  open = 0;
+  newest = LASPULSES_WINDOW - 1;
+  latest_gps_time = -F64_MAX;
+  closed_gps_time = 0.0;
+  closed_any = FALSE;
+  number_of_pulses = 0;
+  number_incomplete = 0;
+  number_duplicate = 0;
+  number_inconsistent = 0;
+  memset(window, 0, sizeof(window));
+}
@@ -0,0 +1,146 @@
+/*
+===============================================================================
+
+  FILE:  laspulses.hpp
+
+  CONTENTS:
+
+    Reconstructs the laser pulses from their returns and checks them for
+    missing, duplicate and inconsistent returns.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to check that pulses have all their returns
+
+===============================================================================
+*/
+#ifndef LAS_PULSES_HPP
+#define LAS_PULSES_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#define LASPULSES_WINDOW 64
+#define LASPULSES_MIN_POINTS 10000
+#define LASPULSES_MAX_LATE_FRACTION 0.01
+
+class LASpulse
+{
+public:
+  F64 gps_time;
+  U16 point_source_ID;
+  U8 channel;
+  U8 number_of_returns;
+  U16 returns;
+  BOOL duplicate;
+  BOOL inconsistent;
+};
+
+class LASpulses
+{
+public:
+
+  BOOL init(const LASheader* lasheader);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    if (unordered) return;
+    number_of_points++;
+
+    U8 channel, return_number, number_of_returns;
+    if (extended)
+    {
+      channel = laspoint->extended_scanner_channel;
+      return_number = laspoint->extended_return_number;
+      number_of_returns = laspoint->extended_number_of_returns_of_given_pulse;
+    }
+    else
+    {
+      channel = 0;
+      return_number = laspoint->return_number;
+      number_of_returns = laspoint->number_of_returns_of_given_pulse;
+    }
+
+    // search the open pulses newest first unless the point is later than all of them
+
+    LASpulse* pulse = 0;
+    if (open && (laspoint->gps_time <= latest_gps_time))
+    {
+      U32 i, index = newest;
+      for (i = 0; i < open; i++)
+      {
+        LASpulse* candidate = &window[index];
+        if ((candidate->gps_time == laspoint->gps_time) && (candidate->point_source_ID == laspoint->point_source_ID) && (candidate->channel == channel))
+        {
+          pulse = candidate;
+          break;
+        }
+        index = (index + LASPULSES_WINDOW - 1) % LASPULSES_WINDOW;
+      }
+    }
+
+    if (pulse == 0)
+    {
+      pulse = open_pulse(laspoint->gps_time, laspoint->point_source_ID, channel, number_of_returns);
+      if (pulse == 0) return;
+    }
+    else if (pulse->number_of_returns != number_of_returns)
+    {
+      pulse->inconsistent = TRUE;
+    }
+
+    U16 bit = (U16)(1u << return_number);
+    if (pulse->returns & bit)
+    {
+      pulse->duplicate = TRUE;
+    }
+    pulse->returns |= bit;
+  };
+
+  void done();
+
+  BOOL is_unordered() const { return unordered; };
+  BOOL has_scanner_channel() const { return extended; };
+  I64 get_number_of_pulses() const { return number_of_pulses; };
+  I64 get_number_incomplete() const { return number_incomplete; };
+  I64 get_number_duplicate() const { return number_duplicate; };
+  I64 get_number_inconsistent() const { return number_inconsistent; };
+
+  LASpulses();
+
+private:
+  LASpulse* open_pulse(const F64 gps_time, const U16 point_source_ID, const U8 channel, const U8 number_of_returns);
+  void close_pulse(const LASpulse* pulse);
+
+  BOOL extended;
+  BOOL unordered;
+  I64 number_of_points;
+  I64 number_late;
+  U32 open;
+  U32 newest;
+  F64 latest_gps_time;
+  F64 closed_gps_time;
+  BOOL closed_any;
+  I64 number_of_pulses;
+  I64 number_incomplete;
+  I64 number_duplicate;
+  I64 number_inconsistent;
+  LASpulse window[LASPULSES_WINDOW];
+};
+
+#endif
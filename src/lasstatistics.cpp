@@ -0,0 +1,158 @@
+/*
+===============================================================================
+
+  FILE:  lasstatistics.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lasstatistics.hpp"
+
+BOOL LASstatistics::init(const LASheader* lasheader)
+{
+  extended = (lasheader->point_data_format >= 6);
+  number_of_points = 0;
+
+  if (classification == 0)
+  {
+    classification = (U32*)malloc(sizeof(U32)*LASSTATISTICS_LANES*256);
+    user_data = (U32*)malloc(sizeof(U32)*LASSTATISTICS_LANES*256);
+    intensity = (U32*)malloc(sizeof(U32)*LASSTATISTICS_LANES*65536);
+    scan_angle = (U32*)malloc(sizeof(U32)*LASSTATISTICS_LANES*65536);
+    returns = (U32*)malloc(sizeof(U32)*LASSTATISTICS_LANES*256);
+    if ((classification == 0) || (user_data == 0) || (intensity == 0) || (scan_angle == 0) || (returns == 0))
+    {
+      fprintf(stderr, "ERROR: cannot allocate histograms\n");
+      return FALSE;
+    }
+  }
+
+  memset(classification, 0, sizeof(U32)*LASSTATISTICS_LANES*256);
+  memset(user_data, 0, sizeof(U32)*LASSTATISTICS_LANES*256);
+  memset(intensity, 0, sizeof(U32)*LASSTATISTICS_LANES*65536);
+  memset(scan_angle, 0, sizeof(U32)*LASSTATISTICS_LANES*65536);
+  memset(returns, 0, sizeof(U32)*LASSTATISTICS_LANES*256);
+
+  return TRUE;
+}
+
+void LASstatistics::write(XMLwriter& xmlwriter, const CHAR* key, const U32* histogram, const U32 bins, const I32 bias, const F64 scale) const
+{
+  U32 bin, lane;
+  I64 count;
+  CHAR value[64];
+
+  for (bin = 0; bin < bins; bin++)
+  {
+    count = 0;
+    for (lane = 0; lane < LASSTATISTICS_LANES; lane++)
+    {
+      count += histogram[lane*bins + bin];
+    }
+    if (count)
+    {
+      if (scale == 1.0)
+      {
+        sprintf(value, "%d", (I32)bin - bias);
+      }
+      else
+      {
+        sprintf(value, "%.3f", scale*((I32)bin - bias));
+      }
+      xmlwriter.write(key, "value", value, count);
+    }
+  }
+}
+
+BOOL LASstatistics::write(XMLwriter& xmlwriter) const
+{
+  if (number_of_points == 0)
+  {
+    return FALSE;
+  }
+
+  xmlwriter.beginsub("statistics");
+
+  write(xmlwriter, "classification", classification, 256, 0, 1.0);
+  write(xmlwriter, "user_data", user_data, 256, 0, 1.0);
+  write(xmlwriter, "intensity", intensity, 65536, 0, 1.0);
+  if (extended)
+  {
+    write(xmlwriter, "scan_angle", scan_angle, 65536, 32768, 0.006);
+  }
+  else
+  {
+    write(xmlwriter, "scan_angle_rank", scan_angle, 256, 128, 1.0);
+  }
+
+  // the combinations are written as 'return number/number of returns'
+
+  U32 bin, lane;
+  I64 count;
+  CHAR value[64];
+
+  for (bin = 0; bin < 256; bin++)
+  {
+    count = 0;
+    for (lane = 0; lane < LASSTATISTICS_LANES; lane++)
+    {
+      count += returns[lane*256 + bin];
+    }
+    if (count)
+    {
+      sprintf(value, "%u/%u", bin >> 4, bin & 15);
+      xmlwriter.write("returns", "value", value, count);
+    }
+  }
+
+  xmlwriter.endsub("statistics");
+
+  return TRUE;
+}
+
+LASstatistics::LASstatistics()
+{
+  extended = FALSE;
+  number_of_points = 0;
+  classification = 0;
+  user_data = 0;
+  intensity = 0;
+  scan_angle = 0;
+  returns = 0;
+}
+
+LASstatistics::~LASstatistics()
+{
+  if (classification) free(classification);
+  if (user_data) free(user_data);
+  if (intensity) free(intensity);
+  if (scan_angle) free(scan_angle);
+  if (returns) free(returns);
+}
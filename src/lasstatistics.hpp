@@ -0,0 +1,85 @@
+/*
+===============================================================================
+
+  FILE:  lasstatistics.hpp
+
+  CONTENTS:
+
+    Collects histograms of the classification, the user data, the intensity,
+    the scan angle, and the return numbers of the points.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created for the optional <statistics> section
+
+===============================================================================
+*/
+#ifndef LAS_STATISTICS_HPP
+#define LAS_STATISTICS_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#include "xmlwriter.hpp"
+
+#define LASSTATISTICS_LANES 4
+
+class LASstatistics
+{
+public:
+
+  BOOL init(const LASheader* lasheader);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    U32 lane = (U32)(number_of_points & (LASSTATISTICS_LANES - 1));
+    if (extended)
+    {
+      classification[(lane << 8) | laspoint->extended_classification]++;
+      scan_angle[(lane << 16) | (U16)(laspoint->extended_scan_angle + 32768)]++;
+      returns[(lane << 8) | (laspoint->extended_return_number << 4) | laspoint->extended_number_of_returns_of_given_pulse]++;
+    }
+    else
+    {
+      classification[(lane << 8) | laspoint->classification]++;
+      scan_angle[(lane << 8) | (U8)(laspoint->scan_angle_rank + 128)]++;
+      returns[(lane << 8) | (laspoint->return_number << 4) | laspoint->number_of_returns_of_given_pulse]++;
+    }
+    user_data[(lane << 8) | laspoint->user_data]++;
+    intensity[(lane << 16) | laspoint->intensity]++;
+    number_of_points++;
+  };
+
+  BOOL write(XMLwriter& xmlwriter) const;
+
+  LASstatistics();
+  ~LASstatistics();
+
+private:
+  void write(XMLwriter& xmlwriter, const CHAR* key, const U32* histogram, const U32 bins, const I32 bias, const F64 scale) const;
+
+  BOOL extended;
+  I64 number_of_points;
+  U32* classification;
+  U32* user_data;
+  U32* intensity;
+  U32* scan_angle;
+  U32* returns;
+};
+
+#endif
@@ -35,9 +35,16 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "lasreadopener.hpp"
 #include "xmlwriter.hpp"
 #include "lascheck.hpp"
+#include "lasdataset.hpp"
+#include "dirwalker.hpp"
 
 #define VALIDATE_VERSION  140513
 
@@ -92,10 +99,43 @@ static void usage(int return_code, BOOL wait=FALSE)
   fprintf(stderr,"lasvalidate -i c:\\data\\lidar.las -oxml\n");
   fprintf(stderr,"lasvalidate -i ..\\subfolder\\*.las -o summary.xml\n");
   fprintf(stderr,"lasvalidate -v -i ..\\..\\flight\\*.laz -o oxml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -density 2 -density_cell_size 1 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -voids 4 -voids_spacing 0.7 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -gps_time_gap 0.5 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -flightlines -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -scan_direction -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -point_order -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -statistics -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -dataset -dataset_tolerance 0.05 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -dataset_duplicates 0.5 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -header_only -prefetch 256 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -sample_crs 100000 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -pulses -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -offenders 10 -o summary.xml\n");
+  fprintf(stderr,"lasvalidate -i *.laz -export_offenders repair -o summary.xml\n");
   fprintf(stderr,"lasvalidate -h\n");
   byebye(return_code, wait);
 }
 
+#define VALIDATE_PREFETCH_SIZE 65536
+
+static void prefetch_header(const CHAR* file_name)
+{
+#ifndef _WIN32
+  // ask the kernel to start reading the header and the VLRs in the
+  // background. the file is closed right away but the pages stay cached
+
+  int fd = open(file_name, O_RDONLY);
+  if (fd != -1)
+  {
+#ifdef POSIX_FADV_WILLNEED
+    posix_fadvise(fd, 0, VALIDATE_PREFETCH_SIZE, POSIX_FADV_WILLNEED);
+#endif
+    close(fd);
+  }
+#endif
+}
+
 static double taketime()
 {
   return (double)(clock())/CLOCKS_PER_SEC;
@@ -121,6 +161,28 @@ int main(int argc, char *argv[])
   U32 num_pass = 0;
   U32 num_fail = 0;
   U32 num_warning = 0;
+  BOOL check_density = FALSE;
+  F64 density_min = 0.0;
+  F64 density_cell_size = 1.0;
+  BOOL check_voids = FALSE;
+  F64 voids_multiple = 4.0;
+  F64 voids_spacing = 0.0;
+  BOOL check_gps_time = FALSE;
+  BOOL summarize_flightlines = FALSE;
+  BOOL check_scan_direction = FALSE;
+  F64 gps_time_gap = 1.0;
+  BOOL check_point_order = FALSE;
+  BOOL compute_statistics = FALSE;
+  BOOL check_dataset = FALSE;
+  F64 dataset_tolerance = 0.01;
+  F64 dataset_band_width = 0.0;
+  BOOL header_only = FALSE;
+  I32 prefetch_window = -1;
+  U32 crs_sample_size = 0;
+  BOOL check_pulses = FALSE;
+  U32 capture_offenders = 0;
+  CHAR* export_offenders = 0;
+  DIRwalker* dirwalker = 0;
 
   fprintf(stderr, "This is version '%s' of the LAS validator. Please contact\n", "GRiD-1");
   fprintf(stderr, "me at 'martin.isenburg@rapidlasso.com' if you disagree with\n");
@@ -186,9 +248,13 @@ int main(int argc, char *argv[])
         usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
       }
       i+=1;
+      if (dirwalker == 0)
+      {
+        dirwalker = new DIRwalker();
+      }
       do
       {
-        lasreadopener.add_directory(argv[i], TRUE);
+        dirwalker->add(argv[i]);
         i+=1;
       } while (i < argc && *argv[i] != '-');
       i-=1;
@@ -235,6 +301,154 @@ int main(int argc, char *argv[])
     {
       one_report_per_file = TRUE;
     }
+    else if (strcmp(argv[i],"-density") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: min_density\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      check_density = TRUE;
+      density_min = atof(argv[i]);
+    }
+    else if (strcmp(argv[i],"-density_cell_size") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: cell_size\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      density_cell_size = atof(argv[i]);
+      if (density_cell_size <= 0.0)
+      {
+        fprintf(stderr,"ERROR: cell_size %g of '%s' must be positive\n", density_cell_size, argv[i-1]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+    }
+    else if (strcmp(argv[i],"-voids") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: multiple_of_nominal_point_spacing\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      check_voids = TRUE;
+      voids_multiple = atof(argv[i]);
+    }
+    else if (strcmp(argv[i],"-voids_spacing") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: nominal_point_spacing\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      voids_spacing = atof(argv[i]);
+    }
+    else if (strcmp(argv[i],"-gps_time_gap") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: seconds\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      check_gps_time = TRUE;
+      gps_time_gap = atof(argv[i]);
+    }
+    else if (strcmp(argv[i],"-flightlines") == 0)
+    {
+      summarize_flightlines = TRUE;
+    }
+    else if (strcmp(argv[i],"-scan_direction") == 0)
+    {
+      check_scan_direction = TRUE;
+    }
+    else if (strcmp(argv[i],"-point_order") == 0)
+    {
+      check_point_order = TRUE;
+    }
+    else if (strcmp(argv[i],"-statistics") == 0)
+    {
+      compute_statistics = TRUE;
+    }
+    else if (strcmp(argv[i],"-dataset") == 0)
+    {
+      check_dataset = TRUE;
+    }
+    else if (strcmp(argv[i],"-dataset_tolerance") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: tolerance\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      check_dataset = TRUE;
+      dataset_tolerance = atof(argv[i]);
+    }
+    else if (strcmp(argv[i],"-dataset_duplicates") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: band_width\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      check_dataset = TRUE;
+      dataset_band_width = atof(argv[i]);
+    }
+    else if (strcmp(argv[i],"-header_only") == 0)
+    {
+      header_only = TRUE;
+    }
+    else if (strcmp(argv[i],"-prefetch") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: number_of_files\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      prefetch_window = atoi(argv[i]);
+    }
+    else if (strcmp(argv[i],"-sample_crs") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: number_of_points\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      crs_sample_size = (U32)atoi(argv[i]);
+    }
+    else if (strcmp(argv[i],"-pulses") == 0)
+    {
+      check_pulses = TRUE;
+    }
+    else if (strcmp(argv[i],"-offenders") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: number\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      capture_offenders = (U32)atoi(argv[i]);
+    }
+    else if (strcmp(argv[i],"-export_offenders") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: directory\n", argv[i]);
+        usage(LAS_VALIDATE_WRONG_COMMAND_LINE_SYNTAX);
+      }
+      i++;
+      export_offenders = argv[i];
+    }
     else
     {
       fprintf(stderr, "ERROR: cannot understand argument '%s'\n", argv[i]);
@@ -246,6 +460,13 @@ int main(int argc, char *argv[])
 
   if (verbose) full_start_time = taketime();
 
+  // maybe find the first files of the directories given with '-irec'
+
+  if (dirwalker)
+  {
+    dirwalker->walk(lasreadopener, 2);
+  }
+
   // check input
 
   if (!lasreadopener.is_active())
@@ -284,6 +505,33 @@ int main(int argc, char *argv[])
 
   U32 total_pass = VALIDATE_PASS;
 
+  // when only headers are checked the time goes into opening files so by
+  // default we keep the reads for the next files in flight
+
+  if (prefetch_window < 0)
+  {
+    prefetch_window = (header_only ? 64 : 0);
+  }
+
+  U32 prefetched = 0;
+
+  // maybe collect the bounding boxes of all tiles for the summary report
+
+  LASdataset* lasdataset = 0;
+
+  if (check_dataset)
+  {
+    if (one_report_per_file)
+    {
+      fprintf(stderr, "WARNING: dataset checks need a summary report. ignoring '-dataset' ...\n");
+    }
+    else
+    {
+      lasdataset = new LASdataset();
+      lasdataset->set_band_width(dataset_band_width);
+    }
+  }
+
   // possibly loop over multiple input files
 
   while (lasreadopener.is_active())
@@ -292,6 +540,29 @@ int main(int argc, char *argv[])
 
     if (very_verbose) start_time = taketime();
 
+    // maybe keep discovering files of the directories given with '-irec'.
+    // one more than the current file keeps the loop going until all found
+
+    if (dirwalker)
+    {
+      dirwalker->walk(lasreadopener, (U32)prefetch_window + 2);
+    }
+
+    // maybe prefetch the headers of the next files
+
+    if (prefetch_window)
+    {
+      if (prefetched < lasreadopener.get_file_name_current())
+      {
+        prefetched = lasreadopener.get_file_name_current();
+      }
+      while ((prefetched < lasreadopener.get_file_name_number()) && (prefetched < lasreadopener.get_file_name_current() + (U32)prefetch_window))
+      {
+        prefetch_header(lasreadopener.get_file_name(prefetched));
+        prefetched++;
+      }
+    }
+
     // open lasreader
 
     LASreader* lasreader = lasreadopener.open();
@@ -350,23 +621,189 @@ int main(int argc, char *argv[])
     CHAR crsdescription[512];
     strcpy(crsdescription, "not valid or not specified");
 
+    CHAR densitydescription[512];
+    densitydescription[0] = '\0';
+
+    CHAR orderdescription[512];
+    orderdescription[0] = '\0';
+
+    CHAR footprintdescription[512];
+    footprintdescription[0] = '\0';
+
+    CHAR flagsdescription[512];
+    flagsdescription[0] = '\0';
+
+    CHAR precisiondescription[512];
+    precisiondescription[0] = '\0';
+
+    CHAR bitdepthdescription[512];
+    bitdepthdescription[0] = '\0';
+
+    CHAR pulsedescription[512];
+    pulsedescription[0] = '\0';
+
+    LAScheck* lascheck = 0;
+
     if (lasheader->fails == 0)
     {
+      // maybe remember the bounding box of this tile and collect its edge bands
+
+      BOOL collect_bands = FALSE;
+
+      if (lasdataset)
+      {
+        collect_bands = (lasdataset->add(lasreadopener.get_file_name(), lasheader) && (dataset_band_width > 0.0));
+      }
+
       // header was loaded. now parse and check.
 
-      LAScheck lascheck(lasheader);
+      lascheck = new LAScheck(lasheader);
+
+      if (check_density)
+      {
+        lascheck->set_density(lasheader, density_cell_size, density_min);
+      }
+
+      if (check_voids)
+      {
+        lascheck->set_voids(lasheader, voids_multiple, voids_spacing);
+      }
+
+      if (check_gps_time)
+      {
+        lascheck->set_gps_time_analysis(lasheader, gps_time_gap);
+      }
+
+      if (summarize_flightlines)
+      {
+        lascheck->set_flightline_summary(lasheader);
+      }
+
+      if (check_scan_direction)
+      {
+        lascheck->set_scan_direction_check(lasheader);
+      }
+
+      if (check_point_order)
+      {
+        lascheck->set_point_order(lasheader);
+      }
+
+      if (compute_statistics)
+      {
+        lascheck->set_statistics(lasheader);
+      }
+
+      if (crs_sample_size)
+      {
+        lascheck->set_crs_sample(lasheader, crs_sample_size);
+      }
+
+      if (check_pulses)
+      {
+        lascheck->set_pulse_check(lasheader);
+      }
+
+      if (capture_offenders)
+      {
+        lascheck->set_offenders(lasheader, capture_offenders);
+      }
 
-      while (lasreader->read_point())
+      if (!header_only)
       {
-        lascheck.parse(&lasreader->point);
+        lascheck->set_waveform_check(lasheader, lasreadopener.get_file_name());
+      }
+
+      if (export_offenders && !header_only)
+      {
+        lascheck->set_export_offenders(lasheader, export_offenders, lasreadopener.get_file_name());
+      }
+
+      lascheck->set_extra_bytes(lasheader);
+
+      if (header_only)
+      {
+        // no point pass. only the header, the VLRs and the CRS are checked
+      }
+      else if (collect_bands)
+      {
+        while (lasreader->read_point())
+        {
+          lascheck->parse(&lasreader->point);
+          lasdataset->add(&lasreader->point);
+        }
+        lasdataset->done();
+      }
+      else
+      {
+        while (lasreader->read_point())
+        {
+          lascheck->parse(&lasreader->point);
+        }
       }
 
       // check header and points and get CRS description
 
-      lascheck.check(lasheader, crsdescription);
+      lascheck->check(lasheader, crsdescription, lasreadopener.get_file_name());
+
+      // get density description
+
+      lascheck->get_density_description(densitydescription);
+
+      // get point order description
+
+      lascheck->get_point_order_description(orderdescription);
+
+      // get geographic footprint of the sampled points
+
+      lascheck->get_footprint_description(footprintdescription);
+
+      // get counts of flagged points
+
+      lascheck->get_flags_description(flagsdescription);
+
+      // get effective coordinate resolution description
+
+      lascheck->get_precision_description(precisiondescription);
+
+      // get bit depth of intensity and colors description
+
+      lascheck->get_bit_depth_description(bitdepthdescription);
+
+      // get pulse completeness description
+
+      lascheck->get_pulse_description(pulsedescription);
     }
 
     xmlwriter.write("CRS", crsdescription);
+    if (densitydescription[0])
+    {
+      xmlwriter.write("density", densitydescription);
+    }
+    if (orderdescription[0])
+    {
+      xmlwriter.write("point_order", orderdescription);
+    }
+    if (footprintdescription[0])
+    {
+      xmlwriter.write("footprint", footprintdescription);
+    }
+    if (flagsdescription[0])
+    {
+      xmlwriter.write("flags", flagsdescription);
+    }
+    if (precisiondescription[0])
+    {
+      xmlwriter.write("precision", precisiondescription);
+    }
+    if (bitdepthdescription[0])
+    {
+      xmlwriter.write("bit_depth", bitdepthdescription);
+    }
+    if (pulsedescription[0])
+    {
+      xmlwriter.write("pulses", pulsedescription);
+    }
     xmlwriter.endsub("file");    
 
     // report the verdict
@@ -391,6 +828,10 @@ int main(int argc, char *argv[])
       {
         xmlwriter.write(lasheader->warnings[i], "warning", lasheader->warnings[i+1]);
       }
+      if (lascheck)
+      {
+        lascheck->write_offenders(xmlwriter);
+      }
       xmlwriter.endsub("details");
       total_pass |= pass;
       if (pass & VALIDATE_FAIL)
@@ -407,6 +848,16 @@ int main(int argc, char *argv[])
       num_pass++;
     }
 
+    // maybe report attribute statistics
+
+    if (lascheck)
+    {
+      lascheck->write_statistics(xmlwriter);
+      lascheck->write_flightlines(xmlwriter);
+      lascheck->write_extra_bytes(xmlwriter);
+      delete lascheck;
+    }
+
     // end the report
 
     xmlwriter.end("report");
@@ -459,6 +910,17 @@ int main(int argc, char *argv[])
 
   if (!one_report_per_file)
   {
+    // maybe report overlaps and gaps between the tiles
+
+    if (lasdataset)
+    {
+      if (lasdataset->check(xmlwriter, dataset_tolerance))
+      {
+        total_pass |= VALIDATE_WARNING;
+      }
+      delete lasdataset;
+    }
+
     // report the total verdict
 
     xmlwriter.begin("total");
@@ -483,6 +945,11 @@ int main(int argc, char *argv[])
     xmlwriter.close("LASvalidator");
   }
 
+  if (dirwalker)
+  {
+    delete dirwalker;
+  }
+
   // in verbose mode we report the total time
 
   if (verbose && (lasreadopener.get_file_name_number() > 1))
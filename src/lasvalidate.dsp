@@ -99,14 +99,74 @@ SOURCE=.\crscheck.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\dirwalker.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasbitdepth.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\lascheck.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\lasclassification.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasdataset.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasdensity.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasexport.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasextrabytes.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasflightlines.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasoffenders.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasorder.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasprecision.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\laspulses.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasstatistics.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\lasvalidate.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\lasvoids.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\laswaveforms.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\xmlwriter.cpp
 # End Source File
 # End Group
@@ -119,10 +179,70 @@ SOURCE=.\crscheck.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\dirwalker.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasbitdepth.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\lascheck.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\lasclassification.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasdataset.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasdensity.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasexport.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasextrabytes.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasflightlines.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasoffenders.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasorder.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasprecision.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\laspulses.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasstatistics.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\lasvoids.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\laswaveforms.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\lasread\inc\lasdefinitions.hpp
 # End Source File
 # Begin Source File
@@ -0,0 +1,375 @@
+/*
+===============================================================================
+
+  FILE:  lasvoids.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "lasvoids.hpp"
+
+class LASvoidRun
+{
+public:
+  U32 row;
+  U32 start;
+  U32 end;
+  U32 parent;
+};
+
+static U32 find_root(LASvoidRun* runs, U32 index)
+{
+  while (runs[index].parent != index)
+  {
+    runs[index].parent = runs[runs[index].parent].parent;
+    index = runs[index].parent;
+  }
+  return index;
+}
+
+static void merge_roots(LASvoidRun* runs, U32 a, U32 b)
+{
+  a = find_root(runs, a);
+  b = find_root(runs, b);
+  if (a < b)
+  {
+    runs[b].parent = a;
+  }
+  else if (b < a)
+  {
+    runs[a].parent = b;
+  }
+}
+
+static int compare_voids(const void* a, const void* b)
+{
+  F64 area_a = ((const LASvoid*)a)->area;
+  F64 area_b = ((const LASvoid*)b)->area;
+  if (area_a > area_b) return -1;
+  if (area_a < area_b) return 1;
+  return 0;
+}
+
+BOOL LASvoids::init(const LASheader* lasheader, const F64 cell_size)
+{
+  if (bits)
+  {
+    free(bits);
+    bits = 0;
+  }
+
+  if ((cell_size <= 0.0) || (lasheader->x_scale_factor <= 0.0) || (lasheader->y_scale_factor <= 0.0))
+  {
+    return FALSE;
+  }
+
+  if ((lasheader->max_x < lasheader->min_x) || (lasheader->max_y < lasheader->min_y))
+  {
+    return FALSE;
+  }
+
+  // the bitmap lives in the integer coordinates of the points. a bounding box
+  // that is not finite or far outside of the integer range cannot be used
+
+  F64 min_X = (lasheader->min_x - lasheader->x_offset) / lasheader->x_scale_factor;
+  F64 min_Y = (lasheader->min_y - lasheader->y_offset) / lasheader->y_scale_factor;
+  F64 max_X = (lasheader->max_x - lasheader->x_offset) / lasheader->x_scale_factor;
+  F64 max_Y = (lasheader->max_y - lasheader->y_offset) / lasheader->y_scale_factor;
+  if (!(fabs(min_X) <= LASVOIDS_MAX_QUANTIZED) || !(fabs(min_Y) <= LASVOIDS_MAX_QUANTIZED) || !(fabs(max_X) <= LASVOIDS_MAX_QUANTIZED) || !(fabs(max_Y) <= LASVOIDS_MAX_QUANTIZED))
+  {
+    return FALSE;
+  }
+
+  origin_X = I64_QUANTIZE(min_X);
+  origin_Y = I64_QUANTIZE(min_Y);
+  I64 extent_X = I64_QUANTIZE(max_X) - origin_X;
+  I64 extent_Y = I64_QUANTIZE(max_Y) - origin_Y;
+  if (extent_X < 0) extent_X = 0;
+  if (extent_Y < 0) extent_Y = 0;
+
+  // double the cell size until the bitmap is small enough
+
+  this->cell_size = cell_size;
+
+  while (TRUE)
+  {
+    I64 quantized_cell_X = I64_QUANTIZE(this->cell_size / lasheader->x_scale_factor);
+    I64 quantized_cell_Y = I64_QUANTIZE(this->cell_size / lasheader->y_scale_factor);
+    cell_X = (quantized_cell_X < 1 ? 1 : (U64)quantized_cell_X);
+    cell_Y = (quantized_cell_Y < 1 ? 1 : (U64)quantized_cell_Y);
+    U64 ncols = extent_X / cell_X + 1;
+    U64 nrows = extent_Y / cell_Y + 1;
+    if ((ncols <= LASVOIDS_MAX_CELLS) && (nrows <= LASVOIDS_MAX_CELLS) && ((ncols * nrows) <= LASVOIDS_MAX_CELLS))
+    {
+      this->ncols = (U32)ncols;
+      this->nrows = (U32)nrows;
+      break;
+    }
+    this->cell_size *= 2.0;
+  }
+
+  stride = (ncols + 31) / 32;
+
+  bits = (U32*)calloc(stride*nrows, sizeof(U32));
+  if (bits == 0)
+  {
+    fprintf(stderr, "ERROR: cannot allocate occupancy bitmap of %u by %u cells\n", ncols, nrows);
+    return FALSE;
+  }
+
+  x_cell_size = cell_X * lasheader->x_scale_factor;
+  y_cell_size = cell_Y * lasheader->y_scale_factor;
+  origin_x = lasheader->x_scale_factor * origin_X + lasheader->x_offset;
+  origin_y = lasheader->y_scale_factor * origin_Y + lasheader->y_offset;
+
+  return TRUE;
+}
+
+U32 LASvoids::find(const F64 min_void_area)
+{
+  if (voids)
+  {
+    free(voids);
+    voids = 0;
+  }
+  number_voids = 0;
+
+  if (bits == 0)
+  {
+    return 0;
+  }
+
+  // collect the runs of empty cells row by row and merge those that overlap a run in the row below
+
+  U32 row, col, start;
+  U32 run_alloc = 1024;
+  U32 run_num = 0;
+  LASvoidRun* runs = (LASvoidRun*)malloc(sizeof(LASvoidRun)*run_alloc);
+  if (runs == 0)
+  {
+    fprintf(stderr, "ERROR: cannot allocate %u runs of empty cells\n", run_alloc);
+    return 0;
+  }
+  U32 prev_begin = 0, prev_end = 0;
+
+  for (row = 0; row < nrows; row++)
+  {
+    const U32* row_bits = bits + row*stride;
+    U32 curr_begin = run_num;
+    U32 prev = prev_begin;
+    col = 0;
+    while (col < ncols)
+    {
+      // skip over fully occupied words
+
+      if (((col & 31) == 0) && (row_bits[col >> 5] == 0xFFFFFFFF))
+      {
+        col += 32;
+        continue;
+      }
+      if (row_bits[col >> 5] & (1u << (col & 31)))
+      {
+        col++;
+        continue;
+      }
+
+      // found the start of a run of empty cells
+
+      start = col;
+      while (col < ncols)
+      {
+        if (((col & 31) == 0) && (row_bits[col >> 5] == 0) && ((col + 32) <= ncols))
+        {
+          col += 32;
+        }
+        else if ((row_bits[col >> 5] & (1u << (col & 31))) == 0)
+        {
+          col++;
+        }
+        else
+        {
+          break;
+        }
+      }
+
+      if (run_num == run_alloc)
+      {
+        LASvoidRun* more_runs = (LASvoidRun*)realloc(runs, sizeof(LASvoidRun)*2*run_alloc);
+        if (more_runs == 0)
+        {
+          fprintf(stderr, "ERROR: cannot allocate %u runs of empty cells\n", 2*run_alloc);
+          free(runs);
+          return 0;
+        }
+        runs = more_runs;
+        run_alloc *= 2;
+      }
+
+      LASvoidRun* run = &runs[run_num];
+      run->row = row;
+      run->start = start;
+      run->end = col - 1;
+      run->parent = run_num;
+
+      // merge with all runs of the previous row that share a column
+
+      while ((prev < prev_end) && (runs[prev].end < start))
+      {
+        prev++;
+      }
+      U32 p = prev;
+      while ((p < prev_end) && (runs[p].start <= run->end))
+      {
+        merge_roots(runs, p, run_num);
+        p++;
+      }
+
+      run_num++;
+    }
+    prev_begin = curr_begin;
+    prev_end = run_num;
+  }
+
+  if (run_num == 0)
+  {
+    free(runs);
+    return 0;
+  }
+
+  // accumulate the size and the extent of every component at its root
+
+  U64* cells = (U64*)calloc(run_num, sizeof(U64));
+  U32* bounds = (U32*)malloc(sizeof(U32)*4*run_num);
+  BOOL* border = (BOOL*)calloc(run_num, sizeof(BOOL));
+  if ((cells == 0) || (bounds == 0) || (border == 0))
+  {
+    fprintf(stderr, "ERROR: cannot allocate components of %u runs of empty cells\n", run_num);
+    if (border) free(border);
+    if (bounds) free(bounds);
+    if (cells) free(cells);
+    free(runs);
+    return 0;
+  }
+
+  U32 i, r;
+  for (i = 0; i < run_num; i++)
+  {
+    r = find_root(runs, i);
+    if (cells[r] == 0)
+    {
+      bounds[4*r+0] = runs[i].start;
+      bounds[4*r+1] = runs[i].row;
+      bounds[4*r+2] = runs[i].end;
+      bounds[4*r+3] = runs[i].row;
+    }
+    else
+    {
+      if (runs[i].start < bounds[4*r+0]) bounds[4*r+0] = runs[i].start;
+      if (runs[i].row < bounds[4*r+1]) bounds[4*r+1] = runs[i].row;
+      if (runs[i].end > bounds[4*r+2]) bounds[4*r+2] = runs[i].end;
+      if (runs[i].row > bounds[4*r+3]) bounds[4*r+3] = runs[i].row;
+    }
+    cells[r] += (runs[i].end - runs[i].start + 1);
+    if ((runs[i].start == 0) || (runs[i].end == ncols - 1) || (runs[i].row == 0) || (runs[i].row == nrows - 1))
+    {
+      border[r] = TRUE;
+    }
+  }
+
+  // keep the interior components that are large enough
+
+  F64 cell_area = x_cell_size * y_cell_size;
+  U32 void_alloc = 0;
+
+  for (i = 0; i < run_num; i++)
+  {
+    if ((runs[i].parent != i) || border[i]) continue;
+    F64 area = cells[i] * cell_area;
+    if (area < min_void_area) continue;
+    if (number_voids == void_alloc)
+    {
+      void_alloc = (void_alloc ? 2*void_alloc : 16);
+      LASvoid* more_voids = (LASvoid*)realloc(voids, sizeof(LASvoid)*void_alloc);
+      if (more_voids == 0)
+      {
+        fprintf(stderr, "ERROR: cannot allocate %u voids\n", void_alloc);
+        if (voids) free(voids);
+        voids = 0;
+        number_voids = 0;
+        free(border);
+        free(bounds);
+        free(cells);
+        free(runs);
+        return 0;
+      }
+      voids = more_voids;
+    }
+    LASvoid* v = &voids[number_voids];
+    v->area = area;
+    v->min_x = origin_x + bounds[4*i+0] * x_cell_size;
+    v->min_y = origin_y + bounds[4*i+1] * y_cell_size;
+    v->max_x = origin_x + (bounds[4*i+2] + 1) * x_cell_size;
+    v->max_y = origin_y + (bounds[4*i+3] + 1) * y_cell_size;
+    number_voids++;
+  }
+
+  free(border);
+  free(bounds);
+  free(cells);
+  free(runs);
+
+  // largest voids first
+
+  if (number_voids > 1)
+  {
+    qsort(voids, number_voids, sizeof(LASvoid), compare_voids);
+  }
+
+  return number_voids;
+}
+
+LASvoids::LASvoids()
+{
+  origin_X = origin_Y = 0;
+  cell_X = cell_Y = 1;
+  ncols = nrows = stride = 0;
+  cell_size = 0.0;
+  x_cell_size = y_cell_size = 0.0;
+  origin_x = origin_y = 0.0;
+  bits = 0;
+  number_voids = 0;
+  voids = 0;
+}
+
+LASvoids::~LASvoids()
+{
+  if (bits) free(bits);
+  if (voids) free(voids);
+}
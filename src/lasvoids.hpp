@@ -0,0 +1,82 @@
+/*
+===============================================================================
+
+  FILE:  lasvoids.hpp
+
+  CONTENTS:
+
+    Finds data voids in a LAS file as the interior components of the empty
+    cells of an occupancy bitmap with one bit per cell.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to find holes larger than the nominal spacing
+
+===============================================================================
+*/
+#ifndef LAS_VOIDS_HPP
+#define LAS_VOIDS_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#define LASVOIDS_MAX_QUANTIZED 4294967296.0
+#define LASVOIDS_MAX_CELLS (1 << 26)
+
+class LASvoid
+{
+public:
+  F64 area;
+  F64 min_x, min_y, max_x, max_y;
+};
+
+class LASvoids
+{
+public:
+
+  BOOL init(const LASheader* lasheader, const F64 cell_size);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    U64 col = (U64)((I64)laspoint->X - origin_X) / cell_X;
+    if (col >= ncols) return;
+    U64 row = (U64)((I64)laspoint->Y - origin_Y) / cell_Y;
+    if (row >= nrows) return;
+    bits[row*stride + (col >> 5)] |= (1u << (col & 31));
+  };
+
+  U32 find(const F64 min_void_area);
+  const LASvoid* get_void(const U32 index) const { return (index < number_voids ? &voids[index] : 0); };
+  F64 get_cell_size() const { return cell_size; };
+
+  LASvoids();
+  ~LASvoids();
+
+private:
+  I64 origin_X, origin_Y;
+  U64 cell_X, cell_Y;
+  U32 ncols, nrows, stride;
+  F64 cell_size;
+  F64 x_cell_size, y_cell_size;
+  F64 origin_x, origin_y;
+  U32* bits;
+  U32 number_voids;
+  LASvoid* voids;
+};
+
+#endif
@@ -0,0 +1,227 @@
+/*
+===============================================================================
+
+  FILE:  laswaveforms.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "laswaveforms.hpp"
+
+#ifdef _WIN32
+#define laswaveforms_fseek _fseeki64
+#define laswaveforms_ftell _ftelli64
+#else
+#define laswaveforms_fseek fseeko
+#define laswaveforms_ftell ftello
+#endif
+
+static int compare_runs(const void* a, const void* b)
+{
+  U64 start_a = ((const LASwaveformRun*)a)->start;
+  U64 start_b = ((const LASwaveformRun*)b)->start;
+  if (start_a < start_b) return -1;
+  if (start_a > start_b) return 1;
+  return 0;
+}
+
+BOOL LASwaveforms::init(const LASheader* lasheader, const CHAR* file_name)
+{
+  U32 i;
+
+  if ((lasheader->point_data_format != 4) && (lasheader->point_data_format != 5) && (lasheader->point_data_format != 9) && (lasheader->point_data_format != 10))
+  {
+    return FALSE;
+  }
+
+  if ((file_name == 0) || ((lasheader->global_encoding & 6) == 0))
+  {
+    return FALSE;
+  }
+
+  // the size of an uncompressed packet follows from its descriptor
+
+  for (i = 0; i < 256; i++)
+  {
+    expected_size[i] = 0;
+    if (lasheader->wave_packet_descriptor && lasheader->wave_packet_descriptor[i] && (lasheader->wave_packet_descriptor[i]->getCompressionType() == 0))
+    {
+      expected_size[i] = (lasheader->wave_packet_descriptor[i]->getBitsPerSample() * lasheader->wave_packet_descriptor[i]->getNumberOfSamples() + 7) / 8;
+    }
+  }
+
+  // find where the waveform data ends
+
+  external = ((lasheader->global_encoding & 4) == 4);
+  missing = FALSE;
+  data_end = LASWAVEFORMS_HEADER_SIZE;
+
+  FILE* file = 0;
+
+  if (external)
+  {
+    // the external file has the name of the LAS file with the extension *.wdp
+
+    if (wdp_file_name) free(wdp_file_name);
+    wdp_file_name = strdup(file_name);
+    CHAR* extension = strrchr(wdp_file_name, '.');
+    if (extension && (strlen(extension) == 4))
+    {
+      BOOL upper = ((extension[1] >= 'A') && (extension[1] <= 'Z'));
+      strcpy(extension, (upper ? ".WDP" : ".wdp"));
+      file = fopen(wdp_file_name, "rb");
+    }
+    if (file == 0)
+    {
+      missing = TRUE;
+      return TRUE;
+    }
+    laswaveforms_fseek(file, 0, SEEK_END);
+    U64 file_size = (U64)laswaveforms_ftell(file);
+    if (file_size > LASWAVEFORMS_HEADER_SIZE)
+    {
+      data_end = file_size;
+    }
+  }
+  else
+  {
+    // the internal waveform data packet record starts with an EVLR header
+
+    file = fopen(file_name, "rb");
+    if (file == 0)
+    {
+      return FALSE;
+    }
+    laswaveforms_fseek(file, 0, SEEK_END);
+    U64 file_size = (U64)laswaveforms_ftell(file);
+    U64 start = lasheader->start_of_waveform_data_packet_record;
+    if (start < file_size)
+    {
+      U64 available = file_size - start;
+      U8 header[LASWAVEFORMS_HEADER_SIZE];
+      I64 record_length_after_header;
+      if ((laswaveforms_fseek(file, start, SEEK_SET) == 0) && (fread(header, 1, LASWAVEFORMS_HEADER_SIZE, file) == LASWAVEFORMS_HEADER_SIZE))
+      {
+        memcpy(&record_length_after_header, header + 20, 8);
+        if ((record_length_after_header >= 0) && ((U64)record_length_after_header <= (available - LASWAVEFORMS_HEADER_SIZE)))
+        {
+          available = LASWAVEFORMS_HEADER_SIZE + record_length_after_header;
+        }
+      }
+      if (available > LASWAVEFORMS_HEADER_SIZE)
+      {
+        data_end = available;
+      }
+    }
+  }
+  fclose(file);
+
+  last_start = 1;
+  last_end = 0;
+  number_of_packets = 0;
+  number_outside = 0;
+  first_outside_start = 0;
+  first_outside_size = 0;
+  number_wrong_size = 0;
+  run_number = 0;
+
+  return TRUE;
+}
+
+void LASwaveforms::add_run(const U64 start, const U64 end)
+{
+  if (run_number == run_alloc)
+  {
+    run_alloc = (run_alloc ? 2*run_alloc : 1024);
+    runs = (LASwaveformRun*)realloc(runs, sizeof(LASwaveformRun)*run_alloc);
+    if (runs == 0)
+    {
+      fprintf(stderr, "ERROR: cannot allocate %u runs of waveform packets\n", run_alloc);
+      run_number = run_alloc = 0;
+      return;
+    }
+  }
+  runs[run_number].start = start;
+  runs[run_number].end = end;
+  run_number++;
+}
+
+I64 LASwaveforms::find_overlaps()
+{
+  if (run_number < 2)
+  {
+    return 0;
+  }
+
+  // sort the runs by their start and sweep once over them
+
+  qsort(runs, run_number, sizeof(LASwaveformRun), compare_runs);
+
+  U32 i;
+  I64 overlaps = 0;
+  U64 max_end = runs[0].end;
+  for (i = 1; i < run_number; i++)
+  {
+    if (runs[i].start < max_end)
+    {
+      overlaps++;
+    }
+    if (runs[i].end > max_end)
+    {
+      max_end = runs[i].end;
+    }
+  }
+  return overlaps;
+}
+
+LASwaveforms::LASwaveforms()
+{
+  external = FALSE;
+  missing = FALSE;
+  wdp_file_name = 0;
+  data_end = LASWAVEFORMS_HEADER_SIZE;
+  memset(expected_size, 0, sizeof(expected_size));
+  last_start = 1;
+  last_end = 0;
+  number_of_packets = 0;
+  number_outside = 0;
+  first_outside_start = 0;
+  first_outside_size = 0;
+  number_wrong_size = 0;
+  run_number = 0;
+  run_alloc = 0;
+  runs = 0;
+}
+
+LASwaveforms::~LASwaveforms()
+{
+  if (wdp_file_name) free(wdp_file_name);
+  if (runs) free(runs);
+}
@@ -0,0 +1,130 @@
+/*
+===============================================================================
+
+  FILE:  laswaveforms.hpp
+
+  CONTENTS:
+
+    Checks that the waveform packets referenced by the points of formats 4, 5,
+    9 and 10 lie within the waveform data and do not overlap each other.
+
+  PROGRAMMERS:
+
+    martin.isenburg@rapidlasso.com  -  http://rapidlasso.com
+
+  COPYRIGHT:
+
+    (c) 2026, martin isenburg, rapidlasso - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the COPYING.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to check waveform packets against their data
+
+===============================================================================
+*/
+#ifndef LAS_WAVEFORMS_HPP
+#define LAS_WAVEFORMS_HPP
+
+#include "lasheader.hpp"
+#include "laspoint.hpp"
+
+#define LASWAVEFORMS_HEADER_SIZE 60
+
+class LASwaveformRun
+{
+public:
+  U64 start;
+  U64 end;
+};
+
+class LASwaveforms
+{
+public:
+
+  BOOL init(const LASheader* lasheader, const CHAR* file_name);
+
+  inline void add(const LASpoint* laspoint)
+  {
+    U8 index = laspoint->wavepacket.getIndex();
+    if (index == 0) return;
+    U64 start = laspoint->wavepacket.getOffset();
+    U64 end = start + laspoint->wavepacket.getSize();
+
+    // the returns of one pulse share the same packet
+
+    if ((start == last_start) && (end == last_end)) return;
+    last_start = start;
+    last_end = end;
+    number_of_packets++;
+
+    if ((start < LASWAVEFORMS_HEADER_SIZE) || (end > data_end) || (end < start))
+    {
+      if (number_outside == 0)
+      {
+        first_outside_start = start;
+        first_outside_size = (U32)(end - start);
+      }
+      number_outside++;
+      return;
+    }
+
+    if (expected_size[index] && (expected_size[index] != (end - start)))
+    {
+      number_wrong_size++;
+    }
+
+    // extend the current run or start a new one
+
+    if (run_number && (start == runs[run_number-1].end))
+    {
+      runs[run_number-1].end = end;
+    }
+    else
+    {
+      add_run(start, end);
+    }
+  };
+
+  I64 find_overlaps();
+
+  BOOL is_external() const { return external; };
+  BOOL is_missing() const { return missing; };
+  const CHAR* get_file_name() const { return wdp_file_name; };
+  U64 get_data_size() const { return data_end - LASWAVEFORMS_HEADER_SIZE; };
+  I64 get_number_of_packets() const { return number_of_packets; };
+  I64 get_number_outside() const { return number_outside; };
+  U64 get_first_outside_start() const { return first_outside_start; };
+  U32 get_first_outside_size() const { return first_outside_size; };
+  I64 get_number_wrong_size() const { return number_wrong_size; };
+
+  LASwaveforms();
+  ~LASwaveforms();
+
+private:
+  void add_run(const U64 start, const U64 end);
+
+  BOOL external;
+  BOOL missing;
+  CHAR* wdp_file_name;
+  U64 data_end;
+  U32 expected_size[256];
+  U64 last_start;
+  U64 last_end;
+  I64 number_of_packets;
+  I64 number_outside;
+  U64 first_outside_start;
+  U32 first_outside_size;
+  I64 number_wrong_size;
+  U32 run_number;
+  U32 run_alloc;
+  LASwaveformRun* runs;
+};
+
+#endif
@@ -160,6 +160,27 @@ BOOL XMLwriter::write(const CHAR* variable, const CHAR* key, const CHAR* note)
   return TRUE;
 }
 
+BOOL XMLwriter::write(const CHAR* key, const CHAR* attribute, const CHAR* attribute_value, I64 value)
+{
+  if (sub)
+  {
+#ifdef _WIN32
+    fprintf(file, "      <%s %s=\"%s\">%I64d</%s>\012", key, attribute, attribute_value, value, key);
+#else
+    fprintf(file, "      <%s %s=\"%s\">%lld</%s>\012", key, attribute, attribute_value, value, key);
+#endif
+  }
+  else
+  {
+#ifdef _WIN32
+    fprintf(file, "    <%s %s=\"%s\">%I64d</%s>\012", key, attribute, attribute_value, value, key);
+#else
+    fprintf(file, "    <%s %s=\"%s\">%lld</%s>\012", key, attribute, attribute_value, value, key);
+#endif
+  }
+  return TRUE;
+}
+
 BOOL XMLwriter::endsub(const CHAR* key)
 {
   if (!sub)
@@ -48,6 +48,7 @@ public:
   BOOL write(const CHAR* key, int value);
   BOOL write(const CHAR* key, const CHAR* value);
   BOOL write(const CHAR* variable, const CHAR* key, const CHAR* note);
+  BOOL write(const CHAR* key, const CHAR* attribute, const CHAR* attribute_value, I64 value);
   BOOL endsub(const CHAR* key);
   BOOL end(const CHAR* key);
   BOOL close(const CHAR* key);